@@ -104,6 +104,24 @@ cbuffer BufferUber : register(b2)
     float g_padding2;
 };
 
+// High frequency - Updates per instanced draw
+cbuffer BufferDraw : register(b5)
+{
+    uint g_instance_offset; // where the instances of the draw start in the instance index buffer
+    float3 g_padding_draw;
+};
+
+// The transforms of every renderable of a frame, and which renderable each instance is (the instances of a draw are contiguous)
+struct Instance
+{
+    matrix transform;
+    matrix transform_previous;
+};
+StructuredBuffer<Instance> instances        : register(t34);
+StructuredBuffer<uint> instance_indices     : register(t35);
+
+Instance get_instance(uint instance_id) { return instances[instance_indices[g_instance_offset + instance_id]]; }
+
 // High frequency - Updates per light
 cbuffer LightBuffer : register(b3)
 {
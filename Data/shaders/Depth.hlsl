@@ -23,12 +23,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Common.hlsl"
 //====================
 
-Pixel_PosUv mainVS(Vertex_PosUv input)
+// g_transform is the view projection, the world transform comes from the instance
+Pixel_PosUv mainVS(Vertex_PosUv input, uint instance_id : SV_InstanceID)
 {
     Pixel_PosUv output;
 
     input.position.w    = 1.0f; 
-    output.position     = mul(input.position, g_transform);
+    output.position     = mul(input.position, get_instance(instance_id).transform);
+    output.position     = mul(output.position, g_transform);
     output.uv           = input.uv;
 
     return output;
@@ -66,7 +66,7 @@ public:
         g_threading->AddTask([resource_cache, file_path]()
         {
             resource_cache->Load<Spartan::Model>(file_path);
-        });
+        }, Spartan::TaskPriority::Io);
     }
 
     void LoadWorld(const std::string& file_path) const
@@ -80,7 +80,7 @@ public:
         g_threading->AddTask([world, file_path]()
         {
             world->LoadFromFile(file_path);
-        });
+        }, Spartan::TaskPriority::Io);
     }
 
     void SaveWorld(const std::string& file_path) const
@@ -91,7 +91,7 @@ public:
         g_threading->AddTask([world, file_path]()
         {
             world->SaveToFile(file_path);
-        });
+        }, Spartan::TaskPriority::Io);
     }
 
     void PickEntity()
@@ -146,6 +146,28 @@ void Widget_Profiler::TickVisible()
         ImGui::PlotLines("", m_plot.data(), static_cast<int>(m_plot.size()), 0, "", m_timings.m_min, m_timings.m_max, ImVec2(ImGui::GetWindowContentRegionWidth(), 80));
     }
 
+    // Worker threads
+    if (type == TimeBlockType::Cpu)
+    {
+        ImGui::Separator();
+
+        ImGui::Text("Tasks queued:%d, Executing:%d, Completed:%d, Stolen:%d",
+            m_profiler->m_threading_tasks_pending,
+            m_profiler->m_threading_tasks_executing,
+            m_profiler->m_threading_tasks_completed,
+            m_profiler->m_threading_steals
+        );
+
+        const vector<float>& saturation = m_profiler->m_threading_worker_saturation;
+        const uint32_t worker_count     = static_cast<uint32_t>(saturation.size()) - min(m_profiler->m_threading_worker_count_io, static_cast<uint32_t>(saturation.size()));
+        for (uint32_t i = 0; i < static_cast<uint32_t>(saturation.size()); i++)
+        {
+            const string name       = i < worker_count ? "Worker " + to_string(i) : "IO " + to_string(i - worker_count);
+            const string overlay    = name + " - " + to_string(static_cast<uint32_t>(saturation[i] * 100.0f)) + "%";
+            ImGui::ProgressBar(saturation[i], ImVec2(-1, 0), overlay.c_str());
+        }
+    }
+
     // VRAM
     if (type == TimeBlockType::Gpu)
     {
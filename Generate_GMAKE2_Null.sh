@@ -0,0 +1,3 @@
+#!/bin/bash
+
+./Scripts/generate_project_files.sh gmake2 null
\ No newline at end of file
@@ -0,0 +1,1437 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Core/EventSystem.h"
+#include "Core/FileSystem.h"
+#include "Core/FramePacer.h"
+#include "Core/Settings.h"
+#include "Core/Stopwatch.h"
+#include "Core/Timer.h"
+#include "Core/Variant.h"
+#include "Core/Window.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/Material.h"
+#include "Resource/ResourceCache.h"
+#include "Input/Input.h"
+#include "Audio/Audio.h"
+#include "Physics/Physics.h"
+#include "Profiling/Profiler.h"
+#include "Threading/Threading.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/TransformHierarchy.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Light.h"
+#include "World/Components/Collider.h"
+#include "World/Components/RigidBody.h"
+#include "World/Components/Renderable.h"
+#include "Math/BoundingBox.h"
+#include "Math/BoundingBoxArray.h"
+#include "Math/Frustum.h"
+//======================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    // A generator with a fixed seed, so that runs are comparable
+    class Random
+    {
+    public:
+        float operator()(const float min, const float max)
+        {
+            m_seed = m_seed * 1664525u + 1013904223u;
+            return min + (max - min) * static_cast<float>(m_seed >> 8) / 16777216.0f;
+        }
+
+    private:
+        uint32_t m_seed = 1;
+    };
+
+    // FNV-1a, over the bytes of a matrix
+    void hash_matrix(uint64_t& checksum, const Matrix& matrix)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(matrix.Data());
+        for (uint32_t i = 0; i < sizeof(Matrix); i++)
+        {
+            checksum = (checksum ^ bytes[i]) * 1099511628211ull;
+        }
+    }
+
+    // Fills a world with entities, most of them children of an earlier one, and a light every 256 of them
+    vector<shared_ptr<Entity>> generate_world(World* world, const uint32_t count)
+    {
+        Random random;
+        vector<shared_ptr<Entity>> entities;
+        entities.reserve(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            shared_ptr<Entity> entity = world->EntityCreate();
+            Transform* transform      = entity->GetTransform();
+            transform->SetPositionLocal(Vector3(random(-100.0f, 100.0f), random(-10.0f, 10.0f), random(-100.0f, 100.0f)));
+            transform->SetRotationLocal(Quaternion::FromEulerAngles(random(0.0f, 360.0f), random(0.0f, 360.0f), 0.0f));
+            if (i % 4 != 0)
+            {
+                transform->SetParent(entities[min(static_cast<uint32_t>(random(0.0f, static_cast<float>(i))), i - 1)]->GetTransform());
+            }
+
+            if (i % 256 == 0)
+            {
+                Light* light = entity->AddComponent<Light>();
+                light->SetLightType((i / 256) % 2 == 0 ? LightType::Point : LightType::Spot);
+                light->SetRange(random(5.0f, 50.0f));
+                light->SetShadowsEnabled(true);
+            }
+
+            entities.emplace_back(move(entity));
+        }
+
+        return entities;
+    }
+
+    // Gives entities renderables which all share the geometry of a single cube and a single material, like a field of rocks,
+    // so that the renderer's cost per object is measured rather than the cost of creating geometry
+    class Rocks
+    {
+    public:
+        Rocks(Context* context)
+        {
+            m_material = make_shared<Material>(context);
+            m_material->SetResourceFilePath(context->GetSubsystem<ResourceCache>()->GetProjectDirectory() + "runner" + EXTENSION_MATERIAL);
+        }
+
+        void Add(Entity* entity)
+        {
+            Renderable* renderable = entity->AddComponent<Renderable>();
+            if (!m_prototype)
+            {
+                renderable->GeometrySet(Geometry_Default_Cube);
+                m_prototype = renderable;
+            }
+            else
+            {
+                renderable->GeometrySet(
+                    "Rock",
+                    m_prototype->GeometryIndexOffset(),
+                    m_prototype->GeometryIndexCount(),
+                    m_prototype->GeometryVertexOffset(),
+                    m_prototype->GeometryVertexCount(),
+                    m_prototype->GetBoundingBox(),
+                    m_prototype->GeometryModel()
+                );
+            }
+            renderable->SetMaterial(m_material);
+        }
+
+    private:
+        shared_ptr<Material> m_material;
+        Renderable* m_prototype = nullptr;
+    };
+
+    // Measures the frame pacer's jitter at a few common refresh rates
+    int measure_pacing(const uint32_t frames)
+    {
+        for (const double rate : { 60.0, 120.0, 240.0 })
+        {
+            FramePacer pacer;
+            for (uint32_t i = 0; i < frames; i++)
+            {
+                pacer.Wait(1000.0 / rate);
+            }
+
+            const FramePacerStats stats = pacer.GetStats();
+            printf("%3.0f Hz: jitter avg %.3f ms, p99 %.3f ms, max %.3f ms (over %u frames), wake up latency %.3f ms, spin %.3f ms\n",
+                rate, stats.jitter_avg_ms, stats.jitter_p99_ms, stats.jitter_max_ms, stats.frame_count, stats.wake_latency_ms, stats.spin_ms);
+        }
+
+        return 0;
+    }
+
+    // Times the math kernels which run per transform and per draw, over a working set which fits in the cache
+    int measure_math(const uint32_t iterations)
+    {
+        const uint32_t count = 1024;
+        vector<Matrix> matrices(count);
+        vector<Matrix> results(count);
+        vector<Vector3> points(count);
+        vector<BoundingBox> boxes(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const float f   = static_cast<float>(i);
+            matrices[i]     = Matrix(Vector3(f, 1.0f, -f), Quaternion::FromEulerAngles(f, 2.0f * f, 3.0f * f), Vector3(1.0f + f * 0.01f));
+            points[i]       = Vector3(f, -f, 0.5f * f);
+            boxes[i]        = BoundingBox(-points[i].Abs(), points[i].Abs());
+        }
+
+        auto measure = [iterations, count](const char* name, auto&& kernel)
+        {
+            Stopwatch stopwatch;
+            for (uint32_t iteration = 0; iteration < iterations; iteration++)
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    kernel(i);
+                }
+            }
+            printf("%-28s %8.2f ns\n", name, stopwatch.GetElapsedTimeMs() * 1000000.0f / (static_cast<float>(iterations) * count));
+        };
+
+        #if defined(SPARTAN_SIMD_SSE)
+        printf("Math kernels (SSE), per call:\n");
+        #else
+        printf("Math kernels (scalar), per call:\n");
+        #endif
+        measure("Matrix * Matrix",          [&](const uint32_t i) { results[i] = matrices[i] * matrices[(i + 1) % count]; });
+        measure("Matrix::Invert",           [&](const uint32_t i) { results[i] = Matrix::Invert(matrices[i]); });
+        measure("Matrix::InvertAffine",     [&](const uint32_t i) { results[i] = Matrix::InvertAffine(matrices[i]); });
+        measure("Matrix::Transpose",        [&](const uint32_t i) { results[i] = Matrix::Transpose(matrices[i]); });
+        measure("Vector3 * Matrix",         [&](const uint32_t i) { points[i] = points[i] * matrices[i]; });
+        measure("BoundingBox::Transform",   [&](const uint32_t i) { boxes[i] = boxes[(i + 1) % count].Transform(matrices[i]); });
+
+        // Keep the results alive
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            sum += results[i].m00 + points[i].x + boxes[i].GetMin().x;
+        }
+        printf("(checksum %f)\n", sum);
+
+        return 0;
+    }
+
+    // Culls a field of boxes against a camera, one box at a time and in batches
+    int measure_culling(const uint32_t count)
+    {
+        // Boxes scattered around the camera
+        vector<BoundingBox> boxes(count);
+        BoundingBoxArray boxes_soa;
+        Random random;
+        for (BoundingBox& box : boxes)
+        {
+            const Vector3 center(random(-500.0f, 500.0f), random(-50.0f, 50.0f), random(-500.0f, 500.0f));
+            const Vector3 extents(random(0.5f, 5.0f), random(0.5f, 5.0f), random(0.5f, 5.0f));
+            box = BoundingBox(center - extents, center + extents);
+            boxes_soa.Add(box);
+        }
+
+        const Matrix view       = Matrix::CreateLookAtLH(Vector3::Zero, Vector3::Forward, Vector3::Up);
+        const Matrix projection = Matrix::CreatePerspectiveFieldOfViewLH(Helper::DEG_TO_RAD * 90.0f, 16.0f / 9.0f, 0.3f, 1000.0f);
+        const Frustum frustum(view, projection, 1000.0f);
+
+        const uint32_t iterations = 100;
+        uint32_t visible_single = 0;
+        Stopwatch stopwatch;
+        for (uint32_t iteration = 0; iteration < iterations; iteration++)
+        {
+            visible_single = 0;
+            for (const BoundingBox& box : boxes)
+            {
+                visible_single += frustum.IsVisible(box.GetCenter(), box.GetExtents()) ? 1 : 0;
+            }
+        }
+        const float time_single_ms = stopwatch.GetElapsedTimeMs() / iterations;
+
+        vector<uint64_t> visible;
+        stopwatch.Start();
+        for (uint32_t iteration = 0; iteration < iterations; iteration++)
+        {
+            frustum.IsVisible(boxes_soa, visible);
+        }
+        const float time_batched_ms = stopwatch.GetElapsedTimeMs() / iterations;
+
+        uint32_t visible_batched = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            visible_batched += (visible[i >> 6] >> (i & 63)) & 1;
+        }
+
+        printf("Culling %u boxes against a camera frustum:\n", count);
+        printf("One at a time:  %8.3f ms, %u visible\n", time_single_ms, visible_single);
+        #if defined(SPARTAN_SIMD_SSE)
+        printf("Batched (SSE):  %8.3f ms, %u visible\n", time_batched_ms, visible_batched);
+        #else
+        printf("Batched:        %8.3f ms, %u visible\n", time_batched_ms, visible_batched);
+        #endif
+
+        return 0;
+    }
+
+    // Requests renderer flushes from a second thread while the engine renders on its own thread, build with
+    // -fsanitize=thread to check the hand-off, a flush which is never served hangs the run instead of finishing it.
+    // Every simulation step moves the rocks, toggles some of them and their shadows and changes the lights, the render
+    // thread checks that every packet it picks up holds a single step of all that, the run fails otherwise.
+    int test_render_flush(const uint32_t flushes)
+    {
+        #if !defined(API_GRAPHICS_NULL)
+        printf("The flush test needs the null RHI (API_GRAPHICS_NULL)\n");
+        return 1;
+        #else
+        Engine engine(Engine_Headless | Engine_Pipelined);
+        engine.SetHeadlessTickRate(30.0f); // two steps per frame
+        Context* context    = engine.GetContext();
+        World* world        = context->GetSubsystem<World>();
+        Renderer* renderer  = context->GetSubsystem<Renderer>();
+
+        // Rocks at the root, so that they all share a height, and lights
+        const uint32_t rock_count   = 1024;
+        const uint32_t light_count  = 8;
+        Rocks rocks(context);
+        Random random;
+        vector<shared_ptr<Entity>> entities;
+        vector<Light*> lights;
+        for (uint32_t i = 0; i < rock_count + light_count; i++)
+        {
+            shared_ptr<Entity> entity = world->EntityCreate();
+            entity->GetTransform()->SetPositionLocal(Vector3(random(-100.0f, 100.0f), 0.0f, random(-100.0f, 100.0f)));
+            if (i < rock_count)
+            {
+                entity->SetName("Runner_Rock");
+                rocks.Add(entity.get());
+            }
+            else
+            {
+                entity->SetName("Runner_Light");
+                Light* light = entity->AddComponent<Light>();
+                light->SetLightType(i % 2 == 0 ? LightType::Point : LightType::Spot);
+                lights.emplace_back(light);
+            }
+            entities.emplace_back(move(entity));
+        }
+
+        // Step s puts the rocks at a height of s and the lights at an intensity of s and a range of s + 1, every 4th rock
+        // is only active on even steps, and the rocks and the lights only cast shadows on even steps
+        auto mutate = [&entities, &lights, rock_count](const uint64_t step)
+        {
+            const bool even = step % 2 == 0;
+            for (uint32_t i = 0; i < rock_count; i++)
+            {
+                Entity* entity      = entities[i].get();
+                Vector3 position    = entity->GetTransform()->GetPositionLocal();
+                position.y          = static_cast<float>(step);
+                entity->GetTransform()->SetPositionLocal(position);
+                entity->GetRenderable()->SetCastShadows(even);
+                if (i % 4 == 0)
+                {
+                    entity->SetActive(even);
+                }
+            }
+
+            for (Light* light : lights)
+            {
+                light->SetIntensity(static_cast<float>(step));
+                light->SetRange(static_cast<float>(step + 1));
+                light->SetShadowsEnabled(even);
+            }
+        };
+        mutate(0);
+        EventSystem::Get().Subscribe<EventFixedStep>([&mutate](const EventFixedStep& event)
+        {
+            if (event.tick_group == TickType::Simulation)
+            {
+                mutate(event.index + 1);
+            }
+        }, &mutate);
+
+        // Runs on the render thread, with every packet it picks up
+        atomic<uint32_t> packets    = 0;
+        atomic<uint32_t> violations = 0;
+        renderer->SetFramePacketHandler([&packets, &violations, rock_count, light_count](const FramePacket& packet)
+        {
+            packets++;
+            auto check = [&violations](const bool condition, const char* what)
+            {
+                if (!condition && violations.fetch_add(1) < 8)
+                {
+                    printf("Inconsistent packet: %s\n", what);
+                }
+            };
+
+            // The lights tell which step the packet was captured after
+            float step              = -1.0f;
+            uint32_t lights_found   = 0;
+            for (const FramePacketLight& light : packet.lights)
+            {
+                if (light.entity->GetObjectName() != "Runner_Light")
+                    continue;
+
+                step = lights_found++ == 0 ? light.intensity : step;
+                check(light.intensity == step, "the lights are from different steps");
+                check(light.range == step + 1.0f, "a light's range is from another step than its intensity");
+                check(light.shadows == (fmod(step, 2.0f) == 0.0f), "a light's shadows are from another step");
+                check(!light.shadows || light.texture_depth, "a light casts shadows without a shadow map");
+            }
+            check(lights_found == light_count, "lights are missing");
+
+            // The rocks are interpolated between the last step and the one before it
+            const bool even         = fmod(step, 2.0f) == 0.0f;
+            float height            = 0.0f;
+            uint32_t rocks_found    = 0;
+            for (const vector<FramePacketRenderable>* renderables : { &packet.geometry_opaque, &packet.geometry_transparent })
+            {
+                for (const FramePacketRenderable& item : *renderables)
+                {
+                    if (item.entity->GetObjectName() != "Runner_Rock")
+                        continue;
+
+                    const float y = item.transform.GetTranslation().y;
+                    height = rocks_found++ == 0 ? y : height;
+                    check(fabs(y - height) < 0.001f, "the rocks are at different heights");
+                    check(y > step - 1.001f && y < step + 0.001f, "the rocks are from another step than the lights");
+                    check(item.cast_shadows == even, "a rock's shadows are from another step");
+                }
+            }
+            check(rocks_found == (even ? rock_count : rock_count - rock_count / 4), "the active rocks are from another step");
+            check(packet.bounds_opaque.GetCount() == packet.geometry_opaque.size(), "the opaque bounds don't match the renderables");
+            check(packet.bounds_transparent.GetCount() == packet.geometry_transparent.size(), "the transparent bounds don't match the renderables");
+
+            // Every draw points into the packet, and the instances of the draw lists are laid out back to back
+            auto contains = [](const vector<FramePacketRenderable>& renderables, const FramePacketRenderable* item)
+            {
+                return !renderables.empty() && item >= renderables.data() && item < renderables.data() + renderables.size();
+            };
+            uint32_t instance_count = 0;
+            for (const FramePacketInstanceRange& range : packet.instance_ranges)
+            {
+                check(range.offset == instance_count, "the instance ranges are not back to back");
+                for (uint32_t i = 0; i < range.count; i++)
+                {
+                    const FramePacketRenderable* item = range.draws[i].item;
+                    check(contains(packet.geometry_opaque, item) || contains(packet.geometry_transparent, item), "a draw points outside the packet");
+                }
+                instance_count += range.count;
+            }
+            check(instance_count == packet.instance_count, "the instance ranges don't add up");
+
+            auto check_draw_list = [&packet, &check](const FramePacketDrawList& draw_list)
+            {
+                for (const bool transparent : { false, true })
+                {
+                    for (const FramePacketBatch& batch : draw_list.GetBatches(transparent))
+                    {
+                        check(batch.draw_index + batch.instance_count <= draw_list.Get(transparent).size(), "a batch runs past its draws");
+                        check(batch.instance_offset + batch.instance_count <= packet.instance_count, "a batch runs past the instances");
+                    }
+                }
+            };
+            if (packet.has_camera)
+            {
+                check_draw_list(packet.camera.draws);
+            }
+            for (const FramePacketLight& light : packet.lights)
+            {
+                for (uint32_t i = 0; i < light.shadow_array_size; i++)
+                {
+                    check_draw_list(light.draws[i]);
+                }
+            }
+        });
+
+        atomic<bool> done = false;
+        float time_flush_max_ms = 0.0f;
+        thread flusher([&]()
+        {
+            for (uint32_t i = 0; i < flushes; i++)
+            {
+                Stopwatch stopwatch;
+                renderer->Flush();
+                time_flush_max_ms = max(time_flush_max_ms, stopwatch.GetElapsedTimeMs());
+            }
+            done = true;
+        });
+
+        uint32_t frames = 0;
+        Stopwatch stopwatch;
+        while (!done)
+        {
+            engine.Tick();
+            frames++;
+        }
+        flusher.join();
+
+        // The render thread is idle in between ticks
+        renderer->SetFramePacketHandler(nullptr);
+        EventSystem::Get().Unsubscribe<EventFixedStep>(&mutate);
+
+        printf("%u flushes served over %u frames in %.2f ms, slowest flush %.3f ms\n", flushes, frames, stopwatch.GetElapsedTimeMs(), time_flush_max_ms);
+        printf("%u packets checked, %u inconsistencies\n", packets.load(), violations.load());
+        if (packets == 0 || violations != 0)
+        {
+            printf("FAILED: the render thread picked up %s\n", packets == 0 ? "no packets" : "inconsistent packets");
+            return 1;
+        }
+
+        return 0;
+        #endif
+    }
+
+    // Ticks the same generated world with components ticking in parallel and serially, every frame the roots move,
+    // the world matrices and the light matrices have to end up identical, the run fails otherwise
+    int test_world_tick(const uint32_t count, const uint32_t frames)
+    {
+        auto simulate = [count, frames](const bool parallel)
+        {
+            Engine engine(Engine_Headless);
+            World* world = engine.GetContext()->GetSubsystem<World>();
+            world->SetTickParallel(parallel);
+            const vector<shared_ptr<Entity>> entities = generate_world(world, count);
+
+            for (uint32_t frame = 0; frame < frames; frame++)
+            {
+                for (uint32_t i = 0; i < count; i += 4)
+                {
+                    entities[i]->GetTransform()->SetRotationLocal(Quaternion::FromEulerAngles(0.0f, static_cast<float>(frame + i), 0.0f));
+                }
+                engine.Tick();
+            }
+
+            uint64_t checksum = 14695981039346656037ull;
+            for (const shared_ptr<Entity>& entity : world->EntityGetAll())
+            {
+                hash_matrix(checksum, entity->GetTransform()->GetMatrix());
+
+                if (const Light* light = entity->GetComponent<Light>())
+                {
+                    for (uint32_t i = 0; i < light->GetShadowArraySize(); i++)
+                    {
+                        hash_matrix(checksum, light->GetViewMatrix(i));
+                        hash_matrix(checksum, light->GetProjectionMatrix(i));
+                    }
+                }
+            }
+            return checksum;
+        };
+
+        const uint64_t checksum_parallel    = simulate(true);
+        const uint64_t checksum_serial      = simulate(false);
+
+        #if !defined(API_GRAPHICS_NULL)
+        printf("Without a renderer lights don't compute their matrices, only the transforms are compared\n");
+        #endif
+        printf("%u entities, %u frames: parallel %016llx, serial %016llx\n", count, frames,
+            static_cast<unsigned long long>(checksum_parallel), static_cast<unsigned long long>(checksum_serial));
+
+        if (checksum_parallel != checksum_serial)
+        {
+            printf("FAILED: ticking in parallel changed the outcome\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Simulates the same number of fixed steps of a generated world, with physics, at two tick rates,
+    // the world matrices have to end up identical as they only depend on the steps, the run fails otherwise
+    int test_fixed_step(const uint32_t steps)
+    {
+        auto simulate = [steps](const float tick_rate)
+        {
+            Engine engine(Engine_Headless | Engine_Physics | Engine_Game);
+            engine.SetHeadlessTickRate(tick_rate);
+            World* world = engine.GetContext()->GetSubsystem<World>();
+            const vector<shared_ptr<Entity>> entities = generate_world(world, 4096);
+
+            // A floor and boxes which fall on it, and on each other
+            shared_ptr<Entity> floor = world->EntityCreate();
+            floor->GetTransform()->SetPosition(Vector3(0.0f, -20.0f, 0.0f));
+            floor->AddComponent<Collider>()->SetBoundingBox(Vector3(500.0f, 1.0f, 500.0f));
+            floor->AddComponent<RigidBody>()->SetMass(0.0f);
+            for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); i += 16)
+            {
+                entities[i]->AddComponent<Collider>();
+                entities[i]->AddComponent<RigidBody>()->SetMass(1.0f);
+            }
+
+            uint32_t frames = 0;
+            while (engine.GetContext()->GetFixedStepCount(TickType::Simulation) < steps)
+            {
+                engine.Tick();
+                frames++;
+            }
+
+            uint64_t checksum = 14695981039346656037ull;
+            for (const shared_ptr<Entity>& entity : world->EntityGetAll())
+            {
+                hash_matrix(checksum, entity->GetTransform()->GetMatrix());
+            }
+
+            const uint64_t step_count = engine.GetContext()->GetFixedStepCount(TickType::Simulation);
+            printf("%6.2f Hz: %u frames, %llu steps, checksum %016llx\n", tick_rate, frames, static_cast<unsigned long long>(step_count), static_cast<unsigned long long>(checksum));
+            return step_count == steps ? checksum : 0;
+        };
+
+        const uint64_t checksum_a = simulate(30.0f);  // two steps per frame
+        const uint64_t checksum_b = simulate(144.0f); // a step on some frames only
+        if (checksum_a == 0 || checksum_a != checksum_b)
+        {
+            printf("FAILED: the same steps at a different tick rate changed the outcome\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Pushes empty and tiny tasks through the scheduler, submitted from this thread and fanned out from the workers
+    int measure_scheduler(const uint32_t count)
+    {
+        Context context;
+        Threading threading(&context);
+        printf("Scheduler throughput, %u workers, %u tasks per run:\n", threading.GetThreadCount(), count);
+
+        auto measure = [&threading, count](const char* name, auto&& submit)
+        {
+            Stopwatch stopwatch;
+            submit();
+            threading.Flush();
+            const float time_ms = stopwatch.GetElapsedTimeMs();
+            printf("%-36s %8.2f ms, %6.2f M tasks/s\n", name, time_ms, count / (time_ms * 1000.0f));
+        };
+
+        measure("Empty, submitted by this thread", [&]()
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                threading.AddTask([]() {});
+            }
+        });
+
+        atomic<uint64_t> sum = 0;
+        measure("Tiny, submitted by this thread", [&]()
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                threading.AddTask([&sum, i]() { sum.fetch_add(i * i, memory_order_relaxed); });
+            }
+        });
+
+        // Every parent task submits its children to its own worker's queue, the other workers steal them
+        const uint32_t children = 256;
+        measure("Empty, submitted by the workers", [&]()
+        {
+            for (uint32_t i = 0; i < count / children; i++)
+            {
+                threading.AddTask([&threading, children]()
+                {
+                    for (uint32_t j = 0; j < children; j++)
+                    {
+                        threading.AddTask([]() {});
+                    }
+                });
+            }
+        });
+
+        measure("Tiny, submitted by the workers", [&]()
+        {
+            for (uint32_t i = 0; i < count / children; i++)
+            {
+                threading.AddTask([&threading, &sum, children]()
+                {
+                    for (uint32_t j = 0; j < children; j++)
+                    {
+                        threading.AddTask([&sum, j]() { sum.fetch_add(j * j, memory_order_relaxed); });
+                    }
+                });
+            }
+        });
+
+        printf("(checksum %llu)\n", static_cast<unsigned long long>(sum.load()));
+        return 0;
+    }
+
+    // Times ParallelFor() calls, empty ones to expose the per call overhead and one over a large range against a plain loop
+    int measure_parallel_for(const uint32_t calls)
+    {
+        Context context;
+        Threading threading(&context);
+        printf("ParallelFor, %u workers, averaged over %u calls:\n", threading.GetThreadCount(), calls);
+
+        atomic<uint32_t> sink = 0;
+        for (const uint32_t range : { 1u, 64u, 1024u, 65536u })
+        {
+            Stopwatch stopwatch;
+            for (uint32_t i = 0; i < calls; i++)
+            {
+                threading.ParallelFor(range, [&sink](const uint32_t start, const uint32_t end) { sink.fetch_add(end - start, memory_order_relaxed); });
+            }
+            printf("Empty body, range %-8u %10.2f us per call\n", range, stopwatch.GetElapsedTimeMs() * 1000.0f / calls);
+        }
+
+        // A range which is worth splitting
+        const uint32_t count = 1 << 20;
+        vector<float> values(count);
+        auto kernel = [&values](const uint32_t start, const uint32_t end)
+        {
+            for (uint32_t i = start; i < end; i++)
+            {
+                values[i] = sqrtf(static_cast<float>(i)) * 0.5f + values[i] * 0.5f;
+            }
+        };
+
+        const uint32_t iterations = max(calls / 100, 1u);
+        Stopwatch stopwatch;
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            kernel(0, count);
+        }
+        const float time_serial_ms = stopwatch.GetElapsedTimeMs() / iterations;
+
+        stopwatch.Start();
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            threading.ParallelFor(count, kernel);
+        }
+        const float time_parallel_ms = stopwatch.GetElapsedTimeMs() / iterations;
+
+        printf("1M square roots, loop          %10.3f ms\n", time_serial_ms);
+        printf("1M square roots, ParallelFor   %10.3f ms\n", time_parallel_ms);
+        printf("(checksum %u, %f)\n", sink.load(), values[count - 1]);
+
+        return 0;
+    }
+
+    // Floods the workers with long background jobs and the io threads with blocking ones, then checks that frame
+    // critical work is delayed by at most the duration of one background job, the run fails otherwise
+    int test_priorities(const float job_ms)
+    {
+        Context context;
+        Threading threading(&context);
+
+        auto spin = [](const float duration_ms)
+        {
+            Stopwatch stopwatch;
+            while (stopwatch.GetElapsedTimeMs() < duration_ms) {}
+        };
+
+        // Frame critical work: a ParallelFor of 64 chunks of 0.25 ms, and a single task whose start latency is measured
+        auto measure = [&threading, &spin](float& parallel_for_ms, float& latency_ms)
+        {
+            parallel_for_ms = 0.0f;
+            latency_ms      = 0.0f;
+            for (uint32_t i = 0; i < 20; i++)
+            {
+                Stopwatch stopwatch;
+                threading.ParallelFor(64, [&spin](const uint32_t start, const uint32_t end) { spin(0.25f * (end - start)); }, 1);
+                parallel_for_ms = max(parallel_for_ms, stopwatch.GetElapsedTimeMs());
+
+                float started_ms = 0.0f;
+                stopwatch.Start();
+                threading.Wait(threading.AddTask([&started_ms, &stopwatch]() { started_ms = stopwatch.GetElapsedTimeMs(); }, TaskPriority::Critical));
+                latency_ms = max(latency_ms, started_ms);
+            }
+        };
+
+        float idle_parallel_for_ms = 0.0f, idle_latency_ms = 0.0f;
+        measure(idle_parallel_for_ms, idle_latency_ms);
+
+        const uint32_t background_count = (threading.GetThreadCount() + threading.GetThreadCountIo()) * 4;
+        for (uint32_t i = 0; i < background_count; i++)
+        {
+            threading.AddTask([&spin, job_ms]() { spin(job_ms); }, TaskPriority::Background);
+            threading.AddTask([job_ms]() { this_thread::sleep_for(chrono::duration<float, milli>(job_ms)); }, TaskPriority::Io);
+        }
+
+        float loaded_parallel_for_ms = 0.0f, loaded_latency_ms = 0.0f;
+        measure(loaded_parallel_for_ms, loaded_latency_ms);
+        threading.Flush(true);
+
+        printf("%u workers, %u io threads, %u background and %u io jobs of %.1f ms queued\n",
+            threading.GetThreadCount(), threading.GetThreadCountIo(), background_count, background_count, job_ms);
+        printf("Critical ParallelFor, slowest: idle %8.3f ms, under load %8.3f ms\n", idle_parallel_for_ms, loaded_parallel_for_ms);
+        printf("Critical task start, slowest:  idle %8.3f ms, under load %8.3f ms\n", idle_latency_ms, loaded_latency_ms);
+
+        // Only holds when every worker has a core of its own
+        if (loaded_parallel_for_ms - idle_parallel_for_ms > job_ms || loaded_latency_ms > job_ms)
+        {
+            printf("FAILED: background work delayed frame critical work by more than one job\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Builds a forest of 64 transform trees and times the world matrix updates after moving every root,
+    // on the workers and on the calling thread, the run fails if the two disagree
+    int measure_transforms(const uint32_t count, const uint32_t frames)
+    {
+        Context context;
+        Threading threading(&context);
+
+        auto simulate = [&threading, count, frames](const bool parallel)
+        {
+            Threading* update_threading = parallel ? &threading : nullptr;
+            TransformHierarchy hierarchy;
+            vector<uint32_t> handles(count);
+            vector<uint32_t> roots;
+            Random random;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                handles[i] = hierarchy.Add();
+                hierarchy.SetPositionLocal(handles[i], Vector3(random(-100.0f, 100.0f), random(-100.0f, 100.0f), random(-100.0f, 100.0f)));
+
+                if (i % 64 == 0)
+                {
+                    roots.emplace_back(handles[i]);
+                }
+                else
+                {
+                    const uint32_t root = i - i % 64;
+                    hierarchy.SetParent(handles[i], handles[min(static_cast<uint32_t>(random(static_cast<float>(root), static_cast<float>(i))), i - 1)]);
+                }
+            }
+
+            Stopwatch stopwatch;
+            hierarchy.Update(update_threading);
+            const float initial_ms = stopwatch.GetElapsedTimeMs();
+
+            stopwatch.Start();
+            for (uint32_t frame = 0; frame < frames; frame++)
+            {
+                const Quaternion rotation = Quaternion::FromYawPitchRoll(0.01f * (frame + 1), 0.0f, 0.0f);
+                for (const uint32_t root : roots)
+                {
+                    hierarchy.SetRotationLocal(root, rotation);
+                }
+                hierarchy.Update(update_threading);
+            }
+            const float frame_ms = stopwatch.GetElapsedTimeMs() / frames;
+
+            uint64_t checksum = 14695981039346656037ull;
+            for (const uint32_t handle : handles)
+            {
+                hash_matrix(checksum, hierarchy.GetMatrix(handle));
+            }
+
+            printf("%-8s initial update %9.3f ms, moving all roots %9.3f ms per frame, checksum %016llx\n",
+                parallel ? "Parallel" : "Serial", initial_ms, frame_ms, static_cast<unsigned long long>(checksum));
+            return checksum;
+        };
+
+        printf("%u transforms in %u trees, %u workers\n", count, (count + 63) / 64, threading.GetThreadCount());
+        if (simulate(true) != simulate(false))
+        {
+            printf("FAILED: the parallel and the serial update disagree\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Saves a generated world, loads it back and times the load, the lookup of every entity by id and clearing it,
+    // the run fails if an entity or a saved name is missing after the load, or if anything is left indexed after the clear
+    int measure_world_load(const uint32_t count)
+    {
+        Engine engine(Engine_Headless);
+        World* world                  = engine.GetContext()->GetSubsystem<World>();
+        ResourceCache* resource_cache = engine.GetContext()->GetSubsystem<ResourceCache>();
+        generate_world(world, max(count, 2u))[1]->SetName("Runner_Named"); // a child, so it is loaded by its parent
+        const uint32_t saved_count = static_cast<uint32_t>(world->EntityGetAll().size()); // includes the default camera, environment and light
+
+        const string file_path = resource_cache->GetProjectDirectoryAbsolute() + "runner_load" + EXTENSION_WORLD;
+        Stopwatch stopwatch;
+        const bool saved = world->SaveToFile(file_path);
+        const float save_ms = stopwatch.GetElapsedTimeMs();
+
+        world->New();
+        stopwatch.Start();
+        const bool loaded = saved && world->LoadFromFile(file_path);
+        const float load_ms = stopwatch.GetElapsedTimeMs();
+
+        FileSystem::Delete(file_path);
+        FileSystem::Delete(resource_cache->GetProjectDirectoryAbsolute() + "runner_load_resources.dat");
+
+        const uint32_t entity_count = static_cast<uint32_t>(world->EntityGetAll().size());
+        if (!loaded || entity_count != saved_count)
+        {
+            printf("FAILED: saved %u entities, loaded %u\n", saved_count, loaded ? entity_count : 0);
+            return 1;
+        }
+
+        // Look the entities up in a random order, a few times over
+        vector<uint32_t> ids;
+        for (const shared_ptr<Entity>& entity : world->EntityGetAll())
+        {
+            ids.emplace_back(entity->GetObjectId());
+        }
+        Random random;
+        for (uint32_t i = entity_count - 1; i > 0; i--)
+        {
+            swap(ids[i], ids[min(static_cast<uint32_t>(random(0.0f, static_cast<float>(i + 1))), i)]);
+        }
+
+        const uint32_t passes = 10;
+        uint32_t found = 0;
+        stopwatch.Start();
+        for (uint32_t pass = 0; pass < passes; pass++)
+        {
+            for (const uint32_t id : ids)
+            {
+                found += world->EntityGetById(id) ? 1 : 0;
+            }
+        }
+        const float lookup_ms = stopwatch.GetElapsedTimeMs();
+
+        // Names are read back through the entity, so the name index has to follow
+        const shared_ptr<Entity> named = world->EntityGetByName("Runner_Named");
+        const uint32_t named_id        = named ? named->GetObjectId() : 0;
+
+        // Once cleared, the world must not keep any entity alive
+        stopwatch.Start();
+        world->New();
+        const float clear_ms = stopwatch.GetElapsedTimeMs();
+
+        printf("%u entities: save %9.3f ms, load %9.3f ms, lookup by id %7.2f ns, clear %9.3f ms\n", entity_count, save_ms, load_ms, lookup_ms * 1000000.0f / (passes * entity_count), clear_ms);
+        if (found != passes * entity_count)
+        {
+            printf("FAILED: %u of %u lookups found their entity\n", found, passes * entity_count);
+            return 1;
+        }
+
+        if (!named)
+        {
+            printf("FAILED: the saved name wasn't found after the load\n");
+            return 1;
+        }
+
+        if (named.use_count() != 1 || world->EntityGetByName("Entity") || world->EntityGetByName("Runner_Named") || world->EntityGetById(named_id))
+        {
+            printf("FAILED: entities are still indexed after clearing the world\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Spawns renderable entities into a large rendered world a few at a time, and times the frames against the same
+    // frames with a full world resolve forced, which is what every spawn used to cost
+    int measure_spawn(const uint32_t world_count, const uint32_t spawns)
+    {
+        #if !defined(API_GRAPHICS_NULL)
+        printf("The spawn benchmark needs the null RHI (API_GRAPHICS_NULL)\n");
+        return 1;
+        #else
+        const uint32_t frames = 10;
+
+        auto simulate = [world_count, spawns, frames](const bool resolve)
+        {
+            Engine engine(Engine_Headless);
+            World* world = engine.GetContext()->GetSubsystem<World>();
+            Rocks rocks(engine.GetContext());
+            for (const shared_ptr<Entity>& entity : generate_world(world, world_count))
+            {
+                rocks.Add(entity.get());
+            }
+            engine.Tick(); // the initial resolve is not measured
+
+            Random random;
+            float total_ms = 0.0f;
+            for (uint32_t frame = 0; frame < frames; frame++)
+            {
+                Stopwatch stopwatch;
+                for (uint32_t i = frame * spawns / frames; i < (frame + 1) * spawns / frames; i++)
+                {
+                    shared_ptr<Entity> entity = world->EntityCreate();
+                    entity->GetTransform()->SetPositionLocal(Vector3(random(-100.0f, 100.0f), random(-10.0f, 10.0f), random(-100.0f, 100.0f)));
+                    rocks.Add(entity.get());
+                }
+
+                if (resolve)
+                {
+                    world->Resolve();
+                }
+
+                engine.Tick();
+                total_ms += stopwatch.GetElapsedTimeMs();
+            }
+
+            printf("%-19s %u entities, %u spawned over %u frames, %8.3f ms per frame\n",
+                resolve ? "With full resolve:" : "Incremental:", static_cast<uint32_t>(world->EntityGetAll().size()), spawns, frames, total_ms / frames);
+        };
+
+        simulate(false);
+        simulate(true);
+        return 0;
+        #endif
+    }
+
+    // A typed event for the event system benchmark
+    struct EventRunner
+    {
+        uint32_t value;
+    };
+
+    // Posts events from a number of producer threads while this thread flushes, then publishes them concurrently,
+    // the run fails if a subscriber doesn't receive every event exactly once
+    int measure_events(const uint32_t producers, const uint32_t count)
+    {
+        atomic<uint64_t> received = 0;
+        atomic<uint64_t> sum      = 0;
+        EventSystem::Get().Subscribe<EventRunner>([&received, &sum](const EventRunner& event)
+        {
+            received.fetch_add(1, memory_order_relaxed);
+            sum.fetch_add(event.value, memory_order_relaxed);
+        }, &received);
+
+        const uint32_t per_producer = count / producers;
+        const uint64_t expected_sum = static_cast<uint64_t>(producers) * per_producer * (per_producer - 1) / 2;
+        bool passed                 = true;
+
+        auto run = [&](const char* name, const bool post)
+        {
+            received = 0;
+            sum      = 0;
+
+            Stopwatch stopwatch;
+            vector<thread> threads;
+            for (uint32_t producer = 0; producer < producers; producer++)
+            {
+                threads.emplace_back([per_producer, post]()
+                {
+                    for (uint32_t i = 0; i < per_producer; i++)
+                    {
+                        if (post)
+                        {
+                            EventSystem::Get().Post(EventRunner{ i });
+                        }
+                        else
+                        {
+                            EventSystem::Get().Publish(EventRunner{ i });
+                        }
+                    }
+                });
+            }
+
+            // Posted events are delivered by the flushes, as the engine does once per frame
+            if (post)
+            {
+                while (received < static_cast<uint64_t>(producers) * per_producer)
+                {
+                    EventSystem::Get().Flush();
+                }
+            }
+
+            for (thread& thread : threads)
+            {
+                thread.join();
+            }
+            const float elapsed_ms = stopwatch.GetElapsedTimeMs();
+
+            printf("%-8s %u producers, %u events in %9.3f ms, %7.2f M events/s\n", name, producers, producers * per_producer, elapsed_ms, producers * per_producer / (elapsed_ms * 1000.0f));
+            if (received != static_cast<uint64_t>(producers) * per_producer || sum != expected_sum)
+            {
+                printf("FAILED: %llu events received\n", static_cast<unsigned long long>(received.load()));
+                passed = false;
+            }
+        };
+
+        run("Post:", true);
+        run("Publish:", false);
+
+        EventSystem::Get().Unsubscribe<EventRunner>(&received);
+        return passed ? 0 : 1;
+    }
+
+    // The shape of EventWorldResolved, so that the benchmark doesn't wake the engine's own subscribers
+    struct EventRunnerResolved
+    {
+        const vector<shared_ptr<Entity>>& entities;
+    };
+
+    // Times delivering a resolved world to a subscriber which walks every entity, by reference through a typed event and
+    // by value through a Variant (the old path, one copy into the Variant and one out of it), then, with the null RHI,
+    // times whole frames with and without a resolve forced on each of them
+    int measure_resolve(const uint32_t count)
+    {
+        const uint32_t iterations = 100;
+
+        Engine engine(Engine_Headless);
+        World* world = engine.GetContext()->GetSubsystem<World>();
+        generate_world(world, count);
+        const vector<shared_ptr<Entity>>& entities = world->EntityGetAll();
+
+        uint64_t visited = 0;
+        auto walk = [&visited](const vector<shared_ptr<Entity>>& resolved)
+        {
+            for (const shared_ptr<Entity>& entity : resolved)
+            {
+                visited += entity->GetObjectId();
+            }
+        };
+
+        EventSystem::Get().Subscribe<EventRunnerResolved>([&walk](const EventRunnerResolved& event) { walk(event.entities); }, &visited);
+        Stopwatch stopwatch;
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            EventSystem::Get().Publish(EventRunnerResolved{ entities });
+        }
+        const float typed_ms = stopwatch.GetElapsedTimeMs() / iterations;
+        EventSystem::Get().Unsubscribe<EventRunnerResolved>(&visited);
+
+        auto handler_variant = [&walk](const Variant& data)
+        {
+            const vector<shared_ptr<Entity>> resolved = data.Get<vector<shared_ptr<Entity>>>();
+            walk(resolved);
+        };
+        stopwatch.Start();
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            handler_variant(Variant(entities));
+        }
+        const float variant_ms = stopwatch.GetElapsedTimeMs() / iterations;
+
+        printf("%u entities, resolve delivered by reference %8.3f ms, through a Variant %8.3f ms (%llu)\n",
+            static_cast<uint32_t>(entities.size()), typed_ms, variant_ms, static_cast<unsigned long long>(visited));
+
+        #if defined(API_GRAPHICS_NULL)
+        Rocks rocks(engine.GetContext());
+        for (const shared_ptr<Entity>& entity : entities)
+        {
+            rocks.Add(entity.get());
+        }
+        engine.Tick();
+
+        auto measure_frames = [&engine, world, iterations](const bool resolve)
+        {
+            Stopwatch stopwatch;
+            for (uint32_t i = 0; i < iterations; i++)
+            {
+                if (resolve)
+                {
+                    world->Resolve();
+                }
+                engine.Tick();
+            }
+            return stopwatch.GetElapsedTimeMs() / iterations;
+        };
+
+        const float frame_ms            = measure_frames(false);
+        const float frame_resolve_ms    = measure_frames(true);
+        printf("Frame (null RHI): %8.3f ms, with a resolve %8.3f ms\n", frame_ms, frame_resolve_ms);
+        #else
+        printf("Frame times need the null RHI (API_GRAPHICS_NULL)\n");
+        #endif
+
+        return 0;
+    }
+
+    // Times GetSubsystem() against the scan comparing the type of every registered subsystem which it replaced,
+    // for a subsystem registered early (Timer) and for the one registered last (Profiler)
+    int measure_subsystems(const uint32_t iterations)
+    {
+        Engine engine(Engine_Headless);
+        Context* const context = engine.GetContext();
+
+        // The registered subsystems, in registration order, without Scripting as its header needs Mono's
+        vector<ISubsystem*> subsystems;
+        auto add = [&subsystems](ISubsystem* subsystem)
+        {
+            if (subsystem)
+            {
+                subsystems.emplace_back(subsystem);
+            }
+        };
+        add(context->GetSubsystem<Settings>());
+        add(context->GetSubsystem<Timer>());
+        add(context->GetSubsystem<Threading>());
+        add(context->GetSubsystem<Window>());
+        add(context->GetSubsystem<Input>());
+        add(context->GetSubsystem<ResourceCache>());
+        add(context->GetSubsystem<Audio>());
+        add(context->GetSubsystem<Physics>());
+        add(context->GetSubsystem<World>());
+        add(context->GetSubsystem<Renderer>());
+        add(context->GetSubsystem<Profiler>());
+
+        auto scan = [&subsystems](const type_info& type) -> ISubsystem*
+        {
+            for (ISubsystem* subsystem : subsystems)
+            {
+                if (typeid(*subsystem) == type)
+                    return subsystem;
+            }
+            return nullptr;
+        };
+
+        // Read through a volatile so that the lookups can't be hoisted out of the loops
+        Context* volatile context_volatile = context;
+        ISubsystem* volatile result        = nullptr;
+        auto measure = [iterations, &result](const char* name, auto&& get)
+        {
+            Stopwatch stopwatch;
+            for (uint32_t i = 0; i < iterations; i++)
+            {
+                result = get();
+            }
+            printf("%-20s %7.2f ns\n", name, stopwatch.GetElapsedTimeMs() * 1000000.0f / iterations);
+        };
+
+        printf("%u subsystems, %u lookups each\n", static_cast<uint32_t>(subsystems.size()), iterations);
+        measure("Timer, slot:",     [&context_volatile]() { return context_volatile->GetSubsystem<Timer>(); });
+        measure("Timer, scan:",     [&scan]()             { return scan(typeid(Timer)); });
+        measure("Profiler, slot:",  [&context_volatile]() { return context_volatile->GetSubsystem<Profiler>(); });
+        measure("Profiler, scan:",  [&scan]()             { return scan(typeid(Profiler)); });
+
+        if (scan(typeid(Timer)) != context->GetSubsystem<Timer>() || scan(typeid(Profiler)) != context->GetSubsystem<Profiler>())
+        {
+            printf("FAILED: the slot and the scan disagree\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Renders a field of rocks which share a mesh and a material with and without instancing, and prints the draws,
+    // the uber buffer updates and the CPU time of a frame for both
+    int measure_instancing(const uint32_t count)
+    {
+        #if !defined(API_GRAPHICS_NULL)
+        printf("The instancing benchmark needs the null RHI (API_GRAPHICS_NULL)\n");
+        return 1;
+        #else
+        const uint32_t frames = 10;
+
+        auto render = [count, frames](const bool instancing)
+        {
+            Engine engine(Engine_Headless);
+            Context* context    = engine.GetContext();
+            World* world        = context->GetSubsystem<World>();
+            Renderer* renderer  = context->GetSubsystem<Renderer>();
+            Profiler* profiler  = context->GetSubsystem<Profiler>();
+            renderer->SetOption(Render_Debug_NoInstancing, !instancing);
+
+            // In front of the default camera, so that they are drawn by the camera and by the directional light
+            Random random;
+            Rocks rocks(context);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                shared_ptr<Entity> entity = world->EntityCreate();
+                entity->GetTransform()->SetPositionLocal(Vector3(random(-100.0f, 100.0f), random(-10.0f, 10.0f), random(5.0f, 200.0f)));
+                rocks.Add(entity.get());
+            }
+
+            // A frame renders the packet captured by the previous one, so the first two are not measured
+            engine.Tick();
+            engine.Tick();
+
+            // The profiler clears its counters before the renderer ticks, so after a tick they hold that frame's
+            uint64_t draws      = 0;
+            uint64_t updates    = 0;
+            uint64_t meshes     = 0;
+            float total_ms      = 0.0f;
+            for (uint32_t frame = 0; frame < frames; frame++)
+            {
+                Stopwatch stopwatch;
+                engine.Tick();
+                total_ms += stopwatch.GetElapsedTimeMs();
+
+                draws   += profiler->m_rhi_draw;
+                updates += profiler->m_renderer_buffer_uber_updates;
+                meshes  += profiler->m_renderer_meshes_rendered;
+            }
+
+            printf("%-18s %u rocks, %8llu meshes, %7llu draws, %7llu uber updates, %8.3f ms per frame\n",
+                instancing ? "Instanced:" : "Not instanced:", count,
+                static_cast<unsigned long long>(meshes / frames), static_cast<unsigned long long>(draws / frames), static_cast<unsigned long long>(updates / frames), total_ms / frames);
+        };
+
+        render(false);
+        render(true);
+        return 0;
+        #endif
+    }
+}
+
+// Loads a world into a headless engine, simulates a number of frames at a fixed rate and prints how long they took.
+// When built against the null RHI, the frames include the CPU side of the renderer as well.
+// The simulation advances in fixed steps, so runs which simulate the same number of steps end up in
+// the same state, whatever their tick rate, which the printed checksum allows to compare (see --fixed-step).
+// Usage: Runner <file.world> [frames = 600] [tick rate = 60]
+//        Runner --pacing [frames = 600], measures the frame pacer's jitter at 60, 120 and 240 Hz
+//        Runner --math [iterations = 1000], times the math kernels
+//        Runner --culling [boxes = 100000], times frustum culling one box at a time and in batches
+//        Runner --flush [flushes = 1000], requests renderer flushes from another thread while every step changes the world, and checks every packet (null RHI, run under TSan)
+//        Runner --world-tick [entities = 10000] [frames = 120], verifies that ticking in parallel matches ticking serially
+//        Runner --fixed-step [steps = 600, even], verifies that the same steps at 30 and 144 Hz end up in the same state
+//        Runner --scheduler [tasks = 1000000], measures how many empty and tiny tasks the scheduler runs per second
+//        Runner --parallel-for [calls = 10000], measures the per call overhead of ParallelFor
+//        Runner --priorities [job ms = 20], verifies that background and io jobs don't delay frame critical work by more than one job
+//        Runner --transforms [count = 100000] [frames = 100], times the transform hierarchy update on the workers against the calling thread
+//        Runner --world-load [entities = 200000], times saving and loading a generated world, looking its entities up by id and clearing it
+//        Runner --spawn [world = 100000] [spawns = 1000], times spawning into a rendered world against a full resolve per frame (null RHI)
+//        Runner --events [producers = 4] [events = 1000000], measures typed event throughput, posted from many threads and published concurrently
+//        Runner --resolve [entities = 100000], times delivering a world resolve by reference against a Variant, and frames with a resolve (null RHI)
+//        Runner --subsystems [iterations = 10000000], times GetSubsystem() against the type scan it replaced
+//        Runner --instancing [rocks = 50000], renders rocks which share a mesh with and without instancing, and compares draws, uber updates and frame time (null RHI)
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s <file.world> [frames = 600] [tick rate = 60]\n", argv[0]);
+        printf("       %s --pacing [frames = 600]\n", argv[0]);
+        printf("       %s --math [iterations = 1000]\n", argv[0]);
+        printf("       %s --culling [boxes = 100000]\n", argv[0]);
+        printf("       %s --flush [flushes = 1000]\n", argv[0]);
+        printf("       %s --world-tick [entities = 10000] [frames = 120]\n", argv[0]);
+        printf("       %s --fixed-step [steps = 600]\n", argv[0]);
+        printf("       %s --scheduler [tasks = 1000000]\n", argv[0]);
+        printf("       %s --parallel-for [calls = 10000]\n", argv[0]);
+        printf("       %s --priorities [job ms = 20]\n", argv[0]);
+        printf("       %s --transforms [count = 100000] [frames = 100]\n", argv[0]);
+        printf("       %s --world-load [entities = 200000]\n", argv[0]);
+        printf("       %s --spawn [world = 100000] [spawns = 1000]\n", argv[0]);
+        printf("       %s --events [producers = 4] [events = 1000000]\n", argv[0]);
+        printf("       %s --resolve [entities = 100000]\n", argv[0]);
+        printf("       %s --subsystems [iterations = 10000000]\n", argv[0]);
+        printf("       %s --instancing [rocks = 50000]\n", argv[0]);
+        return 1;
+    }
+
+    if (string(argv[1]) == "--pacing")
+        return measure_pacing(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 600);
+
+    if (string(argv[1]) == "--math")
+        return measure_math(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 1000);
+
+    if (string(argv[1]) == "--culling")
+        return measure_culling(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 100000);
+
+    if (string(argv[1]) == "--flush")
+        return test_render_flush(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 1000);
+
+    if (string(argv[1]) == "--world-tick")
+        return test_world_tick(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 10000, argc > 3 ? static_cast<uint32_t>(atoi(argv[3])) : 120);
+
+    if (string(argv[1]) == "--fixed-step")
+        return test_fixed_step(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 600);
+
+    if (string(argv[1]) == "--scheduler")
+        return measure_scheduler(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 1000000);
+
+    if (string(argv[1]) == "--parallel-for")
+        return measure_parallel_for(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 10000);
+
+    if (string(argv[1]) == "--priorities")
+        return test_priorities(argc > 2 ? static_cast<float>(atof(argv[2])) : 20.0f);
+
+    if (string(argv[1]) == "--transforms")
+        return measure_transforms(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 100000, argc > 3 ? static_cast<uint32_t>(atoi(argv[3])) : 100);
+
+    if (string(argv[1]) == "--world-load")
+        return measure_world_load(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 200000);
+
+    if (string(argv[1]) == "--spawn")
+        return measure_spawn(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 100000, argc > 3 ? static_cast<uint32_t>(atoi(argv[3])) : 1000);
+
+    if (string(argv[1]) == "--events")
+        return measure_events(argc > 2 ? static_cast<uint32_t>(max(atoi(argv[2]), 1)) : 4, argc > 3 ? static_cast<uint32_t>(atoi(argv[3])) : 1000000);
+
+    if (string(argv[1]) == "--resolve")
+        return measure_resolve(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 100000);
+
+    if (string(argv[1]) == "--subsystems")
+        return measure_subsystems(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 10000000);
+
+    if (string(argv[1]) == "--instancing")
+        return measure_instancing(argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 50000);
+
+    const string file_path  = argv[1];
+    const uint32_t frames   = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 600;
+    const float tick_rate   = argc > 3 ? static_cast<float>(atof(argv[3])) : 60.0f;
+
+    if (frames == 0 || tick_rate <= 0.0f)
+    {
+        printf("The frame count and the tick rate have to be positive\n");
+        return 1;
+    }
+
+    // Create a headless engine
+    Stopwatch stopwatch;
+    Engine engine(Engine_Headless | Engine_Physics | Engine_Game);
+    engine.SetHeadlessTickRate(tick_rate);
+    const float time_startup_ms = stopwatch.GetElapsedTimeMs();
+
+    // Load the world
+    stopwatch.Start();
+    if (!engine.GetContext()->GetSubsystem<World>()->LoadFromFile(file_path))
+    {
+        printf("Failed to load \"%s\"\n", file_path.c_str());
+        return 1;
+    }
+    const float time_load_ms = stopwatch.GetElapsedTimeMs();
+
+    // Simulate
+    vector<float> frame_times_ms(frames);
+    for (float& frame_time_ms : frame_times_ms)
+    {
+        stopwatch.Start();
+        engine.Tick();
+        frame_time_ms = stopwatch.GetElapsedTimeMs();
+    }
+
+    // Hash the state the simulation ended up in
+    uint64_t checksum = 14695981039346656037ull;
+    for (const shared_ptr<Entity>& entity : engine.GetContext()->GetSubsystem<World>()->EntityGetAll())
+    {
+        hash_matrix(checksum, entity->GetTransform()->GetMatrix());
+    }
+
+    // Report
+    vector<float> sorted = frame_times_ms;
+    sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](const float p) { return sorted[min(static_cast<size_t>(p * sorted.size()), sorted.size() - 1)]; };
+
+    float total_ms = 0.0f;
+    for (const float frame_time_ms : frame_times_ms)
+    {
+        total_ms += frame_time_ms;
+    }
+
+    printf("World:      %s\n", file_path.c_str());
+    #if defined(API_GRAPHICS_NULL)
+    printf("Renderer:   null RHI (CPU only)\n");
+    #else
+    printf("Renderer:   none\n");
+    #endif
+    printf("Startup:    %.2f ms\n", time_startup_ms);
+    printf("Load:       %.2f ms\n", time_load_ms);
+    printf("Frames:     %u at %.2f Hz (%.2f s simulated, %.2f s elapsed)\n", frames, tick_rate, frames / tick_rate, total_ms / 1000.0f);
+    printf("Frame time: avg %.3f ms, min %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+        total_ms / frames, sorted.front(), percentile(0.5f), percentile(0.95f), percentile(0.99f), sorted.back());
+    printf("Simulation: %llu steps of %.2f ms, checksum %016llx\n",
+        static_cast<unsigned long long>(engine.GetContext()->GetFixedStepCount(TickType::Simulation)), engine.GetContext()->GetFixedStep(TickType::Simulation) * 1000.0f, static_cast<unsigned long long>(checksum));
+
+    return 0;
+}
@@ -41,7 +41,7 @@ namespace Spartan
     Audio::~Audio()
     {
         // Unsubscribe from events
-        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldClear, [this](Variant) { m_listener = nullptr; });
+        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldClear);
 
         if (!m_system_fmod)
             return;
@@ -131,6 +131,12 @@ namespace Spartan
         return true;
     }
 
+    SubsystemInitDesc Audio::GetInitDesc() const
+    {
+        // FMOD is independent of the rest of the engine
+        return { true, { SubsystemType::id<Settings> } };
+    }
+
     void Audio::OnTick(float delta_time)
     {
         // Don't play audio if the engine is not in game mode
@@ -45,6 +45,7 @@ namespace Spartan
 
         //= ISubsystem ======================
         bool OnInitialise() override;
+        SubsystemInitDesc GetInitDesc() const override;
         void OnTick(float delta_time) override;
         //===================================
 
@@ -0,0 +1,198 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Spartan.h"
+#include "Context.h"
+#include "Stopwatch.h"
+#include "../Threading/Threading.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    void Context::OnInitialise()
+    {
+        struct SubsystemInit
+        {
+            TaskHandle task;
+            float start_ms  = 0.0f;
+            float end_ms    = 0.0f;
+            bool on_worker  = false;
+            bool success    = false;
+        };
+
+        const uint32_t subsystem_count  = static_cast<uint32_t>(m_subsystems.size());
+        const thread::id thread_main    = this_thread::get_id();
+        Threading* threading            = GetSubsystem<Threading>();
+        vector<SubsystemInit> inits(subsystem_count);
+        Stopwatch stopwatch;
+
+        auto initialise = [this, &inits, &stopwatch, thread_main](const uint32_t index)
+        {
+            SubsystemInit& init = inits[index];
+            init.start_ms       = stopwatch.GetElapsedTimeMs();
+            init.success        = m_subsystems[index].ptr->OnInitialise();
+            init.end_ms         = stopwatch.GetElapsedTimeMs();
+            init.on_worker      = this_thread::get_id() != thread_main;
+        };
+
+        // Initialise subsystems, in registration order, handing the concurrent ones to the workers
+        for (uint32_t i = 0; i < subsystem_count; i++)
+        {
+            const SubsystemInitDesc desc = m_subsystems[i].ptr->GetInitDesc();
+
+            // Gather the dependencies which might still be initialising on a worker
+            vector<TaskHandle> dependencies;
+            if (desc.dependencies.empty() && !desc.concurrent)
+            {
+                for (uint32_t j = 0; j < i; j++)
+                {
+                    if (inits[j].task.IsValid())
+                    {
+                        dependencies.emplace_back(inits[j].task);
+                    }
+                }
+            }
+            else
+            {
+                for (const uint32_t type : desc.dependencies)
+                {
+                    ISubsystem* dependency = type < SubsystemType::max ? m_subsystems_by_type[type] : nullptr;
+                    for (uint32_t j = 0; j < i; j++)
+                    {
+                        if (m_subsystems[j].ptr.get() == dependency && inits[j].task.IsValid())
+                        {
+                            dependencies.emplace_back(inits[j].task);
+                        }
+                    }
+                }
+            }
+
+            if (desc.concurrent && threading)
+            {
+                inits[i].task = threading->AddTask([&initialise, i]() { initialise(i); }, dependencies);
+            }
+            else
+            {
+                for (const TaskHandle& dependency : dependencies)
+                {
+                    threading->Wait(dependency);
+                }
+
+                initialise(i);
+            }
+        }
+
+        // Wait for the workers
+        for (const SubsystemInit& init : inits)
+        {
+            if (init.task.IsValid())
+            {
+                threading->Wait(init.task);
+            }
+        }
+
+        // Timeline
+        LOG_INFO("Subsystems initialised in %.2f ms", stopwatch.GetElapsedTimeMs());
+        for (uint32_t i = 0; i < subsystem_count; i++)
+        {
+            const SubsystemInit& init = inits[i];
+            LOG_INFO("%8.2f ms -> %8.2f ms (%8.2f ms) on %s: %s", init.start_ms, init.end_ms, init.end_ms - init.start_ms, init.on_worker ? "worker" : "main  ", typeid(*m_subsystems[i].ptr).name());
+        }
+
+        // Removes that ones that failed, in reverse so that the remaining indices stay valid
+        for (uint32_t i = subsystem_count; i-- > 0;)
+        {
+            if (inits[i].success)
+                continue;
+
+            LOG_ERROR("Failed to initialize %s", typeid(*m_subsystems[i].ptr).name());
+
+            ISubsystem* subsystem = m_subsystems[i].ptr.get();
+            for (ISubsystem*& slot : m_subsystems_by_type)
+            {
+                if (slot == subsystem)
+                {
+                    slot = nullptr;
+                }
+            }
+
+            m_subsystems.erase(m_subsystems.begin() + i);
+        }
+    }
+
+    void Context::OnTick(const TickType tick_group, const float delta_time)
+    {
+        FixedStep& fixed = m_fixed_steps[static_cast<uint32_t>(tick_group)];
+
+        if (fixed.step <= 0.0)
+        {
+            TickGroup(tick_group, delta_time);
+            return;
+        }
+
+        // Consume the accumulated time in fixed steps
+        fixed.accumulator += delta_time;
+        uint32_t step_count = 0;
+        while (fixed.accumulator >= fixed.step)
+        {
+            if (step_count == fixed.step_max)
+            {
+                // Too far behind, drop the excess so that the next frames don't have to catch up either
+                fixed.accumulator = fmod(fixed.accumulator, fixed.step);
+                break;
+            }
+
+            EventSystem::Get().Publish(EventFixedStep{ tick_group, static_cast<float>(fixed.step), fixed.step_count });
+            TickGroup(tick_group, static_cast<float>(fixed.step));
+
+            fixed.accumulator -= fixed.step;
+            fixed.step_count++;
+            step_count++;
+        }
+
+        fixed.alpha = static_cast<float>(fixed.accumulator / fixed.step);
+    }
+
+    void Context::SetFixedStep(const TickType tick_group, const float step_sec, const uint32_t step_max /*= 5*/)
+    {
+        FixedStep& fixed    = m_fixed_steps[static_cast<uint32_t>(tick_group)];
+        fixed.step          = step_sec > 0.0f ? static_cast<double>(step_sec) : 0.0;
+        fixed.step_max      = step_max > 0 ? step_max : 1;
+        fixed.accumulator   = 0.0;
+        fixed.alpha         = fixed.step > 0.0 ? 0.0f : 1.0f;
+    }
+
+    void Context::TickGroup(const TickType tick_group, const float delta_time)
+    {
+        for (const _subystem& subsystem : m_subsystems)
+        {
+            if (subsystem.tick_group != tick_group)
+                continue;
+
+            subsystem.ptr->OnTick(delta_time);
+        }
+    }
+}
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ===================
+#include <array>
 #include "ISubsystem.h"
 #include "../Logging/Log.h"
 #include "Spartan_Definitions.h"
@@ -34,7 +35,18 @@ namespace Spartan
     enum class TickType
     {
         Variable,
-        Smoothed
+        Simulation, // Ticks in fixed steps, see Context::SetFixedStep()
+        Smoothed,
+        Render,
+        Count
+    };
+
+    // Published before every fixed step of a tick group
+    struct EventFixedStep
+    {
+        TickType tick_group;
+        float delta_time;
+        uint64_t index;
     };
 
     struct _subystem
@@ -56,10 +68,20 @@ namespace Spartan
 
         ~Context()
         {
-            // Loop in reverse registration order to avoid dependency conflicts
-            for (size_t i = m_subsystems.size() - 1; i > 0; i--)
+            // Loop in reverse registration order to avoid dependency conflicts, the ones
+            // which are still alive can be looked up while the others are destroyed
+            for (size_t i = m_subsystems.size(); i-- > 0;)
             {
+                ISubsystem* subsystem = m_subsystems[i].ptr.get();
                 m_subsystems[i].ptr.reset();
+
+                for (ISubsystem*& slot : m_subsystems_by_type)
+                {
+                    if (slot == subsystem)
+                    {
+                        slot = nullptr;
+                    }
+                }
             }
 
             m_subsystems.clear();
@@ -69,48 +91,23 @@ namespace Spartan
         void AddSubsystem(TickType tick_group = TickType::Variable)
         {
             validate_subsystem_type<T>();
+            static_assert(SubsystemType::id<T> < SubsystemType::max, "The subsystem slot is out of range");
 
             m_subsystems.emplace_back(std::make_shared<T>(this), tick_group);
+            m_subsystems_by_type[SubsystemType::id<T>] = m_subsystems.back().ptr.get();
         }
 
-        // Get a subsystem
+        // Get a subsystem, a single load from a slot which is resolved at compile time
         template <class T>
         T* GetSubsystem() const
         {
             validate_subsystem_type<T>();
 
-            for (const auto& subsystem : m_subsystems)
-            {
-                if (subsystem.ptr)
-                {
-                    if (typeid(T) == typeid(*subsystem.ptr))
-                        return static_cast<T*>(subsystem.ptr.get());
-                }
-            }
-
-            return nullptr;
+            return static_cast<T*>(m_subsystems_by_type[SubsystemType::id<T>]);
         }
 
-        void OnInitialise()
-        {
-            std::vector<uint32_t> failed_indices;
-
-            // Initialise subsystems
-            for (uint32_t i = 0; i < static_cast<uint32_t>(m_subsystems.size()); i++)
-            {
-                if (!m_subsystems[i].ptr->OnInitialise())
-                {
-                    failed_indices.emplace_back(i);
-                    LOG_ERROR("Failed to initialize %s", typeid(*m_subsystems[i].ptr).name());
-                }
-            }
-
-            // Removes that ones that failed
-            for (const uint32_t failed_index : failed_indices)
-            {
-                m_subsystems.erase(m_subsystems.begin() + failed_index);
-            }
-        }
+        // Initialises all subsystems, the ones which declare themselves as concurrent do so on the workers
+        void OnInitialise();
 
         void OnPreTick()
         {
@@ -120,16 +117,8 @@ namespace Spartan
             }
         }
 
-        void OnTick(TickType tick_group, float delta_time = 0.0f)
-        {
-            for (const _subystem& subsystem : m_subsystems)
-            {
-                if (subsystem.tick_group != tick_group)
-                    continue;
-
-                subsystem.ptr->OnTick(delta_time);
-            }
-        }
+        // Ticks a group, one with a fixed step ticks as many times as the accumulated time allows (possibly none)
+        void OnTick(TickType tick_group, float delta_time = 0.0f);
 
         void OnPostTick()
         {
@@ -147,9 +136,31 @@ namespace Spartan
             }
         }
 
+        // Makes a group tick in steps of step_sec (0 to tick once per frame, with the frame's delta time), at most step_max times per frame.
+        // When a group falls further behind than that, the excess time is dropped, the simulation slows down instead of spiralling.
+        void SetFixedStep(TickType tick_group, float step_sec, uint32_t step_max = 5);
+        float GetFixedStep(const TickType tick_group)           const { return static_cast<float>(m_fixed_steps[static_cast<uint32_t>(tick_group)].step); }
+        uint64_t GetFixedStepCount(const TickType tick_group)   const { return m_fixed_steps[static_cast<uint32_t>(tick_group)].step_count; }
+
+        // How far the current time is in between the last step and the next one [0, 1), 1 if the group doesn't tick in fixed steps
+        float GetFixedStepAlpha(const TickType tick_group)      const { return m_fixed_steps[static_cast<uint32_t>(tick_group)].alpha; }
+
         Engine* m_engine = nullptr;
 
     private:
+        struct FixedStep
+        {
+            double step         = 0.0;
+            double accumulator  = 0.0;
+            uint32_t step_max   = 5;
+            uint64_t step_count = 0;
+            float alpha         = 1.0f;
+        };
+
+        void TickGroup(TickType tick_group, float delta_time);
+
         std::vector<_subystem> m_subsystems;
+        std::array<FixedStep, static_cast<uint32_t>(TickType::Count)> m_fixed_steps;
+        std::array<ISubsystem*, SubsystemType::max> m_subsystems_by_type = {};
     };
 }
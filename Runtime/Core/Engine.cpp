@@ -40,11 +40,18 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
-    Engine::Engine()
+    Engine::Engine(const uint32_t flags)
     {
         // Flags
-        m_flags |= Engine_Physics;
-        m_flags |= Engine_Game;
+        m_flags = flags;
+        const bool headless = EngineMode_IsSet(Engine_Headless);
+
+        // The null RHI needs no window, so the renderer can run headless (to measure its CPU cost)
+        #if defined(API_GRAPHICS_NULL)
+        const bool api_graphics_null = true;
+        #else
+        const bool api_graphics_null = false;
+        #endif
 
         // Create context
         m_context = make_shared<Context>();
@@ -54,35 +61,192 @@ namespace Spartan
         m_context->AddSubsystem<Settings>();
         m_context->AddSubsystem<Timer>();
         m_context->AddSubsystem<Threading>();
-        m_context->AddSubsystem<Window>();
-        m_context->AddSubsystem<Input>(TickType::Smoothed);
+        if (!headless)
+        {
+            m_context->AddSubsystem<Window>();
+            m_context->AddSubsystem<Input>();
+        }
         m_context->AddSubsystem<ResourceCache>();
         m_context->AddSubsystem<Audio>();
-        m_context->AddSubsystem<Physics>();
-        m_context->AddSubsystem<Scripting>(TickType::Smoothed);
-        m_context->AddSubsystem<World>(TickType::Smoothed);
-        m_context->AddSubsystem<Renderer>();
+        m_context->AddSubsystem<Physics>(TickType::Simulation);
+        m_context->AddSubsystem<Scripting>(TickType::Simulation);
+        m_context->AddSubsystem<World>(TickType::Simulation);
+        if (!headless || api_graphics_null)
+        {
+            m_context->AddSubsystem<Renderer>(TickType::Render);
+        }
         m_context->AddSubsystem<Profiler>();
 
+        // The simulation advances in fixed steps, the renderer interpolates in between them
+        m_context->SetFixedStep(TickType::Simulation, 1.0f / 60.0f);
+
         // Initialize above subsystems
         m_context->OnInitialise();
         m_context->OnPreTick();
+
+        // A flush requested while the render thread idles is served by it, wake it up instead of letting it poll
+        if (Renderer* renderer = m_context->GetSubsystem<Renderer>())
+        {
+            renderer->SetFlushRequestHandler([this]()
+            {
+                { lock_guard<mutex> lock(m_render_mutex); }
+                m_render_condition.notify_all();
+            });
+        }
     }
 
     Engine::~Engine()
     {
+        RenderThreadStop();
+
         m_context->OnShutdown();
 
         // Does this need to become a subsystem ?
         EventSystem::Get().Clear();
     }
 
-    void Engine::Tick() const
+    void Engine::Tick()
     {
-        Timer* timer = m_context->GetSubsystem<Timer>();
+        Timer* timer                    = m_context->GetSubsystem<Timer>();
+        Renderer* renderer              = m_context->GetSubsystem<Renderer>();
+        const bool headless             = EngineMode_IsSet(Engine_Headless);
+        const float delta_time          = headless ? m_headless_delta_time : static_cast<float>(timer->GetDeltaTimeSec());
+        const float delta_time_smoothed = headless ? m_headless_delta_time : static_cast<float>(timer->GetDeltaTimeSmoothedSec());
+
+        // Sync point: events posted since the end of the last frame
+        EventSystem::Get().Flush();
+
+        m_context->OnTick(TickType::Variable, delta_time);
+
+        // Components which follow per frame input (the camera) tick once per frame, the simulation might step any number of times
+        if (World* world = m_context->GetSubsystem<World>())
+        {
+            world->TickVariable(delta_time);
+        }
+
+        // Sync point: events posted by the variable rate subsystems, delivered before the frame is simulated and rendered
+        EventSystem::Get().Flush();
+
+        if (EngineMode_IsSet(Engine_Pipelined) && renderer)
+        {
+            RenderThreadStart();
+
+            // The render thread draws the previously captured frame while this one simulates
+            RenderThreadKick(delta_time);
+            m_context->OnTick(TickType::Simulation, delta_time);
+            m_context->OnTick(TickType::Smoothed, delta_time_smoothed);
+            renderer->CaptureFramePacket();
+            RenderThreadWait();
+        }
+        else
+        {
+            RenderThreadStop();
+
+            m_context->OnTick(TickType::Render, delta_time);
+            m_context->OnTick(TickType::Simulation, delta_time);
+            m_context->OnTick(TickType::Smoothed, delta_time_smoothed);
+            if (renderer)
+            {
+                renderer->CaptureFramePacket();
+            }
+        }
 
-        m_context->OnTick(TickType::Variable, static_cast<float>(timer->GetDeltaTimeSec()));
-        m_context->OnTick(TickType::Smoothed, static_cast<float>(timer->GetDeltaTimeSmoothedSec()));
         m_context->OnPostTick();
     }
+
+    void Engine::RenderThreadStart()
+    {
+        if (m_render_thread.joinable())
+            return;
+
+        m_render_requested  = false;
+        m_render_done       = true;
+        m_render_exit       = false;
+        m_render_thread     = thread(&Engine::RenderThreadLoop, this);
+    }
+
+    void Engine::RenderThreadStop()
+    {
+        if (!m_render_thread.joinable())
+            return;
+
+        {
+            lock_guard<mutex> lock(m_render_mutex);
+            m_render_exit = true;
+        }
+        m_render_condition.notify_all();
+        m_render_thread.join();
+
+        // The renderer is back on the engine thread
+        if (Renderer* renderer = m_context->GetSubsystem<Renderer>())
+        {
+            renderer->SetRenderThread(this_thread::get_id());
+        }
+        m_render_owns_renderer = false;
+    }
+
+    void Engine::RenderThreadKick(const float delta_time)
+    {
+        {
+            lock_guard<mutex> lock(m_render_mutex);
+            m_context->GetSubsystem<Renderer>()->SetRenderThread(m_render_thread.get_id());
+            m_render_owns_renderer  = true;
+            m_render_delta_time     = delta_time;
+            m_render_requested      = true;
+            m_render_done           = false;
+        }
+        m_render_condition.notify_all();
+    }
+
+    void Engine::RenderThreadWait()
+    {
+        unique_lock<mutex> lock(m_render_mutex);
+        m_render_condition.wait(lock, [this]() { return m_render_done; });
+
+        // Until the next frame, the renderer belongs to the engine thread (the editor draws and resizes it in between)
+        m_context->GetSubsystem<Renderer>()->SetRenderThread(this_thread::get_id());
+        m_render_owns_renderer = false;
+    }
+
+    void Engine::RenderThreadLoop()
+    {
+        Renderer* renderer = m_context->GetSubsystem<Renderer>();
+
+        while (true)
+        {
+            float delta_time = 0.0f;
+            {
+                unique_lock<mutex> lock(m_render_mutex);
+                while (true)
+                {
+                    m_render_condition.wait(lock, [this, renderer]()
+                    {
+                        return m_render_requested || m_render_exit || (m_render_owns_renderer && renderer->IsFlushRequested());
+                    });
+
+                    if (m_render_requested || m_render_exit)
+                        break;
+
+                    // While the simulation runs, it can request a flush (e.g. clearing the world), serve it so it doesn't wait forever
+                    lock.unlock();
+                    renderer->Flush();
+                    lock.lock();
+                }
+
+                if (m_render_exit)
+                    return;
+
+                m_render_requested  = false;
+                delta_time          = m_render_delta_time;
+            }
+
+            m_context->OnTick(TickType::Render, delta_time);
+
+            {
+                lock_guard<mutex> lock(m_render_mutex);
+                m_render_done = true;
+            }
+            m_render_condition.notify_all();
+        }
+    }
 }
@@ -23,6 +23,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ===================
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "Spartan_Definitions.h"
 //==============================
 
@@ -33,18 +36,24 @@ namespace Spartan
 
     enum Engine_Mode : uint32_t
     {
-        Engine_Physics  = 1 << 0, // Should the physics tick ?
-        Engine_Game     = 1 << 1, // Is the engine running in game or editor mode ?
+        Engine_Physics      = 1 << 0, // Should the physics tick ?
+        Engine_Game         = 1 << 1, // Is the engine running in game or editor mode ?
+        Engine_Pipelined    = 1 << 2, // Should the renderer run on it's own thread, one frame behind the simulation ?
+        Engine_Headless     = 1 << 3, // Run without a window, input and renderer (unless the RHI is null), ticking at a fixed rate (set at construction)
     };
 
     class SPARTAN_CLASS Engine
     {
     public:
-        Engine();
+        Engine(uint32_t flags = Engine_Physics | Engine_Game);
         ~Engine();
 
         // Performs a simulation cycle
-        void Tick() const;
+        void Tick();
+
+        // The rate at which a headless engine ticks, each tick advances the simulation by 1 / rate seconds
+        void SetHeadlessTickRate(const float rate)  { m_headless_delta_time = 1.0f / rate; }
+        float GetHeadlessTickRate() const           { return 1.0f / m_headless_delta_time; }
 
         //  Flags
         auto EngineMode_GetAll()                        const { return m_flags; }
@@ -57,7 +66,24 @@ namespace Spartan
         auto GetContext() const { return m_context.get(); }
 
     private:
-        uint32_t m_flags = 0;
+        // Render thread (pipelined mode)
+        void RenderThreadStart();
+        void RenderThreadStop();
+        void RenderThreadLoop();
+        void RenderThreadKick(float delta_time);
+        void RenderThreadWait();
+
+        uint32_t m_flags                = 0;
+        float m_headless_delta_time     = 1.0f / 60.0f;
         std::shared_ptr<Context> m_context;
+
+        std::thread m_render_thread;
+        std::mutex m_render_mutex;
+        std::condition_variable m_render_condition;
+        float m_render_delta_time   = 0.0f;
+        bool m_render_requested     = false;
+        bool m_render_done          = true;
+        bool m_render_exit          = false;
+        bool m_render_owns_renderer = false; // the renderer belongs to the render thread, otherwise to the engine thread
     };
 }
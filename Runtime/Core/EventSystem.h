@@ -22,21 +22,36 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ===============
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <typeindex>
 #include <unordered_map>
 #include <vector>
-#include <functional>
 #include "../Core/Variant.h"
 //==========================
 
 /*
 HOW TO USE
 ====================================================================================
+Legacy events (EventType + Variant), delivered immediately on the firing thread
 To subscribe a function to an event     -> SP_SUBSCRIBE_TO_EVENT(EVENT_ID, Handler);
-To unsubscribe a function from an event -> SP_SUBSCRIBE_TO_EVENT(EVENT_ID, Handler);
+To unsubscribe from an event            -> SP_UNSUBSCRIBE_FROM_EVENT(EVENT_ID);
 To fire an event                        -> SP_FIRE_EVENT(EVENT_ID);
 To fire an event with data              -> SP_FIRE_EVENT_DATA(EVENT_ID, Variant);
 
-Note: Currently, this is a blocking event system
+Typed events, any struct can be an event and is passed to the subscribers as is
+To subscribe a function to an event     -> EventSystem::Get().Subscribe<EventT>(function, this);
+To unsubscribe from an event            -> EventSystem::Get().Unsubscribe<EventT>(this);
+To deliver an event immediately         -> EventSystem::Get().Publish(EventT{ ... });
+To queue an event for the next flush    -> EventSystem::Get().Post(EventT{ ... });
+
+Subscribing, unsubscribing, firing and posting are safe from any thread.
+Posted events are delivered by Flush(), which the engine calls at the start of every
+frame and after the variable tick (before the simulation ticks), in the order they were
+posted (per event type).
+Handlers are invoked without any lock held, so they can subscribe, unsubscribe and fire.
 ====================================================================================
 */
 
@@ -50,8 +65,9 @@ Note: Currently, this is a blocking event system
 #define SP_FIRE_EVENT(eventID)                         Spartan::EventSystem::Get().Fire(eventID)
 #define SP_FIRE_EVENT_DATA(eventID, data)              Spartan::EventSystem::Get().Fire(eventID, data)
 
-#define SP_SUBSCRIBE_TO_EVENT(eventID, function)       Spartan::EventSystem::Get().Subscribe(eventID, function);
-#define SP_UNSUBSCRIBE_FROM_EVENT(eventID, function)   Spartan::EventSystem::Get().Unsubscribe(eventID, function);
+// Subscriptions are owned by the calling object, unsubscribing removes all of its handlers for that event
+#define SP_SUBSCRIBE_TO_EVENT(eventID, function)       Spartan::EventSystem::Get().Subscribe(eventID, function, this);
+#define SP_UNSUBSCRIBE_FROM_EVENT(eventID)             Spartan::EventSystem::Get().Unsubscribe(eventID, this);
 //================================================================================================================
 
 enum class EventType
@@ -63,14 +79,14 @@ enum class EventType
     WorldLoadEnd,   // The world finished loading from file
     WorldPreClear,  // The world is about to clear everything
     WorldClear,     // The world is clear everything
-    WorldResolve,   // The world is resolving
-    WorldResolved,  // The world has finished resolving
+    WorldResolve,   // The world is resolving (the data is the entity that changed, if only one did)
     EventSDL,       // An SDL event
 };
 
 namespace Spartan
 {
-    using subscriber = std::function<void(const Variant&)>;
+    using subscriber        = std::function<void(const Variant&)>;
+    using subscription_id   = uint64_t;
 
     class SPARTAN_CLASS EventSystem
     {
@@ -81,44 +97,288 @@ namespace Spartan
             return instance;
         }
 
-        void Subscribe(const EventType event_id, subscriber&& function)
+        //= LEGACY EVENTS =========================================================================================
+        subscription_id Subscribe(const EventType event_id, subscriber&& function, const void* owner = nullptr)
         {
-            m_subscribers[event_id].push_back(std::forward<subscriber>(function));
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const subscription_id id = ++m_subscription_id;
+            m_subscribers[event_id].Add({ id, owner, std::move(function) });
+            return id;
         }
 
-        void Unsubscribe(const EventType event_id, subscriber&& function)
+        // Removes all the handlers the owner subscribed to the event
+        void Unsubscribe(const EventType event_id, const void* owner)
         {
-            const size_t function_adress    = *reinterpret_cast<long*>(reinterpret_cast<char*>(&function));
-            auto& subscribers               = m_subscribers[event_id];
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_subscribers.find(event_id);
+            if (it != m_subscribers.end())
+            {
+                it->second.Remove([owner](const auto& subscription) { return subscription.owner == owner; });
+            }
+        }
 
-            for (auto it = subscribers.begin(); it != subscribers.end();)
+        void Unsubscribe(const subscription_id id)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& it : m_subscribers)
             {
-                const size_t subscriber_adress = *reinterpret_cast<long*>(reinterpret_cast<char*>(&(*it)));
-                if (subscriber_adress == function_adress)
-                {
-                    it = subscribers.erase(it);
-                    return;
-                }
+                it.second.Remove([id](const auto& subscription) { return subscription.id == id; });
             }
         }
 
         void Fire(const EventType event_id, const Variant& data = 0)
         {
-            if (m_subscribers.find(event_id) == m_subscribers.end())
-                return;
+            std::shared_ptr<const std::vector<Subscription<subscriber>>> subscriptions;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_subscribers.find(event_id);
+                if (it == m_subscribers.end())
+                    return;
+
+                subscriptions = it->second.Get();
+            }
+
+            for (const auto& subscription : *subscriptions)
+            {
+                subscription.function(data);
+            }
+        }
+        //=========================================================================================================
+
+        //= TYPED EVENTS ==========================================================================================
+        template <typename EventT>
+        subscription_id Subscribe(std::function<void(const EventT&)>&& function, const void* owner = nullptr)
+        {
+            const subscription_id id = ++m_subscription_id;
+            GetChannel<EventT>().Subscribe({ id, owner, std::move(function) });
+            return id;
+        }
+
+        template <typename EventT>
+        void Unsubscribe(const void* owner)
+        {
+            GetChannel<EventT>().Unsubscribe([owner](const auto& subscription) { return subscription.owner == owner; });
+        }
+
+        template <typename EventT>
+        void Unsubscribe(const subscription_id id)
+        {
+            GetChannel<EventT>().Unsubscribe([id](const auto& subscription) { return subscription.id == id; });
+        }
+
+        // Delivers the event to all the subscribers, on the calling thread, before returning
+        template <typename EventT>
+        void Publish(const EventT& event)
+        {
+            GetChannel<EventT>().Publish(event);
+        }
+
+        // Queues the event, it will be delivered by the next Flush()
+        template <typename EventT>
+        void Post(EventT event)
+        {
+            GetChannel<EventT>().Post(std::move(event));
+        }
+        //=========================================================================================================
+
+        // Delivers all the posted events, events posted by the handlers are delivered by the next flush
+        void Flush()
+        {
+            std::lock_guard<std::mutex> lock_flush(m_mutex_flush);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_channels_flush = m_channels;
+            }
 
-            for (const auto& subscriber : m_subscribers[event_id])
+            for (ChannelBase* channel : m_channels_flush)
             {
-                subscriber(data);
+                channel->Flush();
             }
         }
 
-        void Clear() 
+        void Clear()
         {
-            m_subscribers.clear(); 
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_subscribers.clear();
+
+            // Channels are cached by GetChannel() so they are emptied instead of destroyed
+            for (ChannelBase* channel : m_channels)
+            {
+                channel->Clear();
+            }
         }
 
     private:
-        std::unordered_map<EventType, std::vector<subscriber>> m_subscribers;
+        template <typename Function>
+        struct Subscription
+        {
+            subscription_id id;
+            const void* owner;
+            Function function;
+        };
+
+        // A copy on write list of subscriptions, firing takes a snapshot and never blocks (un)subscribing
+        template <typename Function>
+        class SubscriptionList
+        {
+        public:
+            using list = std::vector<Subscription<Function>>;
+
+            std::shared_ptr<const list> Get() const { return m_list; }
+
+            void Add(Subscription<Function>&& subscription)
+            {
+                auto list_new = m_list ? std::make_shared<list>(*m_list) : std::make_shared<list>();
+                list_new->emplace_back(std::move(subscription));
+                m_list = std::move(list_new);
+            }
+
+            template <typename Predicate>
+            void Remove(Predicate predicate)
+            {
+                if (!m_list)
+                    return;
+
+                auto list_new = std::make_shared<list>();
+                for (const auto& subscription : *m_list)
+                {
+                    if (!predicate(subscription))
+                    {
+                        list_new->emplace_back(subscription);
+                    }
+                }
+                m_list = std::move(list_new);
+            }
+
+            void Clear() { m_list = nullptr; }
+
+        private:
+            std::shared_ptr<const list> m_list;
+        };
+
+        class ChannelBase
+        {
+        public:
+            virtual ~ChannelBase() = default;
+            virtual void Flush() = 0;
+            virtual void Clear() = 0;
+        };
+
+        template <typename EventT>
+        class Channel : public ChannelBase
+        {
+        public:
+            using function = std::function<void(const EventT&)>;
+
+            void Subscribe(Subscription<function>&& subscription)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex_subscribers);
+                m_subscribers.Add(std::move(subscription));
+            }
+
+            template <typename Predicate>
+            void Unsubscribe(Predicate predicate)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex_subscribers);
+                m_subscribers.Remove(predicate);
+            }
+
+            void Publish(const EventT& event)
+            {
+                std::shared_ptr<const typename SubscriptionList<function>::list> subscriptions;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex_subscribers);
+                    subscriptions = m_subscribers.Get();
+                }
+
+                if (!subscriptions)
+                    return;
+
+                for (const auto& subscription : *subscriptions)
+                {
+                    subscription.function(event);
+                }
+            }
+
+            void Post(EventT&& event)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex_queue);
+                m_queue.emplace_back(std::move(event));
+                m_queue_pending = true;
+            }
+
+            void Flush() override
+            {
+                if (!m_queue_pending)
+                    return;
+
+                // Swap with the flush buffer so both keep their capacity across frames
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex_queue);
+                    m_queue.swap(m_queue_flush);
+                    m_queue_pending = false;
+                }
+
+                for (const EventT& event : m_queue_flush)
+                {
+                    Publish(event);
+                }
+                m_queue_flush.clear();
+            }
+
+            void Clear() override
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex_subscribers);
+                    m_subscribers.Clear();
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex_queue);
+                m_queue.clear();
+                m_queue_pending = false;
+            }
+
+        private:
+            SubscriptionList<function> m_subscribers;
+            std::mutex m_mutex_subscribers;
+            std::vector<EventT> m_queue;
+            std::vector<EventT> m_queue_flush;
+            std::atomic<bool> m_queue_pending = false;
+            std::mutex m_mutex_queue;
+        };
+
+        template <typename EventT>
+        Channel<EventT>& GetChannel()
+        {
+            // The lookup is keyed by type_index so that every module resolves to the same channel,
+            // the per module static only caches it, channels live for as long as the event system.
+            static Channel<EventT>& channel = [this]() -> Channel<EventT>&
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::unique_ptr<ChannelBase>& channel = m_channels_by_type[std::type_index(typeid(EventT))];
+                if (!channel)
+                {
+                    channel = std::make_unique<Channel<EventT>>();
+                    m_channels.emplace_back(channel.get());
+                }
+                return *static_cast<Channel<EventT>*>(channel.get());
+            }();
+
+            return channel;
+        }
+
+        // Legacy events
+        std::unordered_map<EventType, SubscriptionList<subscriber>> m_subscribers;
+
+        // Typed events
+        std::unordered_map<std::type_index, std::unique_ptr<ChannelBase>> m_channels_by_type;
+        std::vector<ChannelBase*> m_channels;
+        std::vector<ChannelBase*> m_channels_flush;
+        std::mutex m_mutex_flush;
+
+        std::atomic<subscription_id> m_subscription_id = 0;
+        std::mutex m_mutex;
     };
 }
@@ -0,0 +1,168 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========
+#include "Spartan.h"
+#include "FramePacer.h"
+#include <thread>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <time.h>
+#endif
+//=====================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    namespace
+    {
+        // The spin tail is never shorter or longer than this
+        constexpr double spin_min_ms = 0.05;
+        constexpr double spin_max_ms = 4.0;
+
+        // How fast the wake up latency estimate follows new measurements
+        constexpr double latency_feedback = 0.1;
+    }
+
+    FramePacer::FramePacer()
+    {
+        #if defined(_WIN32)
+        // High resolution timers exist since Windows 10 (1803), fall back to a regular one
+        m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (!m_timer)
+        {
+            m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        }
+        #endif
+
+        m_jitter_ms.fill(0.0f);
+    }
+
+    FramePacer::~FramePacer()
+    {
+        #if defined(_WIN32)
+        if (m_timer)
+        {
+            CloseHandle(m_timer);
+        }
+        #endif
+    }
+
+    void FramePacer::Wait(const double period_ms)
+    {
+        const clock::duration period = chrono::duration_cast<clock::duration>(chrono::duration<double, milli>(period_ms));
+        clock::time_point now        = clock::now();
+
+        // Schedule the next frame, if it's behind by more than a frame, start over from now instead of catching up
+        if (!m_deadline_valid || now - m_deadline > period)
+        {
+            m_deadline          = now;
+            m_deadline_valid    = true;
+        }
+        m_deadline += period;
+
+        // Sleep for most of the wait
+        const double spin_ms            = Helper::Clamp(m_wake_latency_ms + 2.0 * m_wake_latency_dev_ms, spin_min_ms, spin_max_ms);
+        const clock::time_point wake    = m_deadline - chrono::duration_cast<clock::duration>(chrono::duration<double, milli>(spin_ms));
+        if (wake > now)
+        {
+            Sleep(wake);
+            now = clock::now();
+
+            // Calibrate the spin tail from how late the thread woke up
+            const double latency_ms = chrono::duration<double, milli>(now - wake).count();
+            m_wake_latency_dev_ms   += (Helper::Abs(latency_ms - m_wake_latency_ms) - m_wake_latency_dev_ms) * latency_feedback;
+            m_wake_latency_ms       += (latency_ms - m_wake_latency_ms) * latency_feedback;
+        }
+
+        // Spin for the rest
+        while (now < m_deadline)
+        {
+            now = clock::now();
+        }
+
+        // Jitter, how far from its deadline the frame starts
+        m_jitter_ms[m_jitter_index] = static_cast<float>(chrono::duration<double, milli>(now - m_deadline).count());
+        m_jitter_index              = (m_jitter_index + 1) % sample_count;
+        m_jitter_count              = Helper::Min(m_jitter_count + 1, sample_count);
+    }
+
+    FramePacerStats FramePacer::GetStats() const
+    {
+        FramePacerStats stats;
+        stats.frame_count       = m_jitter_count;
+        stats.wake_latency_ms   = m_wake_latency_ms;
+        stats.spin_ms           = Helper::Clamp(m_wake_latency_ms + 2.0 * m_wake_latency_dev_ms, spin_min_ms, spin_max_ms);
+
+        if (m_jitter_count == 0)
+            return stats;
+
+        array<float, sample_count> sorted = m_jitter_ms;
+        sort(sorted.begin(), sorted.begin() + m_jitter_count);
+
+        for (uint32_t i = 0; i < m_jitter_count; i++)
+        {
+            stats.jitter_avg_ms += sorted[i];
+        }
+        stats.jitter_avg_ms /= m_jitter_count;
+        stats.jitter_p99_ms = sorted[Helper::Min((m_jitter_count * 99) / 100, m_jitter_count - 1)];
+        stats.jitter_max_ms = sorted[m_jitter_count - 1];
+
+        return stats;
+    }
+
+    void FramePacer::ResetStats()
+    {
+        m_jitter_index = 0;
+        m_jitter_count = 0;
+    }
+
+    void FramePacer::Sleep(const clock::time_point until)
+    {
+        #if defined(_WIN32)
+        if (m_timer)
+        {
+            // Relative, in 100 ns units
+            LARGE_INTEGER due_time;
+            due_time.QuadPart = -static_cast<LONGLONG>(chrono::duration_cast<chrono::nanoseconds>(until - clock::now()).count() / 100);
+            if (due_time.QuadPart < 0 && SetWaitableTimerEx(m_timer, &due_time, 0, nullptr, nullptr, nullptr, 0))
+            {
+                WaitForSingleObject(m_timer, INFINITE);
+            }
+            return;
+        }
+        this_thread::sleep_until(until);
+        #else
+        // Absolute, on the same clock as steady_clock, so that being interrupted doesn't shift the wake up time
+        const chrono::nanoseconds since_epoch = chrono::duration_cast<chrono::nanoseconds>(until.time_since_epoch());
+        timespec time;
+        time.tv_sec     = static_cast<time_t>(since_epoch.count() / 1000000000);
+        time.tv_nsec    = static_cast<long>(since_epoch.count() % 1000000000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr) == EINTR) {}
+        #endif
+    }
+}
@@ -0,0 +1,81 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===================
+#include <array>
+#include <chrono>
+#include "Spartan_Definitions.h"
+//==============================
+
+namespace Spartan
+{
+    struct FramePacerStats
+    {
+        uint32_t frame_count    = 0;    // Frames the statistics were gathered over
+        double jitter_avg_ms    = 0.0;  // How far frames start from their intended time (absolute)
+        double jitter_p99_ms    = 0.0;
+        double jitter_max_ms    = 0.0;
+        double wake_latency_ms  = 0.0;  // How late the OS wakes up the thread (average)
+        double spin_ms          = 0.0;  // How early before the deadline sleeping stops and spinning begins
+    };
+
+    // Paces frames to a target duration. It sleeps on a high resolution timer for most of the wait
+    // and spins for the tail, the length of which is calibrated from how late the OS wakes the thread up.
+    // Frames are scheduled on a fixed cadence (deadline + period), so a late frame doesn't shift the ones after it.
+    class SPARTAN_CLASS FramePacer
+    {
+    public:
+        FramePacer();
+        ~FramePacer();
+
+        // Blocks until the next frame is due, period_ms after the previous one
+        void Wait(double period_ms);
+
+        // Frame time jitter over the last frames
+        FramePacerStats GetStats() const;
+        void ResetStats();
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        void Sleep(clock::time_point until);
+
+        static constexpr uint32_t sample_count = 512;
+
+        // Schedule
+        clock::time_point m_deadline;
+        bool m_deadline_valid = false;
+
+        // Wake up latency, exponential moving averages of its mean and deviation
+        double m_wake_latency_ms        = 1.0;
+        double m_wake_latency_dev_ms    = 0.5;
+
+        // Jitter samples, a ring buffer
+        std::array<float, sample_count> m_jitter_ms;
+        uint32_t m_jitter_index = 0;
+        uint32_t m_jitter_count = 0;
+
+        // The OS timer (if any)
+        void* m_timer = nullptr;
+    };
+}
@@ -24,12 +24,62 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===================
 #include <type_traits>
 #include <memory>
+#include <vector>
 #include "Spartan_Definitions.h"
 //==============================
 
 namespace Spartan
 {
     class Context;
+    class Settings;
+    class Timer;
+    class Threading;
+    class Window;
+    class Input;
+    class ResourceCache;
+    class Audio;
+    class Physics;
+    class Scripting;
+    class World;
+    class Renderer;
+    class Profiler;
+
+    // Every subsystem type has a fixed slot, known at compile time, in registration order
+    class SubsystemType
+    {
+        template <class T>
+        static constexpr uint32_t slot()
+        {
+            if constexpr (std::is_same_v<T, Settings>)           return 0;
+            else if constexpr (std::is_same_v<T, Timer>)         return 1;
+            else if constexpr (std::is_same_v<T, Threading>)     return 2;
+            else if constexpr (std::is_same_v<T, Window>)        return 3;
+            else if constexpr (std::is_same_v<T, Input>)         return 4;
+            else if constexpr (std::is_same_v<T, ResourceCache>) return 5;
+            else if constexpr (std::is_same_v<T, Audio>)         return 6;
+            else if constexpr (std::is_same_v<T, Physics>)       return 7;
+            else if constexpr (std::is_same_v<T, Scripting>)     return 8;
+            else if constexpr (std::is_same_v<T, World>)         return 9;
+            else if constexpr (std::is_same_v<T, Renderer>)      return 10;
+            else if constexpr (std::is_same_v<T, Profiler>)      return 11;
+            else static_assert(!std::is_same_v<T, T>, "The type has no subsystem slot, add one");
+        }
+
+    public:
+        static constexpr uint32_t max = 12;
+
+        template <class T>
+        static constexpr uint32_t id = slot<T>();
+    };
+
+    // How a subsystem initialises. By default it does so on the thread which initialises the context,
+    // in registration order, after every subsystem registered before it. Declaring dependencies narrows
+    // that down to them, which lets the concurrent subsystems registered before it keep initialising.
+    struct SubsystemInitDesc
+    {
+        bool concurrent = false;            // Initialises on a worker, as soon as its dependencies have initialised
+        std::vector<uint32_t> dependencies; // Subsystems (SubsystemType::id) registered before this one that have to be initialised first
+    };
 
     class SPARTAN_CLASS ISubsystem : public std::enable_shared_from_this<ISubsystem>
     {        
@@ -38,6 +88,7 @@ namespace Spartan
         virtual ~ISubsystem() = default;
 
         virtual bool OnInitialise() { return true; }
+        virtual SubsystemInitDesc GetInitDesc() const { return {}; }
         virtual void OnPreTick() {}
         virtual void OnTick(float delta_time) {}
         virtual void OnPostTick() {}
@@ -0,0 +1,82 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =============
+#include "Spartan.h"
+#include "PoolAllocator.h"
+//========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    Pool::Pool(const size_t element_size, const size_t element_alignment)
+    {
+        // An element has to be able to hold the free list pointer, and each element has to stay aligned
+        m_element_alignment = max(element_alignment, alignof(void*));
+        m_element_size      = max(element_size, sizeof(void*));
+        m_element_size      = (m_element_size + m_element_alignment - 1) & ~(m_element_alignment - 1);
+    }
+
+    Pool::~Pool()
+    {
+        for (void* block : m_blocks)
+        {
+            ::operator delete(block, align_val_t(m_element_alignment));
+        }
+    }
+
+    void* Pool::Allocate()
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        // Allocate a new block and thread its elements into the free list
+        if (!m_free)
+        {
+            char* block = static_cast<char*>(::operator new(m_element_size * elements_per_block, align_val_t(m_element_alignment)));
+            m_blocks.emplace_back(block);
+
+            for (size_t i = elements_per_block; i-- > 0;)
+            {
+                void* element = block + i * m_element_size;
+                *static_cast<void**>(element) = m_free;
+                m_free = element;
+            }
+        }
+
+        void* element = m_free;
+        m_free = *static_cast<void**>(element);
+        return element;
+    }
+
+    void Pool::Free(void* element)
+    {
+        if (!element)
+            return;
+
+        lock_guard<mutex> lock(m_mutex);
+
+        *static_cast<void**>(element) = m_free;
+        m_free = element;
+    }
+}
@@ -0,0 +1,98 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===================
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "Spartan_Definitions.h"
+//==============================
+
+namespace Spartan
+{
+    // Hands out fixed size elements from blocks of 64, which saves a heap allocation per object. Every call takes a lock,
+    // freed elements are recycled (in any order), blocks are never released.
+    class SPARTAN_CLASS Pool
+    {
+    public:
+        Pool(size_t element_size, size_t element_alignment);
+        ~Pool();
+
+        void* Allocate();
+        void Free(void* element);
+
+    private:
+        static constexpr size_t elements_per_block = 64;
+
+        size_t m_element_size       = 0;
+        size_t m_element_alignment  = 0;
+        void* m_free                = nullptr; // intrusive free list
+        std::vector<void*> m_blocks;
+        std::mutex m_mutex;
+    };
+
+    // A standard allocator on top of a Pool, meant for std::allocate_shared(), which allocates the object and its control block together
+    template <typename T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        PoolAllocator() = default;
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U>&) {}
+
+        T* allocate(const size_t count)
+        {
+            if (count != 1)
+                return static_cast<T*>(::operator new(count * sizeof(T)));
+
+            return static_cast<T*>(GetPool().Allocate());
+        }
+
+        void deallocate(T* element, const size_t count)
+        {
+            if (count != 1)
+            {
+                ::operator delete(element);
+                return;
+            }
+
+            GetPool().Free(element);
+        }
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U>&) const { return true; }
+        template <typename U>
+        bool operator!=(const PoolAllocator<U>&) const { return false; }
+
+    private:
+        static Pool& GetPool()
+        {
+            // Intentionally never destroyed, objects might outlive static destruction
+            static Pool* pool = new Pool(sizeof(T), alignof(T));
+            return *pool;
+        }
+    };
+}
@@ -116,6 +116,7 @@ namespace Spartan
 
     void Settings::RegisterThirdPartyLib(const std::string& name, const std::string& version, const std::string& url)
     {
+        lock_guard<mutex> lock(m_third_party_libs_mutex);
         m_third_party_libs.emplace_back(name, version, url);
     }
 
@@ -207,17 +208,28 @@ namespace Spartan
 
     void Settings::Reflect()
     {
-        Renderer* renderer = m_context->GetSubsystem<Renderer>();
-
         m_fps_limit             = m_context->GetSubsystem<Timer>()->GetTargetFps();
         m_max_thread_count      = m_context->GetSubsystem<Threading>()->GetThreadCountSupport();
-        m_is_fullscreen         = m_context->GetSubsystem<Window>()->IsFullScreen();
-        m_is_mouse_visible      = m_context->GetSubsystem<Input>()->GetMouseCursorVisible();
-        m_resolution_output     = renderer->GetResolutionOutput();
-        m_resolution_render     = renderer->GetResolutionRender();
-        m_shadow_map_resolution = renderer->GetOptionValue<uint32_t>(Renderer_Option_Value::ShadowResolution);
-        m_anisotropy            = renderer->GetOptionValue<uint32_t>(Renderer_Option_Value::Anisotropy);
-        m_tonemapping           = renderer->GetOptionValue<uint32_t>(Renderer_Option_Value::Tonemapping);
-        m_renderer_flags        = renderer->GetOptions();
+
+        // A headless engine has none of these, the loaded values are kept as they are
+        if (Window* window = m_context->GetSubsystem<Window>())
+        {
+            m_is_fullscreen = window->IsFullScreen();
+        }
+
+        if (Input* input = m_context->GetSubsystem<Input>())
+        {
+            m_is_mouse_visible = input->GetMouseCursorVisible();
+        }
+
+        if (Renderer* renderer = m_context->GetSubsystem<Renderer>())
+        {
+            m_resolution_output     = renderer->GetResolutionOutput();
+            m_resolution_render     = renderer->GetResolutionRender();
+            m_shadow_map_resolution = renderer->GetOptionValue<uint32_t>(Renderer_Option_Value::ShadowResolution);
+            m_anisotropy            = renderer->GetOptionValue<uint32_t>(Renderer_Option_Value::Anisotropy);
+            m_tonemapping           = renderer->GetOptionValue<uint32_t>(Renderer_Option_Value::Tonemapping);
+            m_renderer_flags        = renderer->GetOptions();
+        }
     }
 }
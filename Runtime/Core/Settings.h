@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ISubsystem.h"
 #include "../Math/Vector2.h"
 #include <vector>
+#include <mutex>
 //==========================
 
 namespace Spartan
@@ -88,5 +89,6 @@ namespace Spartan
         bool m_has_loaded_user_settings     = false;
         Context* m_context                  = nullptr;
         std::vector<ThirdPartyLib> m_third_party_libs;
+        std::mutex m_third_party_libs_mutex; // Subsystems can initialise concurrently
     };
 }
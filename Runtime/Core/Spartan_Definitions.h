@@ -48,6 +48,7 @@ if (x)                  \
 //#define API_GRAPHICS_D3D11    -> Defined by solution generation script
 //#define API_GRAPHICS_D3D12    -> Defined by solution generation script
 //#define API_GRAPHICS_VULKAN   -> Defined by solution generation script
+//#define API_GRAPHICS_NULL     -> Defined by solution generation script
 #define API_INPUT_WINDOWS //    -> Explicitly defined for now
 
 // Fix windows macros
@@ -32,32 +32,23 @@ namespace Spartan
 {
     Timer::Timer(Context* context) : ISubsystem(context)
     {
-        m_time_start        = chrono::high_resolution_clock::now();
-        m_time_sleep_end    = chrono::high_resolution_clock::now();
+        m_time_start    = chrono::high_resolution_clock::now();
+        m_time_frame    = chrono::high_resolution_clock::now();
     }
 
     void Timer::OnTick(float _delta_time)
     {
-        // Compute delta time
-        m_time_sleep_start = chrono::high_resolution_clock::now();
-        chrono::duration<double, milli> delta_time = m_time_sleep_start - m_time_sleep_end;
-
-        // FPS limiting
+        // FPS limiting, a headless engine runs as fast as it can
+        if (!m_context->m_engine->EngineMode_IsSet(Engine_Headless))
         {
-            // The kernel takes time to wake up the thread after the thread has finished sleeping.
-            // It can't be trusted for accurate frame limiting, hence we do it simple stupid.
-            double target_ms = 1000.0 / m_fps_target;
-            while (delta_time.count() < target_ms)
-            {
-                delta_time = chrono::high_resolution_clock::now() - m_time_sleep_start;
-            }
-
-            m_time_sleep_end = chrono::high_resolution_clock::now();
+            m_frame_pacer.Wait(1000.0 / m_fps_target);
         }
 
         // Compute durations
-        m_delta_time_ms = static_cast<double>(delta_time.count());
-        m_time_ms       = static_cast<double>(chrono::duration<double, milli>(m_time_start - m_time_sleep_start).count());
+        const chrono::high_resolution_clock::time_point time_frame = chrono::high_resolution_clock::now();
+        m_delta_time_ms = chrono::duration<double, milli>(time_frame - m_time_frame).count();
+        m_time_ms       = chrono::duration<double, milli>(m_time_start - time_frame).count();
+        m_time_frame    = time_frame;
 
         // Compute smoothed delta time
         const double frames_to_accumulate   = 5;
@@ -81,7 +72,8 @@ namespace Spartan
         if (m_fps_target == fps_in)
             return;
 
-        m_user_selected_fps_target = true;
+        m_fps_target                = fps_in;
+        m_user_selected_fps_target  = true;
         LOG_INFO("Set to %.2f FPS", m_fps_target);
     }
 
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==========
 #include "ISubsystem.h"
+#include "FramePacer.h"
 #include <chrono>
 //=====================
 
@@ -54,6 +55,9 @@ namespace Spartan
         FpsLimitType GetFpsLimitType();
         //====================================================
 
+        // How steadily frames are paced to the FPS target
+        FramePacerStats GetFramePacingStats() const { return m_frame_pacer.GetStats(); }
+
         auto GetTimeMs()                const { return m_time_ms; }
         auto GetTimeSec()               const { return static_cast<float>(m_time_ms / 1000.0); }
         auto GetDeltaTimeMs()           const { return m_delta_time_ms; }
@@ -64,12 +68,11 @@ namespace Spartan
     private:
         // Frame time
         std::chrono::high_resolution_clock::time_point m_time_start;
-        std::chrono::high_resolution_clock::time_point m_time_sleep_start;
-        std::chrono::high_resolution_clock::time_point m_time_sleep_end;
+        std::chrono::high_resolution_clock::time_point m_time_frame;
         double m_time_ms                = 0.0f;
         double m_delta_time_ms          = 0.0f;
         double m_delta_time_smoothed_ms = 0.0f;
-        double m_sleep_overhead         = 0.0f;
+        FramePacer m_frame_pacer;
 
         // FPS
         double m_fps_min                = 30.0;
@@ -56,9 +56,35 @@ namespace Spartan
 
         m_keys.fill(false);
         m_keys_previous_frame.fill(false);
+        m_keys_down_pending.fill(false);
+        m_keys_up_pending.fill(false);
+        m_keys_down_step.fill(false);
+        m_keys_up_step.fill(false);
 
         // Get events from the main Window's event processing loop
         SP_SUBSCRIBE_TO_EVENT(EventType::EventSDL, SP_EVENT_HANDLER_VARIANT(OnEvent));
+
+        // Hand what accumulated since the previous simulation step over to the next one
+        EventSystem::Get().Subscribe<EventFixedStep>([this](const EventFixedStep& event)
+        {
+            if (event.tick_group != TickType::Simulation)
+                return;
+
+            m_keys_down_step            = m_keys_down_pending;
+            m_keys_up_step              = m_keys_up_pending;
+            m_mouse_delta_step          = m_mouse_delta_pending;
+            m_mouse_wheel_delta_step    = m_mouse_wheel_delta_pending;
+            m_keys_down_pending.fill(false);
+            m_keys_up_pending.fill(false);
+            m_mouse_delta_pending       = Vector2::Zero;
+            m_mouse_wheel_delta_pending = Vector2::Zero;
+        }, this);
+    }
+
+    Input::~Input()
+    {
+        SP_UNSUBSCRIBE_FROM_EVENT(EventType::EventSDL);
+        EventSystem::Get().Unsubscribe<EventFixedStep>(this);
     }
 
     void Input::OnTick(float delta_time)
@@ -67,6 +93,15 @@ namespace Spartan
 
         PollMouse();
         PollKeyboard();
+
+        // Accumulate for the next simulation step
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_keys.size()); i++)
+        {
+            m_keys_down_pending[i]  = m_keys_down_pending[i] || (m_keys[i] && !m_keys_previous_frame[i]);
+            m_keys_up_pending[i]    = m_keys_up_pending[i] || (!m_keys[i] && m_keys_previous_frame[i]);
+        }
+        m_mouse_delta_pending       += m_mouse_delta;
+        m_mouse_wheel_delta_pending += m_mouse_wheel_delta;
     }
 
     void Input::OnPostTick()
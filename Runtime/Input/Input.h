@@ -88,7 +88,7 @@ namespace Spartan
     {
     public:
         Input(Context* context);
-        ~Input() = default;
+        ~Input();
 
         //= ISubsystem ========================
         void OnTick(float delta_time) override;
@@ -109,6 +109,13 @@ namespace Spartan
         bool GetKeyDown(const KeyCode key)  { return GetKey(key) && !m_keys_previous_frame[static_cast<uint32_t>(key)]; }   // Returns true during the frame the user pressed down the button identified by KeyCode.
         bool GetKeyUp(const KeyCode key)    { return !GetKey(key) && m_keys_previous_frame[static_cast<uint32_t>(key)]; }   // Returns true the first frame the user releases the button identified by KeyCode.
 
+        // Simulation steps (e.g. scripts) see what happened since the previous step, so that a frame without a step
+        // doesn't drop a key press or mouse movement and a frame with several steps doesn't deliver it more than once.
+        bool GetKeyDownStep(const KeyCode key)              const { return m_keys_down_step[static_cast<uint32_t>(key)]; }
+        bool GetKeyUpStep(const KeyCode key)                const { return m_keys_up_step[static_cast<uint32_t>(key)]; }
+        const Math::Vector2& GetMouseDeltaStep()            const { return m_mouse_delta_step; }
+        const Math::Vector2& GetMouseWheelDeltaStep()       const { return m_mouse_wheel_delta_step; }
+
         // Mouse
         void SetMouseCursorVisible(const bool visible);
         bool GetMouseCursorVisible()                            const { return m_mouse_cursor_visible; }
@@ -139,16 +146,24 @@ namespace Spartan
         // Keys
         std::array<bool, 107> m_keys;
         std::array<bool, 107> m_keys_previous_frame;
+        std::array<bool, 107> m_keys_down_pending;  // Since the previous simulation step
+        std::array<bool, 107> m_keys_up_pending;    // Since the previous simulation step
+        std::array<bool, 107> m_keys_down_step;
+        std::array<bool, 107> m_keys_up_step;
         uint32_t start_index_mouse      = 83;
         uint32_t start_index_gamepad    = 86;
 
         // Mouse
-        Math::Vector2 m_mouse_position          = Math::Vector2::Zero;
-        Math::Vector2 m_mouse_delta             = Math::Vector2::Zero;
-        Math::Vector2 m_mouse_wheel_delta       = Math::Vector2::Zero;
-        Math::Vector2 m_editor_viewport_offset  = Math::Vector2::Zero;
-        bool m_mouse_is_in_viewport             = true;
-        bool m_mouse_cursor_visible             = true;
+        Math::Vector2 m_mouse_position            = Math::Vector2::Zero;
+        Math::Vector2 m_mouse_delta               = Math::Vector2::Zero;
+        Math::Vector2 m_mouse_wheel_delta         = Math::Vector2::Zero;
+        Math::Vector2 m_mouse_delta_pending       = Math::Vector2::Zero;
+        Math::Vector2 m_mouse_delta_step          = Math::Vector2::Zero;
+        Math::Vector2 m_mouse_wheel_delta_pending = Math::Vector2::Zero;
+        Math::Vector2 m_mouse_wheel_delta_step    = Math::Vector2::Zero;
+        Math::Vector2 m_editor_viewport_offset    = Math::Vector2::Zero;
+        bool m_mouse_is_in_viewport               = true;
+        bool m_mouse_cursor_visible               = true;
 
         // Controller
         void* m_controller                      = nullptr;
@@ -0,0 +1,93 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==========
+#include <vector>
+#include "BoundingBox.h"
+//=====================
+
+namespace Spartan::Math
+{
+    // Bounding boxes stored as centers and extents, one array per component (structure of arrays),
+    // so that they can be loaded and tested against a frustum a few boxes at a time.
+    // The arrays are padded to a multiple of the batch size, the padding is never reported as visible.
+    class BoundingBoxArray
+    {
+    public:
+        static constexpr uint32_t batch_size = 4;
+
+        void Clear()
+        {
+            m_count = 0;
+            for (std::vector<float>& component : m_components)
+            {
+                component.clear();
+            }
+        }
+
+        void Reserve(const uint32_t count)
+        {
+            for (std::vector<float>& component : m_components)
+            {
+                component.reserve(GetPaddedCount(count));
+            }
+        }
+
+        void Add(const BoundingBox& box)
+        {
+            const Vector3 center    = box.GetCenter();
+            const Vector3 extents   = box.GetExtents();
+
+            // Grow by a whole batch, so that a batch can always be loaded at once
+            if (m_count == m_components[0].size())
+            {
+                for (std::vector<float>& component : m_components)
+                {
+                    component.resize(m_count + batch_size, 0.0f);
+                }
+            }
+
+            m_components[0][m_count] = center.x;
+            m_components[1][m_count] = center.y;
+            m_components[2][m_count] = center.z;
+            m_components[3][m_count] = extents.x;
+            m_components[4][m_count] = extents.y;
+            m_components[5][m_count] = extents.z;
+            m_count++;
+        }
+
+        uint32_t GetCount() const           { return m_count; }
+        const float* GetCenterX() const     { return m_components[0].data(); }
+        const float* GetCenterY() const     { return m_components[1].data(); }
+        const float* GetCenterZ() const     { return m_components[2].data(); }
+        const float* GetExtentX() const     { return m_components[3].data(); }
+        const float* GetExtentY() const     { return m_components[4].data(); }
+        const float* GetExtentZ() const     { return m_components[5].data(); }
+
+        static uint32_t GetPaddedCount(const uint32_t count) { return (count + batch_size - 1) & ~(batch_size - 1); }
+
+    private:
+        std::vector<float> m_components[6];
+        uint32_t m_count = 0;
+    };
+}
@@ -108,6 +108,86 @@ namespace Spartan::Math
         return false;
     }
 
+    void Frustum::IsVisible(const BoundingBoxArray& boxes, vector<uint64_t>& visible, bool ignore_depth_planes /*= false*/) const
+    {
+        const uint32_t count = boxes.GetCount();
+        visible.assign((count + 63) / 64, 0);
+
+        // A box is outside if it's entirely behind any plane, that is if dot(center, normal) + dot(extent, |normal|) < -d
+        const uint32_t plane_first = ignore_depth_planes ? 2 : 0;
+
+        const float* center_x = boxes.GetCenterX();
+        const float* center_y = boxes.GetCenterY();
+        const float* center_z = boxes.GetCenterZ();
+        const float* extent_x = boxes.GetExtentX();
+        const float* extent_y = boxes.GetExtentY();
+        const float* extent_z = boxes.GetExtentZ();
+
+    #if defined(SPARTAN_SIMD_SSE)
+        // Four boxes at a time, against one plane at a time
+        __m128 normal_x[6], normal_y[6], normal_z[6], normal_abs_x[6], normal_abs_y[6], normal_abs_z[6], distance[6];
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        for (uint32_t i = plane_first; i < 6; i++)
+        {
+            normal_x[i]     = _mm_set1_ps(m_planes[i].normal.x);
+            normal_y[i]     = _mm_set1_ps(m_planes[i].normal.y);
+            normal_z[i]     = _mm_set1_ps(m_planes[i].normal.z);
+            normal_abs_x[i] = _mm_andnot_ps(sign_mask, normal_x[i]);
+            normal_abs_y[i] = _mm_andnot_ps(sign_mask, normal_y[i]);
+            normal_abs_z[i] = _mm_andnot_ps(sign_mask, normal_z[i]);
+            distance[i]     = _mm_set1_ps(-m_planes[i].d);
+        }
+
+        for (uint32_t index = 0; index < count; index += BoundingBoxArray::batch_size)
+        {
+            const __m128 c_x = _mm_loadu_ps(center_x + index);
+            const __m128 c_y = _mm_loadu_ps(center_y + index);
+            const __m128 c_z = _mm_loadu_ps(center_z + index);
+            const __m128 e_x = _mm_loadu_ps(extent_x + index);
+            const __m128 e_y = _mm_loadu_ps(extent_y + index);
+            const __m128 e_z = _mm_loadu_ps(extent_z + index);
+
+            __m128 outside = _mm_setzero_ps();
+            for (uint32_t i = plane_first; i < 6; i++)
+            {
+                const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c_x, normal_x[i]), _mm_mul_ps(c_y, normal_y[i])), _mm_mul_ps(c_z, normal_z[i]));
+                const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e_x, normal_abs_x[i]), _mm_mul_ps(e_y, normal_abs_y[i])), _mm_mul_ps(e_z, normal_abs_z[i]));
+                outside        = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), distance[i]));
+            }
+
+            const uint64_t mask = static_cast<uint64_t>(~_mm_movemask_ps(outside) & 0xF);
+            visible[index >> 6] |= mask << (index & 63);
+        }
+    #else
+        for (uint32_t index = 0; index < count; index += BoundingBoxArray::batch_size)
+        {
+            uint64_t mask = 0;
+            for (uint32_t lane = 0; lane < BoundingBoxArray::batch_size; lane++)
+            {
+                const uint32_t box = index + lane;
+                bool outside = false;
+                for (uint32_t i = plane_first; i < 6; i++)
+                {
+                    const Plane& plane  = m_planes[i];
+                    const float d       = center_x[box] * plane.normal.x + center_y[box] * plane.normal.y + center_z[box] * plane.normal.z;
+                    const float r       = extent_x[box] * Helper::Abs(plane.normal.x) + extent_y[box] * Helper::Abs(plane.normal.y) + extent_z[box] * Helper::Abs(plane.normal.z);
+                    outside             = outside | (d + r < -plane.d);
+                }
+
+                mask |= static_cast<uint64_t>(!outside) << lane;
+            }
+
+            visible[index >> 6] |= mask << (index & 63);
+        }
+    #endif
+
+        // Clear the bits of the padding
+        if (const uint32_t tail = count & 63)
+        {
+            visible.back() &= (uint64_t(1) << tail) - 1;
+        }
+    }
+
     Intersection Frustum::CheckCube(const Vector3& center, const Vector3& extent) const
     {
         Intersection result = Inside;
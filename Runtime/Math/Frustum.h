@@ -21,15 +21,17 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES =============
+//= INCLUDES =================
+#include <vector>
 #include "../Math/Plane.h"
 #include "Matrix.h"
 #include "Vector3.h"
-//========================
+#include "BoundingBoxArray.h"
+//============================
 
 namespace Spartan::Math
 {
-    class Frustum
+    class SPARTAN_CLASS Frustum
     {
     public:
         Frustum() = default;
@@ -38,10 +40,14 @@ namespace Spartan::Math
 
         bool IsVisible(const Vector3& center, const Vector3& extent, bool ignore_near_plane = false) const;
 
+        // Tests all the boxes against the exact planes (not the enclosing sphere/cube of IsVisible()) and writes
+        // one bit per box, set if the box is visible. Ignoring the depth planes, only the sides of the frustum are tested.
+        void IsVisible(const BoundingBoxArray& boxes, std::vector<uint64_t>& visible, bool ignore_depth_planes = false) const;
+
     private:
         Intersection CheckCube(const Vector3& center, const Vector3& extent) const;
         Intersection CheckSphere(const Vector3& center, float radius) const;
 
-        Plane m_planes[6];
+        Plane m_planes[6]; // near, far, left, right, top, bottom
     };
 }
@@ -27,6 +27,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <random>
 //===============
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// SIMD is chosen at compile time, SSE is part of x64 so it's always there (define SPARTAN_NO_SIMD for the scalar code)
+#if !defined(SPARTAN_NO_SIMD) && (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__))
+#define SPARTAN_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace Spartan::Math
 {
     enum Intersection
@@ -150,4 +160,16 @@ namespace Spartan::Math::Helper
         x |= x >> 16;
         return x++;
     }
+
+    // Returns the index of the lowest set bit (the value can't be zero)
+    inline uint32_t CountTrailingZeros(const uint64_t x)
+    {
+    #if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanForward64(&index, x);
+        return static_cast<uint32_t>(index);
+    #else
+        return static_cast<uint32_t>(__builtin_ctzll(x));
+    #endif
+    }
 }
@@ -273,12 +273,20 @@ namespace Spartan::Math
         void Transpose() { *this = Transpose(*this); }
         static inline Matrix Transpose(const Matrix& matrix)
         {
+        #if defined(SPARTAN_SIMD_SSE)
+            Matrix result;
+            __m128 row0, row1, row2, row3;
+            matrix.LoadRows(row0, row1, row2, row3);
+            result.StoreColumns(row0, row1, row2, row3);
+            return result;
+        #else
             return Matrix(
                 matrix.m00, matrix.m10, matrix.m20, matrix.m30,
                 matrix.m01, matrix.m11, matrix.m21, matrix.m31,
                 matrix.m02, matrix.m12, matrix.m22, matrix.m32,
                 matrix.m03, matrix.m13, matrix.m23, matrix.m33
             );
+        #endif
         }
         //==================================================================
 
@@ -286,6 +294,52 @@ namespace Spartan::Math
         [[nodiscard]] Matrix Inverted() const { return Invert(*this); }
         static inline Matrix Invert(const Matrix& matrix)
         {
+        #if defined(SPARTAN_SIMD_SSE)
+            // The same cofactor expansion as the scalar code, evaluated in the same order (so the results are identical),
+            // four cofactors at a time. Each column of the inverse needs the 2x2 minors of two rows (a and b) and a third row (u).
+            __m128 row0, row1, row2, row3;
+            matrix.LoadRows(row0, row1, row2, row3);
+
+            const __m128 sign_even  = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f); // + - + -
+            const __m128 sign_odd   = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f); // - + - +
+
+            auto cofactors = [](const __m128 a, const __m128 b, const __m128 u, const __m128 sign)
+            {
+                const __m128 a_2211 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 2, 2));
+                const __m128 a_3332 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 3, 3));
+                const __m128 a_1000 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 1));
+                const __m128 b_2211 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 2, 2));
+                const __m128 b_3332 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 3, 3));
+                const __m128 b_1000 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 1));
+
+                // Minors, laid out as (v5, v5, v4, v3), (v4, v2, v2, v1) and (v3, v1, v0, v0)
+                const __m128 minor_a = _mm_sub_ps(_mm_mul_ps(a_2211, b_3332), _mm_mul_ps(a_3332, b_2211));
+                const __m128 minor_c = _mm_sub_ps(_mm_mul_ps(a_1000, b_3332), _mm_mul_ps(a_3332, b_1000));
+                const __m128 minor_e = _mm_sub_ps(_mm_mul_ps(a_1000, b_2211), _mm_mul_ps(a_2211, b_1000));
+
+                const __m128 u_1000 = _mm_shuffle_ps(u, u, _MM_SHUFFLE(0, 0, 0, 1));
+                const __m128 u_2211 = _mm_shuffle_ps(u, u, _MM_SHUFFLE(1, 1, 2, 2));
+                const __m128 u_3332 = _mm_shuffle_ps(u, u, _MM_SHUFFLE(2, 3, 3, 3));
+
+                const __m128 result = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(minor_a, u_1000), _mm_mul_ps(minor_c, u_2211)), _mm_mul_ps(minor_e, u_3332));
+                return _mm_xor_ps(result, sign);
+            };
+
+            const __m128 column0 = cofactors(row2, row3, row1, sign_even);
+            const __m128 column1 = cofactors(row2, row3, row0, sign_odd);
+            const __m128 column2 = cofactors(row1, row3, row0, sign_even);
+            const __m128 column3 = cofactors(row1, row2, row0, sign_odd);
+
+            // Determinant, summed in order
+            float c[4], r[4];
+            _mm_storeu_ps(c, column0);
+            _mm_storeu_ps(r, row0);
+            const __m128 det_inv = _mm_set1_ps(1.0f / (c[0] * r[0] + c[1] * r[1] + c[2] * r[2] + c[3] * r[3]));
+
+            Matrix result;
+            result.StoreColumns(_mm_mul_ps(column0, det_inv), _mm_mul_ps(column1, det_inv), _mm_mul_ps(column2, det_inv), _mm_mul_ps(column3, det_inv));
+            return result;
+        #else
             float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
             float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
             float v2 = matrix.m20 * matrix.m33 - matrix.m23 *matrix.m30;
@@ -339,6 +393,69 @@ namespace Spartan::Math
                 i10, i11, i12, i13,
                 i20, i21, i22, i23,
                 i30, i31, i32, i33);
+        #endif
+        }
+
+        // Inverts a matrix which only translates, rotates and scales (or shears), which is a lot cheaper than a full inversion
+        [[nodiscard]] Matrix InvertedAffine() const { return InvertAffine(*this); }
+        static inline Matrix InvertAffine(const Matrix& matrix)
+        {
+        #if defined(SPARTAN_SIMD_SSE)
+            __m128 row0, row1, row2, translation;
+            matrix.LoadRows(row0, row1, row2, translation);
+
+            auto cross = [](const __m128 a, const __m128 b)
+            {
+                const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+                const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+                const __m128 c     = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+                return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+            };
+
+            // The columns of the inverted 3x3 part are the cross products of its rows, divided by the determinant
+            __m128 column0 = cross(row1, row2);
+            __m128 column1 = cross(row2, row0);
+            __m128 column2 = cross(row0, row1);
+            float c[4], r[4];
+            _mm_storeu_ps(c, column0);
+            _mm_storeu_ps(r, row0);
+            const __m128 det_inv = _mm_set1_ps(1.0f / (r[0] * c[0] + r[1] * c[1] + r[2] * c[2]));
+            column0 = _mm_mul_ps(column0, det_inv);
+            column1 = _mm_mul_ps(column1, det_inv);
+            column2 = _mm_mul_ps(column2, det_inv);
+
+            // Turn them into rows, the translation is the negated original one, moved through them
+            __m128 row3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(column0, column1, column2, row3);
+            const __m128 t = _mm_sub_ps(_mm_setzero_ps(), translation);
+            row3 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)), column0), _mm_mul_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)), column1)), _mm_mul_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)), column2));
+            row3 = _mm_add_ps(row3, _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+
+            // And store them as columns
+            _MM_TRANSPOSE4_PS(column0, column1, column2, row3);
+            Matrix result;
+            result.StoreColumns(column0, column1, column2, row3);
+            return result;
+        #else
+            // The columns of the inverted 3x3 part are the cross products of its rows, divided by the determinant
+            const Vector3 row0(matrix.m00, matrix.m01, matrix.m02);
+            const Vector3 row1(matrix.m10, matrix.m11, matrix.m12);
+            const Vector3 row2(matrix.m20, matrix.m21, matrix.m22);
+            const Vector3 translation(matrix.m30, matrix.m31, matrix.m32);
+
+            const Vector3 cross12   = Vector3::Cross(row1, row2);
+            const float det_inv     = 1.0f / Vector3::Dot(row0, cross12);
+            const Vector3 column0   = cross12 * det_inv;
+            const Vector3 column1   = Vector3::Cross(row2, row0) * det_inv;
+            const Vector3 column2   = Vector3::Cross(row0, row1) * det_inv;
+
+            return Matrix(
+                column0.x, column1.x, column2.x, 0.0f,
+                column0.y, column1.y, column2.y, 0.0f,
+                column0.z, column1.z, column2.z, 0.0f,
+                -Vector3::Dot(translation, column0), -Vector3::Dot(translation, column1), -Vector3::Dot(translation, column2), 1.0f
+            );
+        #endif
         }
         //================================================================================================
 
@@ -360,6 +477,27 @@ namespace Spartan::Math
         //= MULTIPLICATION ================================================================================================================
         Matrix operator*(const Matrix& rhs) const
         {
+        #if defined(SPARTAN_SIMD_SSE)
+            // Every column of the result is the columns of the left side, weighted by a column of the right side
+            const __m128 column0 = _mm_loadu_ps(&m00);
+            const __m128 column1 = _mm_loadu_ps(&m01);
+            const __m128 column2 = _mm_loadu_ps(&m02);
+            const __m128 column3 = _mm_loadu_ps(&m03);
+
+            auto multiply = [&](const float* column_rhs)
+            {
+                const __m128 weights = _mm_loadu_ps(column_rhs);
+                __m128 result = _mm_mul_ps(column0, _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(0, 0, 0, 0)));
+                result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(1, 1, 1, 1))));
+                result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(2, 2, 2, 2))));
+                result = _mm_add_ps(result, _mm_mul_ps(column3, _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(3, 3, 3, 3))));
+                return result;
+            };
+
+            Matrix result;
+            result.StoreColumns(multiply(&rhs.m00), multiply(&rhs.m01), multiply(&rhs.m02), multiply(&rhs.m03));
+            return result;
+        #else
             return Matrix(
                 m00 * rhs.m00 + m01 * rhs.m10 + m02 * rhs.m20 + m03 * rhs.m30,
                 m00 * rhs.m01 + m01 * rhs.m11 + m02 * rhs.m21 + m03 * rhs.m31,
@@ -378,6 +516,7 @@ namespace Spartan::Math
                 m30 * rhs.m02 + m31 * rhs.m12 + m32 * rhs.m22 + m33 * rhs.m32,
                 m30 * rhs.m03 + m31 * rhs.m13 + m32 * rhs.m23 + m33 * rhs.m33
             );
+        #endif
         }
 
         void operator*=(const Matrix& rhs) { (*this) = (*this) * rhs; }
@@ -442,6 +581,26 @@ namespace Spartan::Math
         [[nodiscard]] const float* Data() const { return &m00; }
         [[nodiscard]] std::string ToString() const;
 
+    #if defined(SPARTAN_SIMD_SSE)
+        // Memory is column-major, so columns load as is and rows need a transpose
+        void LoadRows(__m128& row0, __m128& row1, __m128& row2, __m128& row3) const
+        {
+            row0 = _mm_loadu_ps(&m00);
+            row1 = _mm_loadu_ps(&m01);
+            row2 = _mm_loadu_ps(&m02);
+            row3 = _mm_loadu_ps(&m03);
+            _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+        }
+
+        void StoreColumns(const __m128 column0, const __m128 column1, const __m128 column2, const __m128 column3)
+        {
+            _mm_storeu_ps(&m00, column0);
+            _mm_storeu_ps(&m01, column1);
+            _mm_storeu_ps(&m02, column2);
+            _mm_storeu_ps(&m03, column3);
+        }
+    #endif
+
         // Column-major memory representation 
         float m00 = 0.0f, m10 = 0.0f, m20 = 0.0f, m30 = 0.0f;
         float m01 = 0.0f, m11 = 0.0f, m21 = 0.0f, m31 = 0.0f;
@@ -185,6 +185,20 @@ namespace Spartan::Math
             return start.Inverse() * end;
         }
 
+        // Normalized linear interpolation, along the shortest path
+        static inline Quaternion Lerp(const Quaternion& start, const Quaternion& end, const float t)
+        {
+            const float dot = start.x * end.x + start.y * end.y + start.z * end.z + start.w * end.w;
+            const float sign = dot < 0.0f ? -1.0f : 1.0f;
+
+            return Quaternion(
+                start.x + (end.x * sign - start.x) * t,
+                start.y + (end.y * sign - start.y) * t,
+                start.z + (end.z * sign - start.z) * t,
+                start.w + (end.w * sign - start.w) * t
+            ).Normalized();
+        }
+
         auto Conjugate() const        { return Quaternion(-x, -y, -z, w); }
         float LengthSquared() const    { return (x * x) + (y * y) + (z * z) + (w * w); }
 
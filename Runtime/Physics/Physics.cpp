@@ -112,16 +112,16 @@ namespace Spartan
         return true;
     }
 
+    SubsystemInitDesc Physics::GetInitDesc() const
+    {
+        // Bullet is independent of the rest of the engine, the renderer is only referenced
+        return { true, { SubsystemType::id<Settings> } };
+    }
+
     void Physics::OnTick(float delta_time_sec)
     {
         if (!m_world)
             return;
-        
-        // Debug draw
-        if (m_renderer->GetOptions() & Render_Debug_Physics)
-        {
-            m_world->debugDrawWorld();
-        }
 
         // Don't simulate physics if they are turned off or the we are in editor mode
         if (!m_context->m_engine->EngineMode_IsSet(Engine_Physics) || !m_context->m_engine->EngineMode_IsSet(Engine_Game))
@@ -148,6 +148,15 @@ namespace Spartan
         m_simulating = false;
     }
 
+    void Physics::OnPostTick()
+    {
+        // Debug draw, once per frame (a frame can have any number of simulation steps)
+        if (m_world && m_renderer && (m_renderer->GetOptions() & Render_Debug_Physics))
+        {
+            m_world->debugDrawWorld();
+        }
+    }
+
     void Physics::AddBody(btRigidBody* body) const
     {
         if (!m_world)
@@ -54,7 +54,9 @@ namespace Spartan
 
         //= Subsystem =======================
         bool OnInitialise() override;
+        SubsystemInitDesc GetInitDesc() const override;
         void OnTick(float delta_time) override;
+        void OnPostTick() override;
         //===================================
 
         // Rigid body
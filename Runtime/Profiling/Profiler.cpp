@@ -56,12 +56,15 @@ namespace Spartan
         m_resource_manager    = m_context->GetSubsystem<ResourceCache>();
         m_renderer            = m_context->GetSubsystem<Renderer>();
         m_timer               = m_context->GetSubsystem<Timer>();
+        m_threading           = m_context->GetSubsystem<Threading>();
 
         return true;
     }
 
     void Profiler::OnTick(float delta_time)
     {
+        UpdateThreadingMetrics(delta_time);
+
         if (!m_renderer)
             return;
 
@@ -69,6 +72,8 @@ namespace Spartan
         if (!rhi_device || !rhi_device->GetContextRhi()->profiler)
             return;
 
+        unique_lock<mutex> lock(m_time_blocks_mutex);
+
         if (m_increase_capacity)
         {
             OnFrameEnd();
@@ -90,6 +95,8 @@ namespace Spartan
             }
         }
 
+        lock.unlock();
+
         // Compute timings
         {
             // Detect stutters
@@ -221,17 +228,21 @@ namespace Spartan
         if (!can_profile_cpu && !can_profile_gpu)
             return;
 
+        lock_guard<mutex> lock(m_time_blocks_mutex);
+
         // Last incomplete block of the same type, is the parent
         TimeBlock* time_block_parent = GetLastIncompleteTimeBlock(type);
 
         if (TimeBlock* time_block = GetNewTimeBlock())
         {
-            time_block->Begin(func_name, type, time_block_parent, cmd_list, m_renderer->GetRhiDevice());
+            time_block->Begin(func_name, type, time_block_parent, cmd_list, m_renderer ? m_renderer->GetRhiDevice() : nullptr);
         }
     }
 
     void Profiler::TimeBlockEnd()
     {
+        lock_guard<mutex> lock(m_time_blocks_mutex);
+
         // If the capacity 
         if (m_increase_capacity)
             return;
@@ -273,10 +284,16 @@ namespace Spartan
 
     TimeBlock* Profiler::GetLastIncompleteTimeBlock(TimeBlockType type /*= TimeBlock_Undefined*/)
     {
+        // Blocks nest per thread, the simulation and the renderer can record at the same time
+        const thread::id thread_id = this_thread::get_id();
+
         for (int i = m_time_block_count - 1; i >= 0; i--)
         {
             TimeBlock& time_block = m_time_blocks_write[i];
 
+            if (time_block.GetThreadId() != thread_id)
+                continue;
+
             if (type == time_block.GetType() || type == TimeBlockType::Undefined)
             {
                 if (!time_block.IsComplete())
@@ -300,6 +317,40 @@ namespace Spartan
         }
     }
 
+    void Profiler::UpdateThreadingMetrics(const float delta_time)
+    {
+        if (!m_threading || delta_time <= 0.0f)
+            return;
+
+        // The worker counters accumulate, so the difference from the previous frame is what happened during the last frame
+        swap(m_threading_stats, m_threading_stats_previous);
+        m_threading->GetStats(m_threading_stats);
+
+        const uint32_t worker_count     = static_cast<uint32_t>(m_threading_stats.workers.size());
+        const double frame_time_ns      = static_cast<double>(delta_time) * 1e9;
+        m_threading_tasks_pending       = m_threading_stats.tasks_pending;
+        m_threading_tasks_executing     = m_threading_stats.tasks_executing;
+        m_threading_tasks_completed     = 0;
+        m_threading_steals              = 0;
+        m_threading_worker_count_io     = m_threading->GetThreadCountIo();
+        m_threading_worker_saturation.resize(worker_count);
+
+        // The first frame has nothing to compare against
+        if (m_threading_stats_previous.workers.size() != worker_count)
+            return;
+
+        for (uint32_t i = 0; i < worker_count; i++)
+        {
+            const WorkerStats& worker_now   = m_threading_stats.workers[i];
+            const WorkerStats& worker_then  = m_threading_stats_previous.workers[i];
+            const double busy_time_ns       = static_cast<double>(worker_now.busy_time_ns - worker_then.busy_time_ns);
+
+            m_threading_worker_saturation[i] = Math::Helper::Saturate(static_cast<float>(busy_time_ns / frame_time_ns));
+            m_threading_tasks_completed      += static_cast<uint32_t>(worker_now.task_count - worker_then.task_count);
+            m_threading_steals               += static_cast<uint32_t>(worker_now.steal_count - worker_then.steal_count);
+        }
+    }
+
     void Profiler::UpdateRhiMetricsString()
     {
         const auto texture_count    = m_resource_manager->GetResourceCount(ResourceType::Texture) + m_resource_manager->GetResourceCount(ResourceType::Texture2d) + m_resource_manager->GetResourceCount(ResourceType::TextureCube);
@@ -330,6 +381,7 @@ namespace Spartan
             "\n"
             // Renderer
             "Meshes rendered:\t%d\n"
+            "Uber buffer updates:\t%d\n"
             "Textures:\t\t\t%d\n"
             "Materials:\t\t%d\n"
             "\n"
@@ -339,6 +391,7 @@ namespace Spartan
             "Index buffer:\t\t%d\n"
             "Vertex buffer:\t\t%d\n"
             "Constant buffer:\t%d\n"
+            "Structured buffer:\t%d\n"
             "Sampler:\t\t\t%d\n"
             "Texture sampled:\t%d\n"
             "Texture storage:\t%d\n"
@@ -374,6 +427,7 @@ namespace Spartan
 
             // Renderer
             m_renderer_meshes_rendered,
+            m_renderer_buffer_uber_updates,
             texture_count,
             material_count,
 
@@ -383,6 +437,7 @@ namespace Spartan
             m_rhi_bindings_buffer_index,
             m_rhi_bindings_buffer_vertex,
             m_rhi_bindings_buffer_constant,
+            m_rhi_bindings_buffer_structured,
             m_rhi_bindings_sampler,
             m_rhi_bindings_texture_sampled,
             m_rhi_bindings_texture_storage,
@@ -24,7 +24,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===========================
 #include <string>
 #include <vector>
+#include <mutex>
 #include "TimeBlock.h"
+#include "../Threading/Threading.h"
 #include "../Core/ISubsystem.h"
 #include "../Core/Stopwatch.h"
 #include "../Core/Spartan_Definitions.h"
@@ -76,24 +78,34 @@ namespace Spartan
         bool IsGpuStuttering()                          const { return m_is_stuttering_gpu; }
         
         // Metrics - RHI
-        uint32_t m_rhi_draw                     = 0;
-        uint32_t m_rhi_dispatch                 = 0;
-        uint32_t m_rhi_bindings_buffer_index    = 0;
-        uint32_t m_rhi_bindings_buffer_vertex   = 0;
-        uint32_t m_rhi_bindings_buffer_constant = 0;
-        uint32_t m_rhi_bindings_sampler         = 0;
-        uint32_t m_rhi_bindings_texture_sampled = 0;
-        uint32_t m_rhi_bindings_shader_vertex   = 0;
-        uint32_t m_rhi_bindings_shader_pixel    = 0;
-        uint32_t m_rhi_bindings_shader_compute  = 0;
-        uint32_t m_rhi_bindings_render_target   = 0;
-        uint32_t m_rhi_bindings_texture_storage = 0;
-        uint32_t m_rhi_bindings_descriptor_set  = 0;
-        uint32_t m_rhi_bindings_pipeline        = 0;
-        uint32_t m_rhi_pipeline_barriers        = 0;
+        uint32_t m_rhi_draw                       = 0;
+        uint32_t m_rhi_dispatch                   = 0;
+        uint32_t m_rhi_bindings_buffer_index      = 0;
+        uint32_t m_rhi_bindings_buffer_vertex     = 0;
+        uint32_t m_rhi_bindings_buffer_constant   = 0;
+        uint32_t m_rhi_bindings_buffer_structured = 0;
+        uint32_t m_rhi_bindings_sampler           = 0;
+        uint32_t m_rhi_bindings_texture_sampled   = 0;
+        uint32_t m_rhi_bindings_shader_vertex     = 0;
+        uint32_t m_rhi_bindings_shader_pixel      = 0;
+        uint32_t m_rhi_bindings_shader_compute    = 0;
+        uint32_t m_rhi_bindings_render_target     = 0;
+        uint32_t m_rhi_bindings_texture_storage   = 0;
+        uint32_t m_rhi_bindings_descriptor_set    = 0;
+        uint32_t m_rhi_bindings_pipeline          = 0;
+        uint32_t m_rhi_pipeline_barriers          = 0;
 
         // Metrics - Renderer
-        uint32_t m_renderer_meshes_rendered = 0;
+        uint32_t m_renderer_meshes_rendered     = 0;
+        uint32_t m_renderer_buffer_uber_updates = 0;
+
+        // Metrics - Threading
+        uint32_t m_threading_tasks_pending      = 0;
+        uint32_t m_threading_tasks_executing    = 0;
+        uint32_t m_threading_tasks_completed    = 0; // last frame
+        uint32_t m_threading_steals             = 0; // last frame
+        std::vector<float> m_threading_worker_saturation; // fraction of the last frame that each worker spent executing tasks
+        uint32_t m_threading_worker_count_io    = 0; // the last workers are the io threads
 
         // Metrics - Time
         float m_time_frame_avg  = 0.0f;
@@ -112,28 +124,31 @@ namespace Spartan
     private:
         void ClearRhiMetrics()
         {
-            m_rhi_draw                      = 0;
-            m_rhi_dispatch                  = 0;
-            m_renderer_meshes_rendered      = 0;
-            m_rhi_bindings_buffer_index     = 0;
-            m_rhi_bindings_buffer_vertex    = 0;
-            m_rhi_bindings_buffer_constant  = 0;
-            m_rhi_bindings_sampler          = 0;
-            m_rhi_bindings_texture_sampled  = 0;
-            m_rhi_bindings_shader_vertex    = 0;
-            m_rhi_bindings_shader_pixel     = 0;
-            m_rhi_bindings_shader_compute   = 0;
-            m_rhi_bindings_render_target    = 0;
-            m_rhi_bindings_texture_storage  = 0;
-            m_rhi_bindings_descriptor_set   = 0;
-            m_rhi_bindings_pipeline         = 0;
-            m_rhi_pipeline_barriers         = 0;
+            m_rhi_draw                       = 0;
+            m_rhi_dispatch                   = 0;
+            m_renderer_meshes_rendered       = 0;
+            m_renderer_buffer_uber_updates   = 0;
+            m_rhi_bindings_buffer_index      = 0;
+            m_rhi_bindings_buffer_vertex     = 0;
+            m_rhi_bindings_buffer_constant   = 0;
+            m_rhi_bindings_buffer_structured = 0;
+            m_rhi_bindings_sampler           = 0;
+            m_rhi_bindings_texture_sampled   = 0;
+            m_rhi_bindings_shader_vertex     = 0;
+            m_rhi_bindings_shader_pixel      = 0;
+            m_rhi_bindings_shader_compute    = 0;
+            m_rhi_bindings_render_target     = 0;
+            m_rhi_bindings_texture_storage   = 0;
+            m_rhi_bindings_descriptor_set    = 0;
+            m_rhi_bindings_pipeline          = 0;
+            m_rhi_pipeline_barriers          = 0;
         }
 
         TimeBlock* GetNewTimeBlock();
         TimeBlock* GetLastIncompleteTimeBlock(TimeBlockType type = TimeBlockType::Undefined);
         void AcquireGpuData();
         void UpdateRhiMetricsString();
+        void UpdateThreadingMetrics(float delta_time);
 
         // Profiling options
         bool m_profile                      = false;
@@ -147,6 +162,7 @@ namespace Spartan
         uint32_t m_time_block_count     = 0;
         std::vector<TimeBlock> m_time_blocks_write;
         std::vector<TimeBlock> m_time_blocks_read;
+        std::mutex m_time_blocks_mutex; // the simulation and the renderer can record time blocks concurrently
 
         // FPS
         float m_delta_time          = 0.0f;
@@ -154,6 +170,10 @@ namespace Spartan
         float m_time_passed         = 0.0f;
         uint32_t m_frames_since_last_fps_computation = 0;
 
+        // Threading
+        ThreadingStats m_threading_stats;
+        ThreadingStats m_threading_stats_previous;
+
         // Hardware - GPU
         std::string m_gpu_name          = "N/A";
         std::string m_gpu_driver        = "N/A";
@@ -176,6 +196,7 @@ namespace Spartan
         ResourceCache* m_resource_manager   = nullptr;
         Renderer* m_renderer                = nullptr;
         Timer* m_timer                      = nullptr;
+        Threading* m_threading              = nullptr;
     };
 
     class ScopedTimeBlock
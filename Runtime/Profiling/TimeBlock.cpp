@@ -47,6 +47,7 @@ namespace Spartan
         m_rhi_device        = rhi_device.get();
         m_cmd_list          = cmd_list;
         m_type              = type;
+        m_thread_id         = this_thread::get_id();
         m_max_tree_depth    = Math::Helper::Max(m_max_tree_depth, m_tree_depth);
 
         if (type == TimeBlockType::Cpu)
@@ -117,6 +118,7 @@ namespace Spartan
         m_duration          = 0.0f;
         m_max_tree_depth    = 0;
         m_type              = TimeBlockType::Undefined;
+        m_thread_id         = thread::id();
         m_is_complete       = false;
 
         if (m_rhi_device && m_rhi_device->IsInitialised())
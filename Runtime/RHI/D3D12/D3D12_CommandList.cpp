@@ -109,7 +109,7 @@ namespace Spartan
         return true;
     }
     
-    bool RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset)
+    bool RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset, const uint32_t instance_count)
     {
         return true;
     }
@@ -149,6 +149,11 @@ namespace Spartan
         return true;
     }
     
+    bool RHI_CommandList::SetStructuredBuffer(const uint32_t slot, const uint8_t scope, RHI_StructuredBuffer* structured_buffer) const
+    {
+        return true;
+    }
+
     void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
     {
 
@@ -0,0 +1,608 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===============================
+#include "Spartan.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_VertexBuffer.h"
+#include "../RHI_IndexBuffer.h"
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_StructuredBuffer.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_Texture.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_DescriptorSetLayoutCache.h"
+#include "../RHI_PipelineCache.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Fence.h"
+#include "../../Profiling/Profiler.h"
+#include "../../Rendering/Renderer.h"
+//==========================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    RHI_CommandList::RHI_CommandList(Context* context)
+    {
+        m_renderer                      = context->GetSubsystem<Renderer>();
+        m_profiler                      = context->GetSubsystem<Profiler>();
+        m_rhi_device                    = m_renderer->GetRhiDevice().get();
+        m_pipeline_cache                = m_renderer->GetPipelineCache();
+        m_descriptor_set_layout_cache   = m_renderer->GetDescriptorLayoutSetCache();
+        m_cmd_buffer                    = null_utility::handle();
+
+        // Sync
+        m_processed_fence       = make_shared<RHI_Fence>(m_rhi_device, "cmd_buffer_processed");
+        m_processed_semaphore   = make_shared<RHI_Semaphore>(m_rhi_device, false, "cmd_buffer_processed");
+
+        m_timestamps.fill(0);
+    }
+
+    RHI_CommandList::~RHI_CommandList() = default;
+
+    bool RHI_CommandList::Begin()
+    {
+        // If the command list is in use, wait for it
+        if (m_state == RHI_CommandListState::Submitted)
+        {
+            if (!Wait())
+            {
+                LOG_ERROR("Failed to wait");
+                return false;
+            }
+        }
+
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Idle);
+
+        m_timestamp_index   = 0;
+        m_state             = RHI_CommandListState::Recording;
+        m_flushed           = false;
+
+        return true;
+    }
+
+    bool RHI_CommandList::End()
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        m_state = RHI_CommandListState::Ended;
+        return true;
+    }
+
+    bool RHI_CommandList::Submit(RHI_Semaphore* wait_semaphore)
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Ended);
+
+        // Get signal semaphore
+        RHI_Semaphore* signal_semaphore = nullptr;
+        if (m_pipeline)
+        {
+            if (RHI_PipelineState* state = m_pipeline->GetPipelineState())
+            {
+                if (state->render_target_swapchain)
+                {
+                    // If the swapchain is not presenting, don't submit any work
+                    if (!state->render_target_swapchain->PresentEnabled())
+                    {
+                        m_state = RHI_CommandListState::Submitted;
+                        return true;
+                    }
+
+                    // Ensure the processed semaphore can be used
+                    SP_ASSERT(m_processed_semaphore->GetState() == RHI_Semaphore_State::Idle);
+
+                    // Swapchain waits for this when presenting
+                    signal_semaphore = m_processed_semaphore.get();
+                }
+            }
+        }
+
+        if (!m_rhi_device->Queue_Submit(
+            RHI_Queue_Graphics,         // queue
+            0,                          // wait flags
+            m_cmd_buffer,               // cmd buffer
+            wait_semaphore,             // wait semaphore
+            signal_semaphore,           // signal semaphore
+            m_processed_fence.get()     // signal fence
+            ))
+        {
+            LOG_ERROR("Failed to submit the command list.");
+            return false;
+        }
+
+        m_state = RHI_CommandListState::Submitted;
+        return true;
+    }
+
+    bool RHI_CommandList::Reset()
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        lock_guard<mutex> guard(m_mutex_reset);
+
+        m_state = RHI_CommandListState::Idle;
+        return true;
+    }
+
+    bool RHI_CommandList::BeginRenderPass(RHI_PipelineState& pipeline_state)
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Get pipeline
+        {
+            m_pipeline_active = false;
+
+            // Update the descriptor cache with the pipeline state
+            m_descriptor_set_layout_cache->SetPipelineState(pipeline_state);
+
+            // Get (or create) a pipeline which matches the pipeline state
+            m_pipeline = m_pipeline_cache->GetPipeline(this, pipeline_state, m_descriptor_set_layout_cache->GetCurrentDescriptorSetLayout());
+            if (!m_pipeline)
+            {
+                LOG_ERROR("Failed to acquire appropriate pipeline");
+                return false;
+            }
+
+            // Keep a local pointer for convenience
+            m_pipeline_state = &pipeline_state;
+        }
+
+        // Start profiler (if used)
+        Timeblock_Start(m_pipeline_state);
+
+        // Shader resources
+        {
+            // If the pipeline changed, resources have to be set again
+            m_vertex_buffer_id  = 0;
+            m_index_buffer_id   = 0;
+
+            // Like Vulkan, there is no persistent state so global resources have to be set
+            m_renderer->SetGlobalShaderResources(this);
+        }
+
+        return true;
+    }
+
+    bool RHI_CommandList::EndRenderPass()
+    {
+        // If there are clear values but there have been no draw calls, the render targets still have to be cleared
+        if (m_pipeline_state->HasClearValues() && !m_render_pass_active)
+        {
+            Deferred_BeginRenderPass();
+            ClearPipelineStateRenderTargets(*m_pipeline_state);
+        }
+
+        m_render_pass_active = false;
+
+        // Profiling
+        Timeblock_End(m_pipeline_state);
+
+        return true;
+    }
+
+    void RHI_CommandList::ClearPipelineStateRenderTargets(RHI_PipelineState& pipeline_state)
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::ClearRenderTarget(RHI_Texture* texture,
+        const uint32_t color_index          /*= 0*/,
+        const uint32_t depth_stencil_index  /*= 0*/,
+        const bool storage                  /*= false*/,
+        const Math::Vector4& clear_color    /*= rhi_color_load*/,
+        const float clear_depth             /*= rhi_depth_load*/,
+        const uint32_t clear_stencil        /*= rhi_stencil_load*/
+    )
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (m_render_pass_active)
+        {
+            LOG_ERROR("Must only be called outside of a render pass instance");
+            return;
+        }
+
+        if (!texture || !texture->Get_Resource_View_Srv())
+        {
+            LOG_ERROR("Texture is null.");
+            return;
+        }
+
+        // One of the required layouts for clear functions
+        texture->SetLayout(RHI_Image_Layout::Transfer_Dst_Optimal, this);
+    }
+
+    bool RHI_CommandList::Draw(const uint32_t vertex_count)
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Ensure correct state before attempting to draw
+        if (!OnDraw())
+            return false;
+
+        m_profiler->m_rhi_draw++;
+
+        return true;
+    }
+
+    bool RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset, const uint32_t instance_count)
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Ensure correct state before attempting to draw
+        if (!OnDraw())
+            return false;
+
+        m_profiler->m_rhi_draw++;
+
+        return true;
+    }
+
+    bool RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z, bool async /*= false*/)
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Ensure correct state before attempting to dispatch
+        if (!OnDraw())
+            return false;
+
+        m_profiler->m_rhi_dispatch++;
+
+        return true;
+    }
+
+    void RHI_CommandList::Blit(RHI_Texture* source, RHI_Texture* destination)
+    {
+        SP_ASSERT(source != nullptr);
+        SP_ASSERT(destination != nullptr);
+        SP_ASSERT(source->Get_Resource() != nullptr);
+        SP_ASSERT(destination->Get_Resource() != nullptr);
+        SP_ASSERT(source->GetObjectId() != destination->GetObjectId());
+        SP_ASSERT(source->GetFormat() == destination->GetFormat());
+        SP_ASSERT(source->GetWidth() == destination->GetWidth());
+        SP_ASSERT(source->GetHeight() == destination->GetHeight());
+        SP_ASSERT(source->GetArrayLength() == destination->GetArrayLength());
+        SP_ASSERT(source->GetMipCount() == destination->GetMipCount());
+
+        source->SetLayout(RHI_Image_Layout::Transfer_Src_Optimal, this);
+        destination->SetLayout(RHI_Image_Layout::Transfer_Dst_Optimal, this);
+    }
+
+    void RHI_CommandList::SetViewport(const RHI_Viewport& viewport) const
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::SetScissorRectangle(const Math::Rectangle& scissor_rectangle) const
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer, const uint64_t offset /*= 0*/)
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (m_vertex_buffer_id == buffer->GetObjectId() && m_vertex_buffer_offset == offset)
+            return;
+
+        m_profiler->m_rhi_bindings_buffer_vertex++;
+        m_vertex_buffer_id      = buffer->GetObjectId();
+        m_vertex_buffer_offset  = offset;
+    }
+
+    void RHI_CommandList::SetBufferIndex(const RHI_IndexBuffer* buffer, const uint64_t offset /*= 0*/)
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (m_index_buffer_id == buffer->GetObjectId() && m_index_buffer_offset == offset)
+            return;
+
+        m_profiler->m_rhi_bindings_buffer_index++;
+        m_index_buffer_id       = buffer->GetObjectId();
+        m_index_buffer_offset   = offset;
+    }
+
+    bool RHI_CommandList::SetConstantBuffer(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constant_buffer) const
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_set_layout_cache->GetCurrentDescriptorSetLayout())
+        {
+            LOG_WARNING("Descriptor layout not set, try setting constant buffer \"%s\" within a render pass", constant_buffer->GetObjectName().c_str());
+            return false;
+        }
+
+        // Set (will only happen if it's not already set)
+        return m_descriptor_set_layout_cache->SetConstantBuffer(slot, constant_buffer);
+    }
+
+    bool RHI_CommandList::SetStructuredBuffer(const uint32_t slot, const uint8_t scope, RHI_StructuredBuffer* structured_buffer) const
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_set_layout_cache->GetCurrentDescriptorSetLayout())
+        {
+            LOG_WARNING("Descriptor layout not set, try setting structured buffer \"%s\" within a render pass", structured_buffer->GetObjectName().c_str());
+            return false;
+        }
+
+        // Set (will only happen if it's not already set)
+        return m_descriptor_set_layout_cache->SetStructuredBuffer(slot, structured_buffer);
+    }
+
+    void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_set_layout_cache->GetCurrentDescriptorSetLayout())
+        {
+            LOG_WARNING("Descriptor layout not set, try setting sampler \"%s\" within a render pass", sampler->GetObjectName().c_str());
+            return;
+        }
+
+        // Set (will only happen if it's not already set)
+        m_descriptor_set_layout_cache->SetSampler(slot, sampler);
+    }
+
+    void RHI_CommandList::SetTexture(const uint32_t slot, RHI_Texture* texture, const int mip /*= -1*/, const bool storage /*= false*/)
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_set_layout_cache->GetCurrentDescriptorSetLayout())
+        {
+            LOG_WARNING("Descriptor layout not set, try setting texture \"%s\" within a render pass", texture->GetObjectName().c_str());
+            return;
+        }
+
+        // Null textures are allowed, and get replaced with a black texture here
+        if (!texture || !texture->Get_Resource_View_Srv())
+        {
+            texture = m_renderer->GetDefaultTextureTransparent();
+        }
+
+        // If the image has an invalid layout (can happen for a few frames during staging), replace with black
+        if (texture->GetLayout() == RHI_Image_Layout::Undefined || texture->GetLayout() == RHI_Image_Layout::Preinitialized)
+        {
+            LOG_WARNING("Can't set texture without a layout");
+            texture = m_renderer->GetDefaultTextureTransparent();
+        }
+
+        // Transition to appropriate layout (if needed)
+        {
+            RHI_Image_Layout target_layout = RHI_Image_Layout::Undefined;
+
+            if (storage)
+            {
+                if (!texture->IsStorage())
+                {
+                    LOG_ERROR("Texture %s doesn't support storage", texture->GetObjectName().c_str());
+                }
+                else
+                {
+                    // According to section 13.1 of the Vulkan spec, storage textures have to be in a general layout.
+                    // https://www.khronos.org/registry/vulkan/specs/1.1-extensions/html/vkspec.html#descriptorsets-storageimage
+                    if (texture->GetLayout() != RHI_Image_Layout::General)
+                    {
+                        target_layout = RHI_Image_Layout::General;
+                    }
+                }
+            }
+            else
+            {
+                // Color
+                if (texture->IsColorFormat() && texture->GetLayout() != RHI_Image_Layout::Shader_Read_Only_Optimal)
+                {
+                    target_layout = RHI_Image_Layout::Shader_Read_Only_Optimal;
+                }
+
+                // Depth
+                if (texture->IsDepthFormat() && texture->GetLayout() != RHI_Image_Layout::Depth_Stencil_Read_Only_Optimal)
+                {
+                    target_layout = RHI_Image_Layout::Depth_Stencil_Read_Only_Optimal;
+                }
+            }
+
+            bool transition_required = target_layout != RHI_Image_Layout::Undefined;
+
+            // Transition
+            if (transition_required && !m_render_pass_active)
+            {
+                texture->SetLayout(target_layout, this);
+            }
+            else if (transition_required && m_render_pass_active)
+            {
+                LOG_WARNING("Can't transition texture to target layout while a render pass is active");
+                texture = m_renderer->GetDefaultTextureTransparent();
+            }
+        }
+
+        // Set (will only happen if it's not already set)
+        m_descriptor_set_layout_cache->SetTexture(slot, texture, mip, storage);
+    }
+
+    bool RHI_CommandList::Timestamp_Start(void* query_disjoint /*= nullptr*/, void* query_start /*= nullptr*/)
+    {
+        return true;
+    }
+
+    bool RHI_CommandList::Timestamp_End(void* query_disjoint /*= nullptr*/, void* query_end /*= nullptr*/)
+    {
+        return true;
+    }
+
+    float RHI_CommandList::Timestamp_GetDuration(void* query_disjoint, void* query_start, void* query_end, const uint32_t pass_index)
+    {
+        return 0.0f;
+    }
+
+    uint32_t RHI_CommandList::Gpu_GetMemoryUsed(RHI_Device* rhi_device)
+    {
+        return static_cast<uint32_t>(null_utility::stats::memory() / 1024 / 1024); // MBs
+    }
+
+    bool RHI_CommandList::Gpu_QueryCreate(RHI_Device* rhi_device, void** query /*= nullptr*/, RHI_Query_Type type /*= RHI_Query_Timestamp*/)
+    {
+        // Not needed
+        return true;
+    }
+
+    void RHI_CommandList::Gpu_QueryRelease(void*& query_object)
+    {
+        // Not needed
+    }
+
+    void RHI_CommandList::ResetDescriptorCache()
+    {
+        if (m_descriptor_set_layout_cache)
+        {
+            m_descriptor_set_layout_cache->Reset();
+        }
+    }
+
+    void RHI_CommandList::Timeblock_Start(const RHI_PipelineState* pipeline_state)
+    {
+        if (!pipeline_state || !pipeline_state->pass_name)
+            return;
+
+        // Only the CPU is timed, there is no GPU
+        if (m_rhi_device->GetContextRhi()->profiler && m_profiler && pipeline_state->profile)
+        {
+            m_profiler->TimeBlockStart(pipeline_state->pass_name, TimeBlockType::Cpu, this);
+        }
+    }
+
+    void RHI_CommandList::Timeblock_End(const RHI_PipelineState* pipeline_state)
+    {
+        if (!pipeline_state || !pipeline_state->pass_name)
+            return;
+
+        if (m_rhi_device->GetContextRhi()->profiler && m_profiler && pipeline_state->profile)
+        {
+            m_profiler->TimeBlockEnd(); // cpu
+        }
+    }
+
+    bool RHI_CommandList::Deferred_BeginRenderPass()
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Validate pipeline state
+        RHI_PipelineState* pipeline_state = m_pipeline->GetPipelineState();
+        SP_ASSERT(pipeline_state != nullptr);
+        SP_ASSERT(pipeline_state->GetRenderPass() != nullptr);
+        SP_ASSERT(pipeline_state->GetFrameBuffer() != nullptr);
+
+        m_render_pass_active = true;
+
+        return true;
+    }
+
+    bool RHI_CommandList::Deferred_BindDescriptorSet()
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Same contract as Vulkan, see Vulkan_CommandList.cpp
+        RHI_DescriptorSet* descriptor_set = nullptr;
+        bool result = m_descriptor_set_layout_cache->GetDescriptorSet(descriptor_set);
+
+        if (result && descriptor_set != nullptr)
+        {
+            SP_ASSERT(descriptor_set->GetResource() != nullptr);
+            m_profiler->m_rhi_bindings_descriptor_set++;
+        }
+
+        return result;
+    }
+
+    bool RHI_CommandList::Deferred_BindPipeline()
+    {
+        if (!m_pipeline->GetPipeline())
+        {
+            LOG_ERROR("Invalid pipeline");
+            return false;
+        }
+
+        m_profiler->m_rhi_bindings_pipeline++;
+        m_pipeline_active = true;
+
+        return true;
+    }
+
+    bool RHI_CommandList::OnDraw()
+    {
+        if (m_flushed)
+            return false;
+
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Begin render pass
+        if (!m_render_pass_active && !m_pipeline_state->IsCompute())
+        {
+            if (!Deferred_BeginRenderPass())
+            {
+                LOG_ERROR("Failed to begin render pass");
+                return false;
+            }
+        }
+
+        // Set pipeline
+        if (!m_pipeline_active)
+        {
+            if (!Deferred_BindPipeline())
+            {
+                LOG_ERROR("Failed to bind pipeline");
+                return false;
+            }
+        }
+
+        // Bind descriptor set
+        return Deferred_BindDescriptorSet();
+    }
+}
@@ -0,0 +1,102 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===============================
+#include "Spartan.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_DescriptorSetLayoutCache.h"
+#include "../RHI_Shader.h"
+//==========================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_DescriptorSetLayoutCache::~RHI_DescriptorSetLayoutCache()
+    {
+        m_descriptor_pool = nullptr;
+    }
+
+    void RHI_DescriptorSetLayoutCache::Reset(uint32_t descriptor_set_capacity /*= 0*/)
+    {
+        // If the requested capacity is zero, then only recreate the descriptor pool
+        if (descriptor_set_capacity == 0)
+        {
+            descriptor_set_capacity = m_descriptor_set_capacity;
+        }
+
+        // Destroy layouts (and descriptor sets)
+        m_descriptor_set_layouts_being_cleared = true;
+        m_descriptor_set_layouts.clear();
+        m_descriptor_set_layouts_being_cleared = false;
+        m_descriptor_layout_current = nullptr;
+
+        // Destroy pool
+        m_descriptor_pool = nullptr;
+
+        // Create pool
+        CreateDescriptorPool(descriptor_set_capacity);
+
+        // Log
+        if (descriptor_set_capacity > m_descriptor_set_capacity)
+        {
+            LOG_INFO("Capacity has been increased to %d elements", descriptor_set_capacity);
+        }
+        else if (descriptor_set_capacity < m_descriptor_set_capacity)
+        {
+            LOG_INFO("Capacity has been decreased to %d elements", descriptor_set_capacity);
+        }
+        else
+        {
+            LOG_INFO("Descriptor pool has been reset");
+        }
+    }
+
+    void RHI_DescriptorSetLayoutCache::SetDescriptorSetCapacity(uint32_t descriptor_set_capacity)
+    {
+        if (!m_rhi_device || !m_rhi_device->GetContextRhi())
+        {
+            LOG_ERROR_INVALID_INTERNALS();
+            return;
+        }
+
+        if (m_descriptor_set_capacity == descriptor_set_capacity)
+        {
+            LOG_INFO("Capacity is already %d elements", m_descriptor_set_capacity);
+            return;
+        }
+
+        // Re-create descriptor pool
+        Reset(descriptor_set_capacity);
+
+        // Update capacity
+        m_descriptor_set_capacity = descriptor_set_capacity;
+    }
+
+    bool RHI_DescriptorSetLayoutCache::CreateDescriptorPool(uint32_t descriptor_set_capacity)
+    {
+        // The capacity is still tracked by the cache, so running out of descriptor sets behaves as it does with Vulkan
+        m_descriptor_pool = null_utility::handle();
+        return true;
+    }
+}
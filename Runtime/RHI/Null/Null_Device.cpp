@@ -0,0 +1,102 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Spartan.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Fence.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_Device::RHI_Device(Context* context)
+    {
+        m_context                           = context;
+        m_rhi_context                       = make_shared<RHI_Context>();
+        null_utility::globals::rhi_context  = m_rhi_context.get();
+        null_utility::globals::rhi_device   = this;
+        m_rhi_context->device               = null_utility::handle();
+
+        // A virtual adapter, the memory is only used for budgeting
+        RegisterPhysicalDevice(PhysicalDevice
+        (
+            0,                                  // api version
+            0,                                  // driver version
+            0,                                  // vendor id
+            RHI_PhysicalDevice_Cpu,             // type
+            "Null",                             // name
+            8ull * 1024 * 1024 * 1024,          // memory
+            nullptr                             // data
+        ));
+        SetPrimaryPhysicalDevice(0);
+
+        LOG_INFO("Null RHI, GPU work will be skipped");
+
+        m_initialized = true;
+    }
+
+    RHI_Device::~RHI_Device()
+    {
+        null_utility::stats::log();
+    }
+
+    bool RHI_Device::Queue_Present(void* swapchain_view, uint32_t* image_index, RHI_Semaphore* wait_semaphore /*= nullptr*/) const
+    {
+        // Validate semaphore state
+        if (wait_semaphore) SP_ASSERT(wait_semaphore->GetState() == RHI_Semaphore_State::Signaled);
+
+        // Update semaphore state
+        if (wait_semaphore)
+            wait_semaphore->SetState(RHI_Semaphore_State::Idle);
+
+        null_utility::stats::presents++;
+
+        return true;
+    }
+
+    bool RHI_Device::Queue_Submit(const RHI_Queue_Type type, const uint32_t wait_flags, void* cmd_buffer, RHI_Semaphore* wait_semaphore /*= nullptr*/, RHI_Semaphore* signal_semaphore /*= nullptr*/, RHI_Fence* signal_fence /*= nullptr*/) const
+    {
+        lock_guard<mutex> lock(m_queue_mutex);
+
+        // Validate semaphore states
+        if (wait_semaphore)     SP_ASSERT(wait_semaphore->GetState() == RHI_Semaphore_State::Signaled);
+        if (signal_semaphore)   SP_ASSERT(signal_semaphore->GetState() == RHI_Semaphore_State::Idle);
+
+        // Update semaphore states (there is no GPU, so the work completes as soon as it's submitted)
+        if (wait_semaphore)     wait_semaphore->SetState(RHI_Semaphore_State::Idle);
+        if (signal_semaphore)   signal_semaphore->SetState(RHI_Semaphore_State::Signaled);
+
+        null_utility::stats::submissions++;
+
+        return true;
+    }
+
+    bool RHI_Device::Queue_Wait(const RHI_Queue_Type type) const
+    {
+        return true;
+    }
+}
@@ -0,0 +1,104 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Spartan.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_IndexBuffer.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    void RHI_IndexBuffer::_destroy()
+    {
+        m_mapped        = nullptr;
+        m_allocation    = nullptr;
+        null_utility::buffer::destroy(m_buffer);
+    }
+
+    bool RHI_IndexBuffer::_create(const void* indices)
+    {
+        if (!m_rhi_device)
+        {
+            LOG_ERROR_INVALID_INTERNALS();
+            return false;
+        }
+
+        // Destroy previous buffer
+        _destroy();
+
+        if (!null_utility::buffer::create(m_buffer, m_object_size_gpu, indices))
+            return false;
+
+        // Static buffers would live in device local memory with Vulkan, so they are not mappable either
+        m_allocation    = m_buffer;
+        m_is_mappable   = indices == nullptr;
+
+        return true;
+    }
+
+    void* RHI_IndexBuffer::Map()
+    {
+        if (!m_is_mappable)
+        {
+            LOG_ERROR("Not mappable, can only be updated via staging");
+            return nullptr;
+        }
+
+        if (!m_allocation)
+        {
+            LOG_ERROR("Invalid allocation");
+            return nullptr;
+        }
+
+        m_mapped = m_buffer;
+
+        return m_mapped;
+    }
+
+    bool RHI_IndexBuffer::Unmap()
+    {
+        if (!m_is_mappable)
+        {
+            LOG_ERROR("Not mappable, can only be updated via staging");
+            return false;
+        }
+
+        if (!m_allocation)
+        {
+            LOG_ERROR("Invalid allocation");
+            return false;
+        }
+
+        // System memory, nothing to flush
+        if (!m_persistent_mapping)
+        {
+            m_mapped = nullptr;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,78 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "Spartan.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_Shader.h"
+#include "../RHI_DescriptorSetLayout.h"
+//=====================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_Pipeline::RHI_Pipeline(const RHI_Device* rhi_device, RHI_PipelineState& pipeline_state, RHI_DescriptorSetLayout* descriptor_set_layout)
+    {
+        m_rhi_device    = rhi_device;
+        m_state         = pipeline_state;
+
+        // Pipeline layout
+        SP_ASSERT(descriptor_set_layout->GetResource() != nullptr);
+        m_pipeline_layout = null_utility::handle();
+
+        if (pipeline_state.IsCompute())
+        {
+            SP_ASSERT(m_state.shader_compute->GetResource() != nullptr);
+        }
+        else if (pipeline_state.IsGraphics() || pipeline_state.IsDummy())
+        {
+            if (pipeline_state.IsGraphics())
+            {
+                m_state.CreateFrameBuffer(rhi_device);
+            }
+
+            if (!m_state.shader_vertex)
+            {
+                LOG_ERROR("Vertex shader is invalid");
+                return;
+            }
+        }
+
+        // Pipeline
+        m_pipeline = null_utility::handle();
+        null_utility::stats::pipelines++;
+    }
+
+    RHI_Pipeline::~RHI_Pipeline()
+    {
+        if (m_pipeline)
+        {
+            null_utility::stats::pipelines--;
+        }
+
+        m_pipeline          = nullptr;
+        m_pipeline_layout   = nullptr;
+    }
+}
@@ -0,0 +1,95 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Spartan.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Implementation.h"
+//================================
+
+namespace Spartan
+{
+    // The resource is the counter of a timeline semaphore, binary semaphores only use it as a handle
+    static void create(void*& resource)
+    {
+        SP_ASSERT(resource == nullptr);
+        resource = new std::atomic<uint64_t>(0);
+    }
+
+    static void destroy(void*& resource)
+    {
+        if (!resource)
+            return;
+
+        delete static_cast<std::atomic<uint64_t>*>(resource);
+        resource = nullptr;
+    }
+
+    RHI_Semaphore::RHI_Semaphore(RHI_Device* rhi_device, bool is_timeline /*= false*/, const char* name /*= nullptr*/)
+    {
+        m_is_timeline   = is_timeline;
+        m_rhi_device    = rhi_device;
+
+        create(m_resource);
+
+        // Name
+        if (name)
+        {
+            m_object_name = name;
+        }
+    }
+
+    RHI_Semaphore::~RHI_Semaphore()
+    {
+        destroy(m_resource);
+    }
+
+    void RHI_Semaphore::Reset()
+    {
+        destroy(m_resource);
+        create(m_resource);
+        m_state = RHI_Semaphore_State::Idle;
+    }
+
+    bool RHI_Semaphore::Wait(const uint64_t value, uint64_t timeout /*= std::numeric_limits<uint64_t>::max()*/)
+    {
+        SP_ASSERT(m_is_timeline);
+
+        // Only the CPU signals, so a value which hasn't been reached yet would never be
+        return static_cast<std::atomic<uint64_t>*>(m_resource)->load() >= value;
+    }
+
+    bool RHI_Semaphore::Signal(const uint64_t value)
+    {
+        SP_ASSERT(m_is_timeline);
+
+        static_cast<std::atomic<uint64_t>*>(m_resource)->store(value);
+
+        return true;
+    }
+
+    uint64_t RHI_Semaphore::GetValue()
+    {
+        SP_ASSERT(m_is_timeline);
+
+        return static_cast<std::atomic<uint64_t>*>(m_resource)->load();
+    }
+}
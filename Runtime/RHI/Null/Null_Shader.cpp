@@ -0,0 +1,105 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Spartan.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Shader.h"
+#include "../RHI_InputLayout.h"
+#include <regex>
+#include <set>
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_Shader::~RHI_Shader()
+    {
+        if (HasResource())
+        {
+            m_resource = nullptr;
+            null_utility::stats::shaders--;
+        }
+    }
+
+    void* RHI_Shader::Compile3()
+    {
+        // There is no compiler, the resources are reflected from the source instead
+        Reflect(m_shader_type, nullptr, 0);
+
+        // Create input layout
+        if (m_vertex_type != RHI_Vertex_Type::Unknown)
+        {
+            if (!m_input_layout->Create(m_vertex_type, nullptr))
+            {
+                LOG_ERROR("Failed to create input layout for %s", m_object_name.c_str());
+                return nullptr;
+            }
+        }
+
+        null_utility::stats::shaders++;
+
+        return null_utility::handle();
+    }
+
+    void RHI_Shader::Reflect(const RHI_Shader_Type shader_type, const uint32_t* ptr, const uint32_t size)
+    {
+        // Find every "<name> : register(<b|t|s|u><index>)" in the preprocessed source. Unlike SPIR-V reflection this
+        // doesn't strip unused resources, so a shader can end up with a few more descriptors than it would with Vulkan.
+        // A t register which is declared as a StructuredBuffer<> is a structured buffer, not a texture.
+        static const regex register_regex(R"((StructuredBuffer\s*<\s*\w+\s*>\s*)?(\w+)\s*(?:\[\s*\d*\s*\])?\s*:\s*register\s*\(\s*([btsu])(\d+)\s*\))");
+
+        set<pair<RHI_Descriptor_Type, uint32_t>> slots;
+        for (sregex_iterator it(m_source.begin(), m_source.end(), register_regex), end; it != end; ++it)
+        {
+            const bool structured   = (*it)[1].matched;
+            const string name       = (*it)[2].str();
+            const char register_    = (*it)[3].str()[0];
+            const uint32_t index    = static_cast<uint32_t>(stoul((*it)[4].str()));
+
+            // Same slot shifts as the SPIR-V compilation
+            RHI_Descriptor_Type type    = RHI_Descriptor_Type::Texture;
+            uint32_t slot               = index;
+            bool is_storage             = false;
+            if (register_ == 'b')       { type = RHI_Descriptor_Type::ConstantBuffer;   slot += rhi_shader_shift_buffer; }
+            else if (register_ == 't')  { type = structured ? RHI_Descriptor_Type::StructuredBuffer : RHI_Descriptor_Type::Texture; slot += rhi_shader_shift_texture; }
+            else if (register_ == 's')  { type = RHI_Descriptor_Type::Sampler;          slot += rhi_shader_shift_sampler; }
+            else if (register_ == 'u')  { type = RHI_Descriptor_Type::Texture;          slot += rhi_shader_shift_storage_texture; is_storage = true; }
+
+            if (!slots.emplace(type, slot).second)
+                continue;
+
+            m_descriptors.emplace_back
+            (
+                name,           // name
+                type,           // type
+                slot,           // slot
+                shader_type,    // stage
+                is_storage,     // is_storage
+                false           // is_dynamic_constant_buffer
+            );
+        }
+    }
+}
@@ -0,0 +1,199 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Spartan.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_Device.h"
+#include "../RHI_Semaphore.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    // There is no surface, the images only exist as handles which frame buffers can reference
+    static void swapchain_create
+    (
+        RHI_Device* rhi_device,
+        uint32_t buffer_count,
+        array<void*, rhi_max_render_target_count>& resource_textures,
+        array<void*, rhi_max_render_target_count>& resource_views,
+        array<std::shared_ptr<RHI_Semaphore>, rhi_max_render_target_count>& image_acquired_semaphore
+    )
+    {
+        for (uint32_t i = 0; i < buffer_count; i++)
+        {
+            resource_textures[i]        = null_utility::handle();
+            resource_views[i]           = null_utility::handle();
+            image_acquired_semaphore[i] = make_shared<RHI_Semaphore>(rhi_device, false, (string("swapchain_image_acquired_semaphore_") + to_string(i)).c_str());
+        }
+    }
+
+    static void swapchain_destroy
+    (
+        array<void*, rhi_max_render_target_count>& resource_textures,
+        array<void*, rhi_max_render_target_count>& resource_views,
+        array<std::shared_ptr<RHI_Semaphore>, rhi_max_render_target_count>& image_acquired_semaphore
+    )
+    {
+        image_acquired_semaphore.fill(nullptr);
+        resource_views.fill(nullptr);
+        resource_textures.fill(nullptr);
+    }
+
+    RHI_SwapChain::RHI_SwapChain(
+        void* window_handle,
+        const shared_ptr<RHI_Device>& rhi_device,
+        const uint32_t width,
+        const uint32_t height,
+        const RHI_Format format     /*= Format_R8G8B8A8_UNORM */,
+        const uint32_t buffer_count /*= 2 */,
+        const uint32_t flags        /*= Present_Immediate */,
+        const char* name            /*= nullptr */
+    )
+    {
+        m_object_name = name;
+
+        // Validate device
+        if (!rhi_device || !rhi_device->GetContextRhi()->device)
+        {
+            LOG_ERROR("Invalid device.");
+            return;
+        }
+
+        // Validate resolution
+        if (!RHI_Device::IsValidResolution(width, height))
+        {
+            LOG_WARNING("%dx%d is an invalid resolution", width, height);
+            return;
+        }
+
+        // Copy parameters (the window handle is allowed to be null, as there is nothing to present to)
+        m_format        = format;
+        m_rhi_device    = rhi_device.get();
+        m_buffer_count  = buffer_count;
+        m_width         = width;
+        m_height        = height;
+        m_window_handle = window_handle;
+        m_flags         = flags;
+
+        swapchain_create(m_rhi_device, m_buffer_count, m_resource, m_resource_view, m_image_acquired_semaphore);
+        m_swap_chain_view   = null_utility::handle();
+        m_initialised       = true;
+
+        AcquireNextImage();
+    }
+
+    RHI_SwapChain::~RHI_SwapChain()
+    {
+        swapchain_destroy(m_resource, m_resource_view, m_image_acquired_semaphore);
+        m_swap_chain_view = nullptr;
+    }
+
+    bool RHI_SwapChain::Resize(const uint32_t width, const uint32_t height, const bool force /*= false*/)
+    {
+        // Validate resolution
+        m_present_enabled = RHI_Device::IsValidResolution(width, height);
+        if (!m_present_enabled)
+        {
+            // Return true as when minimizing, a resolution
+            // of 0,0 can be passed in, and this is fine.
+            return true;
+        }
+
+        // Only resize if needed
+        if (!force)
+        {
+            if (m_width == width && m_height == height)
+                return true;
+        }
+
+        // Save new dimensions
+        m_width     = width;
+        m_height    = height;
+
+        // Re-create the images
+        swapchain_destroy(m_resource, m_resource_view, m_image_acquired_semaphore);
+        swapchain_create(m_rhi_device, m_buffer_count, m_resource, m_resource_view, m_image_acquired_semaphore);
+        m_swap_chain_view   = null_utility::handle();
+        m_initialised       = true;
+
+        // Generate a new ID so that the pipeline cache creates new pipelines (and frame buffers) for this swap chain
+        m_object_id = GenerateObjectId();
+
+        return m_initialised;
+    }
+
+    bool RHI_SwapChain::AcquireNextImage()
+    {
+        if (!m_present_enabled)
+            return true;
+
+        // Return if the swapchain has a single buffer and it has already been acquired
+        if (m_buffer_count == 1 && m_image_index != numeric_limits<uint32_t>::max())
+            return true;
+
+        // Get signal semaphore
+        m_semaphore_index = (m_semaphore_index + 1) % m_buffer_count;
+        RHI_Semaphore* signal_semaphore = m_image_acquired_semaphore[m_semaphore_index].get();
+
+        // Reset semaphore if it wasn't waited for
+        if (signal_semaphore->GetState() != RHI_Semaphore_State::Idle)
+        {
+            LOG_INFO("Reseting signal semaphore...");
+            signal_semaphore->Reset();
+        }
+
+        // Acquire next image, the images are simply cycled through
+        m_image_index = (m_image_index + 1) % m_buffer_count;
+
+        // Update semaphore state
+        signal_semaphore->SetState(RHI_Semaphore_State::Signaled);
+
+        return true;
+    }
+
+    bool RHI_SwapChain::Present(RHI_Semaphore* wait_semaphore)
+    {
+        // Validate swapchain state
+        SP_ASSERT(m_present_enabled);
+
+        // Present
+        if (!m_rhi_device->Queue_Present(m_swap_chain_view, &m_image_index, wait_semaphore))
+        {
+            LOG_ERROR("Failed to present");
+            return false;
+        }
+
+        // Acquire next image
+        if (!AcquireNextImage())
+        {
+            LOG_ERROR("Failed to acquire next image");
+            return false;
+        }
+
+        return true;
+    }
+}
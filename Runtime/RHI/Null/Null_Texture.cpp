@@ -0,0 +1,200 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===============================
+#include "Spartan.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Texture2D.h"
+#include "../RHI_TextureCube.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_DescriptorSetLayoutCache.h"
+#include "../../Profiling/Profiler.h"
+#include "../../Rendering/Renderer.h"
+//==========================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    // The memory which a real device would have allocated for each texture, so that it can be released on destruction
+    static unordered_map<const RHI_Texture*, uint64_t> texture_memory;
+    static mutex texture_memory_mutex;
+
+    static uint64_t compute_memory(RHI_Texture* texture)
+    {
+        uint64_t size = 0;
+        for (uint32_t mip = 0; mip < texture->GetMipCount(); mip++)
+        {
+            const uint64_t width    = max(texture->GetWidth() >> mip, 1u);
+            const uint64_t height   = max(texture->GetHeight() >> mip, 1u);
+            size += width * height * texture->GetBytesPerPixel();
+        }
+
+        return size * texture->GetArrayLength();
+    }
+
+    inline RHI_Image_Layout GetAppropriateLayout(RHI_Texture* texture)
+    {
+        RHI_Image_Layout target_layout = RHI_Image_Layout::Preinitialized;
+
+        if (texture->IsSampled() && texture->IsColorFormat())
+            target_layout = RHI_Image_Layout::Shader_Read_Only_Optimal;
+
+        if (texture->IsRenderTarget())
+            target_layout = RHI_Image_Layout::Color_Attachment_Optimal;
+
+        if (texture->IsDepthStencil())
+            target_layout = RHI_Image_Layout::Depth_Stencil_Attachment_Optimal;
+
+        if (texture->IsStorage())
+            target_layout = RHI_Image_Layout::General;
+
+        return target_layout;
+    }
+
+    void RHI_Texture::SetLayout(const RHI_Image_Layout new_layout, RHI_CommandList* command_list /*= nullptr*/)
+    {
+        // The texture is most likely still initialising
+        if (m_layout == RHI_Image_Layout::Undefined)
+            return;
+
+        if (m_layout == new_layout)
+            return;
+
+        // If a command list is provided, this is where a pipeline barrier would be inserted
+        if (command_list)
+        {
+            m_context->GetSubsystem<Profiler>()->m_rhi_pipeline_barriers++;
+        }
+
+        m_layout = new_layout;
+    }
+
+    bool RHI_Texture::CreateResourceGpu()
+    {
+        if (!m_rhi_device || !m_rhi_device->GetContextRhi()->device)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return false;
+        }
+
+        // Create image
+        m_resource = null_utility::handle();
+        {
+            const uint64_t size = compute_memory(this);
+
+            lock_guard<mutex> lock(texture_memory_mutex);
+            texture_memory[this] = size;
+            null_utility::stats::textures++;
+            null_utility::stats::memory_textures += size;
+        }
+
+        // Transition to target layout
+        m_layout = GetAppropriateLayout(this);
+
+        // Create image views
+        {
+            // Shader resource views
+            if (IsSampled())
+            {
+                m_resource_view_srv = null_utility::handle();
+
+                if (HasPerMipView())
+                {
+                    for (uint32_t i = 0; i < m_mip_count; i++)
+                    {
+                        m_resource_views_srv[i] = null_utility::handle();
+                    }
+                }
+            }
+
+            // Render target views
+            for (uint32_t i = 0; i < m_array_length; i++)
+            {
+                if (IsRenderTarget())
+                {
+                    m_resource_view_renderTarget[i] = null_utility::handle();
+                }
+
+                if (IsDepthStencil())
+                {
+                    m_resource_view_depthStencil[i] = null_utility::handle();
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void RHI_Texture::DestroyResourceGpu()
+    {
+        if (!m_rhi_device || !m_rhi_device->IsInitialised())
+        {
+            LOG_ERROR("Invalid RHI Device.");
+        }
+
+        // Make sure that no descriptor sets refer to this texture.
+        if (IsSampled())
+        {
+            if (Renderer* renderer = m_rhi_device->GetContext()->GetSubsystem<Renderer>())
+            {
+                if (RHI_DescriptorSetLayoutCache* descriptor_set_layout_cache = renderer->GetDescriptorLayoutSetCache())
+                {
+                    descriptor_set_layout_cache->RemoveTexture(this, -1);
+
+                    for (uint32_t i = 0; i < m_mip_count; i++)
+                    {
+                        descriptor_set_layout_cache->RemoveTexture(this, i);
+                    }
+                }
+            }
+        }
+
+        // De-allocate everything
+        m_data.clear();
+
+        m_resource_view_srv = nullptr;
+
+        for (uint32_t i = 0; i < m_mip_count; i++)
+        {
+            m_resource_views_srv[i] = nullptr;
+        }
+
+        m_resource_view_depthStencil.fill(nullptr);
+        m_resource_view_renderTarget.fill(nullptr);
+
+        if (m_resource)
+        {
+            lock_guard<mutex> lock(texture_memory_mutex);
+            auto it = texture_memory.find(this);
+            if (it != texture_memory.end())
+            {
+                null_utility::stats::textures--;
+                null_utility::stats::memory_textures -= it->second;
+                texture_memory.erase(it);
+            }
+        }
+        m_resource = nullptr;
+    }
+}
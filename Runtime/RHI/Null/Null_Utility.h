@@ -0,0 +1,124 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =================
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+//============================
+
+// The null backend records nothing and executes nothing, it only keeps enough state for the
+// renderer and the pipeline/descriptor caches to behave as they would with a real device.
+namespace Spartan::null_utility
+{
+    struct globals
+    {
+        static inline RHI_Device* rhi_device;
+        static inline RHI_Context* rhi_context;
+    };
+
+    // Resource counts and memory, the equivalent of what the device would have allocated
+    struct stats
+    {
+        static inline std::atomic<uint64_t> memory_buffers      = 0;
+        static inline std::atomic<uint64_t> memory_textures     = 0;
+        static inline std::atomic<uint32_t> buffers             = 0;
+        static inline std::atomic<uint32_t> textures            = 0;
+        static inline std::atomic<uint32_t> shaders             = 0;
+        static inline std::atomic<uint32_t> samplers            = 0;
+        static inline std::atomic<uint32_t> pipelines           = 0;
+        static inline std::atomic<uint32_t> descriptor_sets     = 0;
+        static inline std::atomic<uint64_t> submissions         = 0;
+        static inline std::atomic<uint64_t> presents            = 0;
+
+        static uint64_t memory() { return memory_buffers + memory_textures; }
+
+        static void log()
+        {
+            LOG_INFO("Null RHI: %u buffers, %u textures, %u shaders, %u samplers, %u pipelines, %u descriptor sets, %.2f MB, %llu submissions, %llu presents",
+                buffers.load(), textures.load(), shaders.load(), samplers.load(), pipelines.load(), descriptor_sets.load(),
+                static_cast<double>(memory()) / (1024.0 * 1024.0), static_cast<unsigned long long>(submissions.load()), static_cast<unsigned long long>(presents.load())
+            );
+        }
+    };
+
+    // Null objects have no API resource, a unique non-null value is enough to keep the caches (which hash resources) working
+    inline void* handle()
+    {
+        static std::atomic<uint64_t> id = 0;
+        return reinterpret_cast<void*>(++id);
+    }
+
+    namespace buffer
+    {
+        // Buffers are backed by system memory, so that mapping and writing them costs what it would with a real device.
+        // The size is kept in front of the allocation since the owners only know the size they are about to be (re)created with.
+        static const size_t header_size = 16;
+
+        inline bool create(void*& buffer, const uint64_t size, const void* data = nullptr)
+        {
+            if (size == 0)
+            {
+                LOG_ERROR("Can't create a buffer of zero size");
+                return false;
+            }
+
+            uint8_t* memory = static_cast<uint8_t*>(std::malloc(header_size + static_cast<size_t>(size)));
+            if (!memory)
+            {
+                LOG_ERROR("Failed to allocate %llu bytes", static_cast<unsigned long long>(size));
+                return false;
+            }
+
+            std::memcpy(memory, &size, sizeof(size));
+            buffer = memory + header_size;
+
+            if (data)
+            {
+                std::memcpy(buffer, data, static_cast<size_t>(size));
+            }
+
+            stats::buffers++;
+            stats::memory_buffers += size;
+
+            return true;
+        }
+
+        inline void destroy(void*& buffer)
+        {
+            if (!buffer)
+                return;
+
+            uint8_t* memory = static_cast<uint8_t*>(buffer) - header_size;
+            uint64_t size   = 0;
+            std::memcpy(&size, memory, sizeof(size));
+            std::free(memory);
+            buffer = nullptr;
+
+            stats::buffers--;
+            stats::memory_buffers -= size;
+        }
+    }
+}
@@ -72,7 +72,7 @@ namespace Spartan
 
         // Draw
         bool Draw(uint32_t vertex_count);
-        bool DrawIndexed(uint32_t index_count, uint32_t index_offset = 0, uint32_t vertex_offset = 0);
+        bool DrawIndexed(uint32_t index_count, uint32_t index_offset = 0, uint32_t vertex_offset = 0, uint32_t instance_count = 1);
 
         // Dispatch
         bool Dispatch(uint32_t x, uint32_t y, uint32_t z, bool async = false);
@@ -97,6 +97,10 @@ namespace Spartan
         bool SetConstantBuffer(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constant_buffer) const;
         inline bool SetConstantBuffer(const uint32_t slot, const uint8_t scope, const std::shared_ptr<RHI_ConstantBuffer>& constant_buffer) const { return SetConstantBuffer(slot, scope, constant_buffer.get()); }
         
+        // Structured buffer
+        bool SetStructuredBuffer(const uint32_t slot, const uint8_t scope, RHI_StructuredBuffer* structured_buffer) const;
+        inline bool SetStructuredBuffer(const uint32_t slot, const uint8_t scope, const std::shared_ptr<RHI_StructuredBuffer>& structured_buffer) const { return SetStructuredBuffer(slot, scope, structured_buffer.get()); }
+
         // Sampler
         void SetSampler(const uint32_t slot, RHI_Sampler* sampler) const;
         inline void SetSampler(const uint32_t slot, const std::shared_ptr<RHI_Sampler>& sampler) const { SetSampler(slot, sampler.get()); }
@@ -46,6 +46,7 @@ namespace Spartan
     class RHI_VertexBuffer;
     class RHI_IndexBuffer;
     class RHI_ConstantBuffer;
+    class RHI_StructuredBuffer;
     class RHI_Sampler;
     class RHI_Viewport;
     class RHI_Texture;
@@ -76,7 +77,8 @@ namespace Spartan
     {
         RHI_Api_D3d11,
         RHI_Api_D3d12,
-        RHI_Api_Vulkan
+        RHI_Api_Vulkan,
+        RHI_Api_Null
     };
 
     enum RHI_Present_Mode : uint32_t
@@ -240,6 +242,7 @@ namespace Spartan
         Sampler,
         Texture,
         ConstantBuffer,
+        StructuredBuffer,
         Undefined
     };
 
@@ -316,6 +319,7 @@ namespace Spartan
     static const uint8_t rhi_descriptor_max_constant_buffers_dynamic    = 10;
     static const uint8_t rhi_descriptor_max_samplers                    = 10;
     static const uint8_t rhi_descriptor_max_textures                    = 10;
+    static const uint8_t rhi_descriptor_max_structured_buffers          = 10;
     
     static const Math::Vector4  rhi_color_dont_care           = Math::Vector4(-std::numeric_limits<float>::infinity(), 0.0f, 0.0f, 0.0f);
     static const Math::Vector4  rhi_color_load                = Math::Vector4(std::numeric_limits<float>::infinity(), 0.0f, 0.0f, 0.0f);
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Spartan.h"
 #include "RHI_DescriptorSetLayout.h"
 #include "RHI_ConstantBuffer.h"
+#include "RHI_StructuredBuffer.h"
 #include "RHI_Sampler.h"
 #include "RHI_Texture.h"
 #include "RHI_DescriptorSetLayoutCache.h"
@@ -84,6 +85,26 @@ namespace Spartan
         return false;
     }
 
+    bool RHI_DescriptorSetLayout::SetStructuredBuffer(const uint32_t slot, RHI_StructuredBuffer* structured_buffer)
+    {
+        for (RHI_Descriptor& descriptor : m_descriptors)
+        {
+            // Structured buffers are t registers, so they share the texture shift
+            if (descriptor.type == RHI_Descriptor_Type::StructuredBuffer && descriptor.slot == slot + rhi_shader_shift_texture)
+            {
+                // Determine if the descriptor set needs to bind
+                m_needs_to_bind = descriptor.resource != structured_buffer->GetResource() ? true : m_needs_to_bind; // affects vkUpdateDescriptorSets
+
+                // Update
+                descriptor.resource = structured_buffer->GetResource();
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     void RHI_DescriptorSetLayout::SetSampler(const uint32_t slot, RHI_Sampler* sampler)
     {
         for (RHI_Descriptor& descriptor : m_descriptors)
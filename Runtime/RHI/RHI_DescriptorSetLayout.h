@@ -39,6 +39,7 @@ namespace Spartan
         ~RHI_DescriptorSetLayout();
 
         bool SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer);
+        bool SetStructuredBuffer(const uint32_t slot, RHI_StructuredBuffer* structured_buffer);
         void SetSampler(const uint32_t slot, RHI_Sampler* sampler);
         void SetTexture(const uint32_t slot, RHI_Texture* texture, const int mip, const bool storage);
         void RemoveTexture(RHI_Texture* texture, const int mip);
@@ -77,6 +77,12 @@ namespace Spartan
         return m_descriptor_layout_current->SetConstantBuffer(slot, constant_buffer);
     }
 
+    bool RHI_DescriptorSetLayoutCache::SetStructuredBuffer(const uint32_t slot, RHI_StructuredBuffer* structured_buffer)
+    {
+        SP_ASSERT(m_descriptor_layout_current != nullptr);
+        return m_descriptor_layout_current->SetStructuredBuffer(slot, structured_buffer);
+    }
+
     void RHI_DescriptorSetLayoutCache::SetSampler(const uint32_t slot, RHI_Sampler* sampler)
     {
         SP_ASSERT(m_descriptor_layout_current != nullptr);
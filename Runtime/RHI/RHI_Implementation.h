@@ -326,6 +326,11 @@ namespace Spartan
             ID3D12Device* device    = nullptr;
         #endif
 
+        #if defined(API_GRAPHICS_NULL)
+            RHI_Api_Type api_type   = RHI_Api_Null;
+            void* device            = nullptr;
+        #endif
+
         #if defined(API_GRAPHICS_VULKAN)
             RHI_Api_Type api_type                                   = RHI_Api_Vulkan;
             uint32_t api_version                                    = 0;
@@ -405,6 +410,8 @@ namespace Spartan
     #include "D3D12/D3D12_Utility.h"
 #elif defined (API_GRAPHICS_VULKAN)
     #include "Vulkan/Vulkan_Utility.h"
+#elif defined (API_GRAPHICS_NULL)
+    #include "Null/Null_Utility.h"
 #endif
 
 #endif // RUNTIME
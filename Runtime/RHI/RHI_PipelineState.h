@@ -97,7 +97,7 @@ namespace Spartan
         // Constant buffer slots which refer to dynamic buffers (-1 means unused)
         std::array<int, rhi_max_constant_buffer_count> dynamic_constant_buffer_slots =
         {
-            0, 1, 2, 3, 4, -1, -1, -1
+            0, 1, 2, 3, 4, 5, -1, -1
         };
 
         // Profiling
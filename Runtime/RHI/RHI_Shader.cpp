@@ -112,10 +112,11 @@ namespace Spartan
         }
         else
         {
-            m_context->GetSubsystem<Threading>()->AddTask([this]()
+            // Chain after any compilation which is still in flight, so that they don't overlap
+            m_compilation_task = m_context->GetSubsystem<Threading>()->AddTask([this]()
             {
                 Compile2();
-            });
+            }, { m_compilation_task });
         }
     }
 
@@ -174,10 +175,10 @@ namespace Spartan
     void RHI_Shader::WaitForCompilation()
     {
         // Wait
-        while (m_compilation_state == Shader_Compilation_State::Compiling)
+        if (!m_compilation_task.IsCompleted())
         {
             LOG_INFO("Waiting for shader \"%s\" to compile...", m_object_name.c_str());
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            m_context->GetSubsystem<Threading>()->Wait(m_compilation_task);
         }
         
         // Log error in case of failure
@@ -246,7 +247,7 @@ namespace Spartan
         static const char* target_profile_vs = "vs_6_6";
         static const char* target_profile_ps = "ps_6_6";
         static const char* target_profile_cs = "cs_6_6";
-        #elif defined(API_GRAPHICS_VULKAN)
+        #elif defined(API_GRAPHICS_VULKAN) || defined(API_GRAPHICS_NULL)
         static const char* target_profile_vs = "vs_6_6";
         static const char* target_profile_ps = "ps_6_6";
         static const char* target_profile_cs = "cs_6_6";
@@ -265,7 +266,7 @@ namespace Spartan
         static const char* shader_model = "5_0";
         #elif defined(API_GRAPHICS_D3D12)
         static const char* shader_model = "6_0";
-        #elif defined(API_GRAPHICS_VULKAN)
+        #elif defined(API_GRAPHICS_VULKAN) || defined(API_GRAPHICS_NULL)
         static const char* shader_model = "6_0";
         #endif
 
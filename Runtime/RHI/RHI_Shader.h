@@ -21,15 +21,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES =====================
+//= INCLUDES ======================
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include "../Core/SpartanObject.h"
+#include "../Threading/Threading.h"
 #include "RHI_Vertex.h"
 #include "RHI_Descriptor.h"
-//================================
+//=================================
 
 namespace Spartan
 {
@@ -94,6 +95,7 @@ namespace Spartan
         std::atomic<Shader_Compilation_State> m_compilation_state   = Shader_Compilation_State::Idle;
         RHI_Shader_Type m_shader_type                               = RHI_Shader_Unknown;
         RHI_Vertex_Type m_vertex_type                               = RHI_Vertex_Type::Unknown;
+        TaskHandle m_compilation_task;
 
         // API 
         void* m_resource = nullptr;
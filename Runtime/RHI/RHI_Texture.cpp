@@ -40,12 +40,13 @@ namespace Spartan
     {
         SP_ASSERT(context != nullptr);
 
-        Renderer* renderer = m_context->GetSubsystem<Renderer>();
-        SP_ASSERT(renderer != nullptr);
-
-        m_rhi_device = context->GetSubsystem<Renderer>()->GetRhiDevice();
-        SP_ASSERT(m_rhi_device != nullptr);
-        SP_ASSERT(m_rhi_device->GetContextRhi()->device != nullptr);
+        // A headless engine has no renderer, textures then only hold their data on the CPU
+        if (Renderer* renderer = m_context->GetSubsystem<Renderer>())
+        {
+            m_rhi_device = renderer->GetRhiDevice();
+            SP_ASSERT(m_rhi_device != nullptr);
+            SP_ASSERT(m_rhi_device->GetContextRhi()->device != nullptr);
+        }
     }
 
     RHI_Texture::~RHI_Texture()
@@ -53,7 +54,10 @@ namespace Spartan
         m_data.clear();
         m_data.shrink_to_fit();
 
-        DestroyResourceGpu();
+        if (m_rhi_device)
+        {
+            DestroyResourceGpu();
+        }
     }
 
     bool RHI_Texture::SaveToFile(const string& file_path)
@@ -155,7 +159,7 @@ namespace Spartan
         }
 
         // Create GPU resource
-        if (!CreateResourceGpu())
+        if (m_rhi_device && !CreateResourceGpu())
         {
             LOG_ERROR("Failed to create shader resource for \"%s\".", GetResourceFilePathNative().c_str());
             m_load_state = LoadState::Failed;
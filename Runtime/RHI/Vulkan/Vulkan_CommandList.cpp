@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI_VertexBuffer.h"
 #include "../RHI_IndexBuffer.h"
 #include "../RHI_ConstantBuffer.h"
+#include "../RHI_StructuredBuffer.h"
 #include "../RHI_Sampler.h"
 #include "../RHI_DescriptorSet.h"
 #include "../RHI_DescriptorSetLayout.h"
@@ -436,7 +437,7 @@ namespace Spartan
         return true;
     }
 
-    bool RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset)
+    bool RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset, const uint32_t instance_count)
     {
         // Validate command list state
         SP_ASSERT(m_state == RHI_CommandListState::Recording);
@@ -448,7 +449,7 @@ namespace Spartan
         vkCmdDrawIndexed(
             static_cast<VkCommandBuffer>(m_cmd_buffer), // commandBuffer
             index_count,                                // indexCount
-            1,                                          // instanceCount
+            instance_count,                             // instanceCount
             index_offset,                               // firstIndex
             vertex_offset,                              // vertexOffset
             0                                           // firstInstance
@@ -612,6 +613,21 @@ namespace Spartan
         return m_descriptor_set_layout_cache->SetConstantBuffer(slot, constant_buffer);
     }
 
+    bool RHI_CommandList::SetStructuredBuffer(const uint32_t slot, const uint8_t scope, RHI_StructuredBuffer* structured_buffer) const
+    {
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_set_layout_cache->GetCurrentDescriptorSetLayout())
+        {
+            LOG_WARNING("Descriptor layout not set, try setting structured buffer \"%s\" within a render pass", structured_buffer->GetObjectName().c_str());
+            return false;
+        }
+
+        // Set (will only happen if it's not already set)
+        return m_descriptor_set_layout_cache->SetStructuredBuffer(slot, structured_buffer);
+    }
+
     void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
     {
         // Validate command list state
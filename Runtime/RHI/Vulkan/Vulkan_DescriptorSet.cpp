@@ -100,6 +100,13 @@ namespace Spartan
                 buffer_infos[i].offset  = descriptor.offset;
                 buffer_infos[i].range   = descriptor.range;
             }
+            // Structured/Storage buffer, always bound whole
+            else if (descriptor.type == RHI_Descriptor_Type::StructuredBuffer)
+            {
+                buffer_infos[i].buffer  = static_cast<VkBuffer>(descriptor.resource);
+                buffer_infos[i].offset  = 0;
+                buffer_infos[i].range   = VK_WHOLE_SIZE;
+            }
 
             // Write descriptor set
             write_descriptor_sets[i].sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
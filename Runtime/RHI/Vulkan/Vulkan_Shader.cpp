@@ -453,6 +453,20 @@ namespace Spartan
             );
         }
 
+        // Get structured buffers
+        for (const auto& resource : resources.storage_buffers)
+        {
+            m_descriptors.emplace_back
+            (
+                resource.name,                                                  // name
+                RHI_Descriptor_Type::StructuredBuffer,                          // type
+                compiler.get_decoration(resource.id, spv::DecorationBinding),   // slot
+                shader_type,                                                    // stage
+                false,                                                          // is_storage
+                false                                                           // is_dynamic_constant_buffer
+            );
+        }
+
         // Get textures
         for (const auto& resource : resources.separate_images)
         {
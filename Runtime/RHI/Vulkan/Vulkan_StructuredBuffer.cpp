@@ -0,0 +1,136 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =======================
+#include "Spartan.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_StructuredBuffer.h"
+#include "../RHI_Device.h"
+//==================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    void RHI_StructuredBuffer::_destroy()
+    {
+        // Unlike constant buffers this doesn't wait for the GPU, the owner only re-creates
+        // or destroys a buffer which no submitted command list references anymore.
+
+        // Unmap
+        if (m_mapped)
+        {
+            vmaUnmapMemory(m_rhi_device->GetContextRhi()->allocator, static_cast<VmaAllocation>(m_allocation));
+            m_mapped = nullptr;
+        }
+
+        // Destroy
+        vulkan_utility::buffer::destroy(m_buffer);
+        m_allocation = nullptr;
+    }
+
+    RHI_StructuredBuffer::RHI_StructuredBuffer(const std::shared_ptr<RHI_Device>& rhi_device, const string& name)
+    {
+        m_rhi_device    = rhi_device;
+        m_object_name   = name;
+    }
+
+    bool RHI_StructuredBuffer::_create()
+    {
+        if (!m_rhi_device || !m_rhi_device->GetContextRhi()->device)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return false;
+        }
+
+        // Destroy previous buffer
+        _destroy();
+
+        // Create buffer (host visible and persistently mapped, the CPU writes it every frame)
+        const VkMemoryPropertyFlags flags   = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+        const bool written_frequently       = true;
+        VmaAllocation allocation = vulkan_utility::buffer::create(m_buffer, m_object_size_gpu, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, flags, written_frequently, nullptr);
+        if (!allocation)
+        {
+            LOG_ERROR("Failed to allocate buffer");
+            return false;
+        }
+
+        m_allocation = static_cast<void*>(allocation);
+
+        // Set debug name
+        vulkan_utility::debug::set_name(static_cast<VkBuffer>(m_buffer), "structured_buffer");
+
+        return true;
+    }
+
+    void* RHI_StructuredBuffer::Map()
+    {
+        if (!m_rhi_device || !m_rhi_device->GetContextRhi()->device)
+        {
+            LOG_ERROR_INVALID_INTERNALS();
+            return nullptr;
+        }
+
+        if (!m_allocation)
+        {
+            LOG_ERROR("Invalid allocation");
+            return nullptr;
+        }
+
+        if (!m_mapped)
+        {
+            if (!vulkan_utility::error::check(vmaMapMemory(m_rhi_device->GetContextRhi()->allocator, static_cast<VmaAllocation>(m_allocation), reinterpret_cast<void**>(&m_mapped))))
+            {
+                LOG_ERROR("Failed to map memory");
+                return nullptr;
+            }
+        }
+
+        return m_mapped;
+    }
+
+    bool RHI_StructuredBuffer::Unmap(const uint64_t offset /*= 0*/, const uint64_t size /*= 0*/)
+    {
+        if (!m_rhi_device || !m_rhi_device->GetContextRhi()->device)
+        {
+            LOG_ERROR_INVALID_INTERNALS();
+            return false;
+        }
+
+        if (!m_allocation)
+        {
+            LOG_ERROR("Invalid allocation");
+            return false;
+        }
+
+        // Persistently mapped, only flush what was written
+        if (!vulkan_utility::error::check(vmaFlushAllocation(m_rhi_device->GetContextRhi()->allocator, static_cast<VmaAllocation>(m_allocation), offset, size != 0 ? size : VK_WHOLE_SIZE)))
+        {
+            LOG_ERROR("Failed to flush memory");
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -1327,6 +1327,9 @@ namespace Spartan::vulkan_utility
         if (descriptor.type == RHI_Descriptor_Type::Sampler)
             return VK_DESCRIPTOR_TYPE_SAMPLER;
 
+        if (descriptor.type == RHI_Descriptor_Type::StructuredBuffer)
+            return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
         LOG_ERROR("Invalid descriptor type");
         return VK_DESCRIPTOR_TYPE_MAX_ENUM;
     }
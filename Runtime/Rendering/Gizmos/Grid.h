@@ -32,7 +32,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace Spartan
 {
     class Context;
-    class Transform;
 
     class SPARTAN_CLASS Grid
     {
@@ -40,7 +39,7 @@ namespace Spartan
         Grid(std::shared_ptr<RHI_Device> rhi_device);
         ~Grid() = default;
         
-        const Math::Matrix& ComputeWorldMatrix(Transform* camera);
+        const Math::Matrix& ComputeWorldMatrix(const Math::Vector3& camera_position);
         
         const auto& GetIndexBuffer() const  { return m_indexBuffer; }
         const auto& GetVertexBuffer() const { return m_vertexBuffer; }
@@ -55,6 +55,7 @@ namespace Spartan
         bool DrawXYZ()                      const { return m_type == TransformHandleType::Scale; }
         bool IsEditing()                    const { return m_is_editing; }
         const Entity* GetSelectedEntity()   const { return m_entity_selected.lock().get(); }
+        std::shared_ptr<Entity> GetSelectedEntityShared() const { return m_entity_selected.lock(); }
         
     private:
         bool m_is_editing = false;
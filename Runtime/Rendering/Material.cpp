@@ -40,7 +40,10 @@ namespace Spartan
 {
     Material::Material(Context* context) : IResource(context, ResourceType::Material)
     {
-        m_rhi_device = context->GetSubsystem<Renderer>()->GetRhiDevice();
+        if (Renderer* renderer = context->GetSubsystem<Renderer>())
+        {
+            m_rhi_device = renderer->GetRhiDevice();
+        }
 
         // Initialize properties
         SetProperty(Material_Roughness,             0.9f);
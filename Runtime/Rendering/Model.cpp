@@ -47,8 +47,12 @@ namespace Spartan
     Model::Model(Context* context) : IResource(context, ResourceType::Model)
     {
         m_resource_manager    = m_context->GetSubsystem<ResourceCache>();
-        m_rhi_device        = m_context->GetSubsystem<Renderer>()->GetRhiDevice();
         m_mesh                = make_unique<Mesh>();
+
+        if (Renderer* renderer = m_context->GetSubsystem<Renderer>())
+        {
+            m_rhi_device = renderer->GetRhiDevice();
+        }
     }
 
     Model::~Model()
@@ -220,6 +224,10 @@ namespace Spartan
 
     bool Model::GeometryCreateBuffers()
     {
+        // A headless engine has no renderer, the geometry then only lives on the CPU
+        if (!m_rhi_device)
+            return true;
+
         auto success = true;
 
         // Get geometry
@@ -28,8 +28,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Gizmos/TransformGizmo.h"
 #include "Font/Font.h"
 #include "../Utilities/Sampling.h"
+#include "../Utilities/Sort.h"
 #include "../Profiling/Profiler.h"
 #include "../Resource/ResourceCache.h"
+#include "../World/World.h"
 #include "../World/Entity.h"
 #include "../World/Components/Transform.h"
 #include "../World/Components/Renderable.h"
@@ -38,6 +40,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_Device.h"
 #include "../RHI/RHI_PipelineCache.h"
 #include "../RHI/RHI_ConstantBuffer.h"
+#include "../RHI/RHI_StructuredBuffer.h"
 #include "../RHI/RHI_CommandList.h"
 #include "../RHI/RHI_Texture2D.h"
 #include "../RHI/RHI_SwapChain.h"
@@ -83,9 +86,11 @@ namespace Spartan
         m_option_values[Renderer_Option_Value::Ssao_Gi]             = 1.0f;
 
         // Subscribe to events
-        SP_SUBSCRIBE_TO_EVENT(EventType::WorldResolved, SP_EVENT_HANDLER_VARIANT(OnRenderablesAcquire));
         SP_SUBSCRIBE_TO_EVENT(EventType::WorldPreClear, SP_EVENT_HANDLER(OnClear));
         SP_SUBSCRIBE_TO_EVENT(EventType::WorldLoadEnd,  SP_EVENT_HANDLER(OnWorldLoaded));
+        EventSystem::Get().Subscribe<EventWorldResolved>([this](const EventWorldResolved& event)                { OnRenderablesAcquire(event.entities); }, this);
+        EventSystem::Get().Subscribe<EventWorldEntitiesChanged>([this](const EventWorldEntitiesChanged& event)  { OnEntitiesChanged(event.entities); }, this);
+        EventSystem::Get().Subscribe<EventWorldEntitiesRemoved>([this](const EventWorldEntitiesRemoved& event)  { OnEntitiesRemoved(event.entities); }, this);
 
         m_render_thread_id = this_thread::get_id();
     }
@@ -93,11 +98,14 @@ namespace Spartan
     Renderer::~Renderer()
     {
         // Unsubscribe from events
-        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldResolved, SP_EVENT_HANDLER_VARIANT(OnRenderablesAcquire));
-        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldPreClear, SP_EVENT_HANDLER(OnClear));
-        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldLoadEnd,  SP_EVENT_HANDLER(OnWorldLoaded));
+        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldPreClear);
+        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldLoadEnd);
+        EventSystem::Get().Unsubscribe<EventWorldResolved>(this);
+        EventSystem::Get().Unsubscribe<EventWorldEntitiesChanged>(this);
+        EventSystem::Get().Unsubscribe<EventWorldEntitiesRemoved>(this);
 
         m_entities.clear();
+        m_entities_index.clear();
         m_camera = nullptr;
 
         // Log to file as the renderer is no more
@@ -124,16 +132,16 @@ namespace Spartan
         // Create descriptor set layout cache
         m_descriptor_set_layout_cache = make_shared<RHI_DescriptorSetLayoutCache>(m_rhi_device.get());
 
-        // Get window
+        // Get window (there is none when running headless, in which case a fixed resolution is rendered)
         Window* window          = m_context->GetSubsystem<Window>();
-        uint32_t window_width   = window->GetWidth();
-        uint32_t window_height  = window->GetHeight();
+        uint32_t window_width   = window ? window->GetWidth()  : m_headless_width;
+        uint32_t window_height  = window ? window->GetHeight() : m_headless_height;
 
         // Create swap chain
         {
             m_swap_chain = make_shared<RHI_SwapChain>
             (
-                window->GetHandle(),
+                window ? window->GetHandle() : nullptr,
                 m_rhi_device,
                 window_width,
                 window_height,
@@ -192,6 +200,12 @@ namespace Spartan
         return true;
     }
 
+    SubsystemInitDesc Renderer::GetInitDesc() const
+    {
+        // The device and swap chain are created on the thread which owns the window
+        return { false, { SubsystemType::id<Window>, SubsystemType::id<ResourceCache> } };
+    }
+
     weak_ptr<Spartan::Entity> Renderer::SnapTransformHandleToEntity(const shared_ptr<Entity>& entity) const
     {
         return m_transform_handle->SetSelectedEntity(entity);
@@ -213,13 +227,25 @@ namespace Spartan
             Flush();
         }
 
+        // Render the most recently captured frame, the simulation captures the next one into the other packet
+        if (const FramePacket* frame_packet = m_frame_packet_captured.exchange(nullptr))
+        {
+            m_frame_packet = frame_packet;
+
+            if (m_frame_packet_handler)
+            {
+                m_frame_packet_handler(*frame_packet);
+            }
+        }
+
         if (!m_swap_chain->PresentEnabled() || !m_is_rendering_allowed)
             return;
 
         // Resize swapchain to window size (if needed)
+        Window* window = m_context->GetSubsystem<Window>();
+        if (window)
         {
             // Passing zero dimensions will cause the swapchain to not present at all
-            Window* window  = m_context->GetSubsystem<Window>();
             uint32_t width  = static_cast<uint32_t>(window->IsMinimised() ? 0 : window->GetWidth());
             uint32_t height = static_cast<uint32_t>(window->IsMinimised() ? 0 : window->GetHeight());
 
@@ -232,6 +258,12 @@ namespace Spartan
             }
         }
 
+        // Without a window there is no editor to present the previous frame, so present it here
+        if (!window && m_cmd_current)
+        {
+            Present(m_cmd_current);
+        }
+
         // Acquire appropriate command list
         m_cmd_index     = (m_cmd_index + 1) % static_cast<uint32_t>(m_cmd_lists.size());
         m_cmd_current   = m_cmd_index < static_cast<uint32_t>(m_cmd_lists.size()) ? m_cmd_lists[m_cmd_index].get() : nullptr;
@@ -243,39 +275,41 @@ namespace Spartan
             m_buffer_frame_offset_index     = 0;
             m_buffer_light_offset_index     = 0;
             m_buffer_material_offset_index  = 0;
-
+            m_buffer_draw_offset_index      = 0;
         }
 
         // Begin
         m_cmd_current->Begin();
 
         // If there is no camera, clear to black
-        if (!m_camera)
+        if (!m_frame_packet->has_camera)
         {
             m_cmd_current->ClearRenderTarget(RENDER_TARGET(RendererRt::Frame_PostProcess).get(), 0, 0, false, Vector4(0.0f, 0.0f, 0.0f, 1.0f));
             return;
         }
 
+        const FramePacketCamera& camera = m_frame_packet->camera;
+
         // If there is not camera but no other entities to render, clear to camera's color
-        if (m_entities[Renderer_ObjectType::GeometryOpaque].empty() && m_entities[Renderer_ObjectType::GeometryTransparent].empty() && m_entities[Renderer_ObjectType::Light].empty())
+        if (m_frame_packet->geometry_opaque.empty() && m_frame_packet->geometry_transparent.empty() && m_frame_packet->lights.empty())
         {
-            m_cmd_current->ClearRenderTarget(RENDER_TARGET(RendererRt::Frame_PostProcess).get(), 0, 0, false, m_camera->GetClearColor());
+            m_cmd_current->ClearRenderTarget(RENDER_TARGET(RendererRt::Frame_PostProcess).get(), 0, 0, false, camera.clear_color);
             return;
         }
 
         // Update frame buffer
         {
-            if (m_update_ortho_proj || m_near_plane != m_camera->GetNearPlane() || m_far_plane != m_camera->GetFarPlane())
+            if (m_update_ortho_proj || m_near_plane != camera.near_plane || m_far_plane != camera.far_plane)
             {
                 m_buffer_frame_cpu.projection_ortho         = Matrix::CreateOrthographicLH(m_viewport.width, m_viewport.height, m_near_plane, m_far_plane);
                 m_buffer_frame_cpu.view_projection_ortho    = Matrix::CreateLookAtLH(Vector3(0, 0, -m_near_plane), Vector3::Forward, Vector3::Up) * m_buffer_frame_cpu.projection_ortho;
                 m_update_ortho_proj                         = false;
             }
             
-            m_near_plane                    = m_camera->GetNearPlane();
-            m_far_plane                     = m_camera->GetFarPlane();
-            m_buffer_frame_cpu.view         = m_camera->GetViewMatrix();
-            m_buffer_frame_cpu.projection   = m_camera->GetProjectionMatrix();
+            m_near_plane                    = camera.near_plane;
+            m_far_plane                     = camera.far_plane;
+            m_buffer_frame_cpu.view         = camera.view;
+            m_buffer_frame_cpu.projection   = camera.projection;
             
             // TAA - Generate jitter
             if (GetOption(Render_AntiAliasing_Taa))
@@ -300,14 +334,14 @@ namespace Spartan
             m_buffer_frame_cpu.view_projection_previous     = m_buffer_frame_cpu.view_projection;
             m_buffer_frame_cpu.view_projection              = m_buffer_frame_cpu.view * m_buffer_frame_cpu.projection;
             m_buffer_frame_cpu.view_projection_inv          = Matrix::Invert(m_buffer_frame_cpu.view_projection);
-            m_buffer_frame_cpu.view_projection_unjittered   = m_buffer_frame_cpu.view * m_camera->GetProjectionMatrix();
-            m_buffer_frame_cpu.camera_aperture              = m_camera->GetAperture();
-            m_buffer_frame_cpu.camera_shutter_speed         = m_camera->GetShutterSpeed();
-            m_buffer_frame_cpu.camera_iso                   = m_camera->GetIso();
-            m_buffer_frame_cpu.camera_near                  = m_camera->GetNearPlane();
-            m_buffer_frame_cpu.camera_far                   = m_camera->GetFarPlane();
-            m_buffer_frame_cpu.camera_position              = m_camera->GetTransform()->GetPosition();
-            m_buffer_frame_cpu.camera_direction             = m_camera->GetTransform()->GetForward();
+            m_buffer_frame_cpu.view_projection_unjittered   = m_buffer_frame_cpu.view * camera.projection;
+            m_buffer_frame_cpu.camera_aperture              = camera.aperture;
+            m_buffer_frame_cpu.camera_shutter_speed         = camera.shutter_speed;
+            m_buffer_frame_cpu.camera_iso                   = camera.iso;
+            m_buffer_frame_cpu.camera_near                  = camera.near_plane;
+            m_buffer_frame_cpu.camera_far                   = camera.far_plane;
+            m_buffer_frame_cpu.camera_position              = camera.position;
+            m_buffer_frame_cpu.camera_direction             = camera.forward;
             m_buffer_frame_cpu.resolution_output            = m_resolution_output;
             m_buffer_frame_cpu.resolution_render            = m_resolution_render;
             m_buffer_frame_cpu.taa_jitter_offset            = m_taa_jitter - m_taa_jitter_previous;
@@ -481,14 +515,11 @@ namespace Spartan
     bool Renderer::UpdateFrameBuffer(RHI_CommandList* cmd_list)
     {
         // Update directional light intensity, just grab the first one
-        for (const auto& entity : m_entities[Renderer_ObjectType::Light])
+        for (const FramePacketLight& light : m_frame_packet->lights)
         {
-            if (Light* light = entity->GetComponent<Light>())
+            if (light.type == LightType::Directional)
             {
-                if (light->GetLightType() == LightType::Directional)
-                {
-                    m_buffer_frame_cpu.directional_light_intensity = light->GetIntensity();
-                }
+                m_buffer_frame_cpu.directional_light_intensity = light.intensity;
             }
         }
 
@@ -543,14 +574,35 @@ namespace Spartan
             return false;
         }
 
+        // The buffer only moves to a new offset when its content has changed, which is what the profiler counts
+        const uint32_t offset_index = m_buffer_uber_offset_index;
         if (!update_dynamic_buffer<BufferUber>(cmd_list, m_buffer_uber_gpu.get(), m_buffer_uber_cpu, m_buffer_uber_cpu_previous, m_buffer_uber_offset_index))
             return false;
+        m_profiler->m_renderer_buffer_uber_updates += m_buffer_uber_offset_index - offset_index;
 
         // Dynamic buffers with offsets have to be rebound whenever the offset changes
         return cmd_list->SetConstantBuffer(2, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_buffer_uber_gpu);
     }
 
-    bool Renderer::UpdateLightBuffer(RHI_CommandList* cmd_list, const Light* light)
+    // Re-allocates a structured buffer with enough room for the element count (if needed), rounded up to a power of two
+    template<typename T>
+    static bool grow_structured_buffer(RHI_StructuredBuffer* buffer_gpu, const uint32_t element_count)
+    {
+        if (element_count <= buffer_gpu->GetElementCount())
+            return true;
+
+        const uint32_t new_size = Math::Helper::NextPowerOfTwo(element_count);
+        if (!buffer_gpu->Create<T>(new_size))
+        {
+            LOG_ERROR("Failed to re-allocate %s buffer with %d elements", buffer_gpu->GetObjectName().c_str(), new_size);
+            return false;
+        }
+        LOG_INFO("Increased %s buffer elements to %d, that's %d kb", buffer_gpu->GetObjectName().c_str(), new_size, (new_size * buffer_gpu->GetStride()) / 1000);
+
+        return true;
+    }
+
+    bool Renderer::UpdateInstanceBuffer(RHI_CommandList* cmd_list)
     {
         if (!cmd_list)
         {
@@ -558,35 +610,116 @@ namespace Spartan
             return false;
         }
 
-        if (!light)
+        const vector<FramePacketRenderable>& opaque         = m_frame_packet->geometry_opaque;
+        const vector<FramePacketRenderable>& transparent    = m_frame_packet->geometry_transparent;
+        const uint32_t opaque_count                         = static_cast<uint32_t>(opaque.size());
+        const uint32_t renderable_count                     = opaque_count + static_cast<uint32_t>(transparent.size());
+        const uint32_t instance_count                       = m_frame_packet->instance_count;
+        if (instance_count == 0)
+            return true;
+
+        // The buffers of the current command list, Begin() has waited for its previous submission, so they can grow without a flush
+        RHI_StructuredBuffer* instances_gpu = m_buffer_instances_gpu[m_cmd_index].get();
+        RHI_StructuredBuffer* indices_gpu   = m_buffer_instance_indices_gpu[m_cmd_index].get();
+        if (!grow_structured_buffer<BufferInstance>(instances_gpu, renderable_count) || !grow_structured_buffer<uint32_t>(indices_gpu, instance_count))
+            return false;
+
+        // Map (persistent, except for D3D11 which discards the previous content, so this is the only upload of the frame)
+        BufferInstance* instances   = static_cast<BufferInstance*>(instances_gpu->Map());
+        uint32_t* indices           = static_cast<uint32_t*>(indices_gpu->Map());
+        if (!instances || !indices)
         {
-            LOG_ERROR("Invalid light");
+            LOG_ERROR("Failed to map buffer");
             return false;
         }
 
-        for (uint32_t i = 0; i < light->GetShadowArraySize(); i++)
+        Threading* threading = m_context->GetSubsystem<Threading>();
+
+        // The current and previous transforms of every renderable, once, no matter how many views draw it
+        threading->ParallelFor(renderable_count, [instances, opaque_count, &opaque, &transparent](uint32_t start, uint32_t end)
         {
-            m_buffer_light_cpu.view_projection[i] = light->GetViewMatrix(i) * light->GetProjectionMatrix(i);
+            for (uint32_t i = start; i < end; i++)
+            {
+                const FramePacketRenderable& item   = i < opaque_count ? opaque[i] : transparent[i - opaque_count];
+                instances[i].transform              = item.transform;
+                instances[i].transform_previous     = item.transform_previous;
+            }
+        });
+
+        // Which renderable each instance of each draw list is
+        const vector<FramePacketInstanceRange>& ranges = m_frame_packet->instance_ranges;
+        threading->ParallelFor(instance_count, [indices, &ranges](uint32_t start, uint32_t end)
+        {
+            // The range which the first instance belongs to, the ranges are sorted by offset and never empty
+            auto range = upper_bound(ranges.begin(), ranges.end(), start, [](const uint32_t index, const FramePacketInstanceRange& other) { return index < other.offset; }) - 1;
+
+            for (uint32_t i = start; i < end; range++)
+            {
+                const uint32_t range_end = min(end, range->offset + range->count);
+                for (; i < range_end; i++)
+                {
+                    const FramePacketRenderable* item = range->draws[i - range->offset].item;
+                    indices[i] = static_cast<uint32_t>(item - range->renderables) + range->renderable_offset;
+                }
+            }
+        });
+
+        // Unmap
+        if (!instances_gpu->Unmap(0, renderable_count * instances_gpu->GetStride()))
+            return false;
+
+        return indices_gpu->Unmap(0, instance_count * indices_gpu->GetStride());
+    }
+
+    bool Renderer::SetInstanceBuffer(RHI_CommandList* cmd_list, const FramePacketBatch& batch)
+    {
+        // The instances were written by UpdateInstanceBuffer() at the start of the frame, only where the draw's instances start changes
+        m_buffer_draw_cpu.instance_offset = batch.instance_offset;
+        if (!update_dynamic_buffer<BufferDraw>(cmd_list, m_buffer_draw_gpu.get(), m_buffer_draw_cpu, m_buffer_draw_cpu_previous, m_buffer_draw_offset_index))
+            return false;
+
+        // Dynamic buffers with offsets have to be rebound whenever the offset changes
+        if (!cmd_list->SetConstantBuffer(5, RHI_Shader_Vertex, m_buffer_draw_gpu))
+            return false;
+
+        // Will only bind if not already bound
+        if (!cmd_list->SetStructuredBuffer(static_cast<uint32_t>(RendererBindingsSrv::instances), RHI_Shader_Vertex, m_buffer_instances_gpu[m_cmd_index]))
+            return false;
+
+        return cmd_list->SetStructuredBuffer(static_cast<uint32_t>(RendererBindingsSrv::instance_indices), RHI_Shader_Vertex, m_buffer_instance_indices_gpu[m_cmd_index]);
+    }
+
+    bool Renderer::UpdateLightBuffer(RHI_CommandList* cmd_list, const FramePacketLight& light)
+    {
+        if (!cmd_list)
+        {
+            LOG_ERROR("Invalid command list");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < light.shadow_array_size; i++)
+        {
+            m_buffer_light_cpu.view_projection[i] = light.view_projection[i];
         }
 
         // Convert luminous power to luminous intensity
-        float luminous_intensity = light->GetIntensity() * m_camera->GetExposure();
-        if (light->GetLightType() == LightType::Point)
+        float luminous_intensity = light.intensity * m_frame_packet->camera.exposure;
+        if (light.type == LightType::Point)
         {
             luminous_intensity /= Math::Helper::PI_4; // lumens to candelas
             luminous_intensity *= 255.0f; // this is a hack, must fix whats my color units
         }
-        else if (light->GetLightType() == LightType::Spot)
+        else if (light.type == LightType::Spot)
         {
             luminous_intensity /= Math::Helper::PI; // lumens to candelas
             luminous_intensity *= 255.0f; // this is a hack, must fix whats my color units
         }
 
-        m_buffer_light_cpu.intensity_range_angle_bias   = Vector4(luminous_intensity, light->GetRange(), light->GetAngle(), GetOption(Render_ReverseZ) ? light->GetBias() : -light->GetBias());
-        m_buffer_light_cpu.color                        = light->GetColor();
-        m_buffer_light_cpu.normal_bias                  = light->GetNormalBias();
-        m_buffer_light_cpu.position                     = light->GetTransform()->GetPosition();
-        m_buffer_light_cpu.direction                    = light->GetTransform()->GetForward();
+        m_buffer_light_cpu.intensity_range_angle_bias   = Vector4(luminous_intensity, light.range, light.angle, GetOption(Render_ReverseZ) ? light.bias : -light.bias);
+        m_buffer_light_cpu.color                        = light.color;
+        m_buffer_light_cpu.normal_bias                  = light.normal_bias;
+        m_buffer_light_cpu.position                     = light.position;
+        m_buffer_light_cpu.direction                    = light.forward;
 
         if (!update_dynamic_buffer<BufferLight>(cmd_list, m_buffer_light_gpu.get(), m_buffer_light_cpu, m_buffer_light_cpu_previous, m_buffer_light_offset_index))
             return false;
@@ -595,84 +728,540 @@ namespace Spartan
         return cmd_list->SetConstantBuffer(4, RHI_Shader_Pixel, m_buffer_light_gpu);
     }
 
-    void Renderer::OnRenderablesAcquire(const Variant& entities_variant)
+    void Renderer::OnRenderablesAcquire(const vector<shared_ptr<Entity>>& entities)
     {
         SCOPED_TIME_BLOCK(m_profiler);
 
+        lock_guard<mutex> lock(m_frame_packet_mutex);
+
         // Clear previous state
         m_entities.clear();
+        m_entities_index.clear();
         m_camera = nullptr;
 
-        vector<shared_ptr<Entity>> entities = entities_variant.Get<vector<shared_ptr<Entity>>>();
-        for (const auto& entity : entities)
+        for (const shared_ptr<Entity>& entity : entities)
         {
-            if (!entity || !entity->IsActive())
-                continue;
+            EntityAdd(entity.get());
+        }
 
-            // Get all the components we are interested in
-            Renderable* renderable  = entity->GetComponent<Renderable>();
-            Light* light            = entity->GetComponent<Light>();
-            Camera* camera          = entity->GetComponent<Camera>();
+        // The draw order is decided per view and per frame, when the draw lists are extracted
+        for (const Renderer_ObjectType type : { Renderer_ObjectType::GeometryOpaque, Renderer_ObjectType::GeometryTransparent })
+        {
+            vector<Entity*>& entities_of_type = m_entities[type];
 
-            if (renderable)
+            unordered_map<Entity*, uint32_t>& index = m_entities_index[type];
+            for (uint32_t i = 0; i < static_cast<uint32_t>(entities_of_type.size()); i++)
             {
-                bool is_transparent = false;
+                index[entities_of_type[i]] = i;
+            }
+        }
+    }
 
-                if (const Material* material = renderable->GetMaterial())
-                {
-                    is_transparent = material->GetColorAlbedo().w < 1.0f;
-                }
+    void Renderer::OnEntitiesChanged(const vector<Entity*>& entities)
+    {
+        SCOPED_TIME_BLOCK(m_profiler);
 
-                m_entities[is_transparent ? Renderer_ObjectType::GeometryTransparent : Renderer_ObjectType::GeometryOpaque].emplace_back(entity.get());
-            }
+        lock_guard<mutex> lock(m_frame_packet_mutex);
+
+        // Re-classify, an entity might have gained or lost components, or changed its active state
+        for (Entity* entity : entities)
+        {
+            EntityRemove(entity);
+            EntityAdd(entity);
+        }
+    }
+
+    void Renderer::OnEntitiesRemoved(const vector<shared_ptr<Entity>>& entities)
+    {
+        SCOPED_TIME_BLOCK(m_profiler);
+
+        lock_guard<mutex> lock(m_frame_packet_mutex);
+
+        for (const shared_ptr<Entity>& entity : entities)
+        {
+            EntityRemove(entity.get());
+        }
+    }
+
+    void Renderer::EntityAdd(Entity* entity)
+    {
+        if (!entity || !entity->IsActive())
+            return;
+
+        auto add = [this, entity](const Renderer_ObjectType type)
+        {
+            vector<Entity*>& entities = m_entities[type];
+            m_entities_index[type][entity] = static_cast<uint32_t>(entities.size());
+            entities.emplace_back(entity);
+        };
+
+        // Get all the components we are interested in
+        Renderable* renderable  = entity->GetComponent<Renderable>();
+        Light* light            = entity->GetComponent<Light>();
+        Camera* camera          = entity->GetComponent<Camera>();
+
+        if (renderable)
+        {
+            bool is_transparent = false;
 
-            if (light)
+            if (const Material* material = renderable->GetMaterial())
             {
-                m_entities[Renderer_ObjectType::Light].emplace_back(entity.get());
+                is_transparent = material->GetColorAlbedo().w < 1.0f;
             }
 
-            if (camera)
+            add(is_transparent ? Renderer_ObjectType::GeometryTransparent : Renderer_ObjectType::GeometryOpaque);
+        }
+
+        if (light)
+        {
+            add(Renderer_ObjectType::Light);
+        }
+
+        if (camera)
+        {
+            add(Renderer_ObjectType::Camera);
+            m_camera = camera->GetPtrShared<Camera>();
+        }
+    }
+
+    void Renderer::EntityRemove(Entity* entity)
+    {
+        for (auto& [type, index] : m_entities_index)
+        {
+            auto it = index.find(entity);
+            if (it == index.end())
+                continue;
+
+            // Swap with the last entity and pop, O(1)
+            vector<Entity*>& entities   = m_entities[type];
+            const uint32_t i            = it->second;
+            if (i != static_cast<uint32_t>(entities.size()) - 1)
             {
-                m_entities[Renderer_ObjectType::Camera].emplace_back(entity.get());
-                m_camera = camera->GetPtrShared<Camera>();
+                entities[i]         = entities.back();
+                index[entities[i]]  = i;
             }
+            entities.pop_back();
+            index.erase(it);
         }
 
-        RenderablesSort(&m_entities[Renderer_ObjectType::GeometryOpaque]);
-        RenderablesSort(&m_entities[Renderer_ObjectType::GeometryTransparent]);
+        // Fall back to any other camera
+        if (m_camera && m_camera->GetEntity() == entity)
+        {
+            const vector<Entity*>& cameras = m_entities[Renderer_ObjectType::Camera];
+            m_camera = cameras.empty() ? nullptr : cameras.back()->GetComponent<Camera>()->GetPtrShared<Camera>();
+        }
     }
 
     void Renderer::OnClear()
     {
         // Flush to remove references to entity resources that will be deallocated
         Flush();
+
+        lock_guard<mutex> lock(m_frame_packet_mutex);
         m_entities.clear();
+        m_entities_index.clear();
+        m_camera = nullptr;
     }
 
-    void Renderer::OnWorldLoaded()
+    void Renderer::CaptureFramePacket()
     {
-        m_is_rendering_allowed = true;
+        SCOPED_TIME_BLOCK(m_profiler);
+
+        lock_guard<mutex> lock(m_frame_packet_mutex);
+
+        // Capture into the packet which is not being rendered
+        FramePacket& packet             = m_frame_packets[m_frame_packet_index_capture];
+        m_frame_packet_index_capture    = (m_frame_packet_index_capture + 1) % static_cast<uint32_t>(m_frame_packets.size());
+        packet.Clear();
+
+        if (m_is_rendering_allowed)
+        {
+            // The simulation advances in fixed steps, everything is captured in between the last step and the next one
+            const float alpha = m_context->GetFixedStepAlpha(TickType::Simulation);
+
+            // Camera, it ticks every frame so it is captured as is
+            if (m_camera)
+            {
+                const Matrix& matrix        = m_camera->GetTransform()->GetMatrix();
+                const Quaternion rotation   = matrix.GetRotation();
+                packet.has_camera           = true;
+                packet.camera.position      = matrix.GetTranslation();
+                packet.camera.forward       = rotation * Vector3::Forward;
+                packet.camera.view          = Matrix::CreateLookAtLH(packet.camera.position, packet.camera.position + packet.camera.forward, rotation * Vector3::Up);
+                packet.camera.projection    = m_camera->GetProjectionMatrix();
+                packet.camera.frustum       = Frustum(packet.camera.view, packet.camera.projection, GetOption(Render_ReverseZ) ? m_camera->GetNearPlane() : m_camera->GetFarPlane());
+                packet.camera.clear_color   = m_camera->GetClearColor();
+                packet.camera.near_plane    = m_camera->GetNearPlane();
+                packet.camera.far_plane     = m_camera->GetFarPlane();
+                packet.camera.aperture      = m_camera->GetAperture();
+                packet.camera.shutter_speed = m_camera->GetShutterSpeed();
+                packet.camera.iso           = m_camera->GetIso();
+                packet.camera.exposure      = m_camera->GetExposure();
+                m_lines_rectangle_z         = packet.camera.position.z + packet.camera.near_plane + 5.0f;
+            }
+
+            // Editor state, the transform handle can move the selected entity so it ticks before anything else is captured
+            packet.selected = m_transform_handle->GetSelectedEntityShared();
+            if (GetOption(Render_Debug_Transform) && m_transform_handle->Tick(m_camera.get(), m_gizmo_transform_size, m_gizmo_transform_speed))
+            {
+                const TransformHandle* handle                   = m_transform_handle->GetHandle();
+                packet.has_transform_handle                     = true;
+                packet.transform_handle.vertex_buffer           = m_transform_handle->GetVertexBuffer();
+                packet.transform_handle.index_buffer            = m_transform_handle->GetIndexBuffer();
+                packet.transform_handle.index_count             = m_transform_handle->GetIndexCount();
+                packet.transform_handle.draw_xyz                = m_transform_handle->DrawXYZ();
+
+                const array<Vector3, 4> axes = { Vector3::Right, Vector3::Up, Vector3::Forward, Vector3::One };
+                for (uint32_t i = 0; i < static_cast<uint32_t>(axes.size()); i++)
+                {
+                    packet.transform_handle.transforms[i]   = handle->GetTransform(axes[i]);
+                    packet.transform_handle.colors[i]       = handle->GetColor(axes[i]);
+                }
+            }
+
+            if (GetOption(Render_Debug_PickingRay) && m_camera)
+            {
+                const Ray& ray                  = m_camera->GetPickingRay();
+                packet.has_picking_ray          = true;
+                packet.picking_ray_start        = ray.GetStart();
+                packet.picking_ray_end          = ray.GetStart() + ray.GetDirection() * m_camera->GetFarPlane();
+            }
+
+            // Geometry
+            auto capture_draw = [](Renderable* renderable, FramePacketRenderable& item)
+            {
+                item.renderable     = renderable;
+                item.cast_shadows   = renderable->GetCastShadows();
+                item.draw           = FramePacketDraw();
+
+                // Only renderables with geometry which has been uploaded can be drawn
+                const Model* model = renderable->GeometryModel();
+                if (model && model->GetVertexBuffer() && model->GetIndexBuffer())
+                {
+                    item.draw.vertex_buffer = model->GetVertexBuffer();
+                    item.draw.index_buffer  = model->GetIndexBuffer();
+                    item.draw.material      = renderable->GetMaterial();
+                    item.draw.geometry_id   = model->GetObjectId();
+                    item.draw.index_count   = renderable->GeometryIndexCount();
+                    item.draw.index_offset  = renderable->GeometryIndexOffset();
+                    item.draw.vertex_offset = renderable->GeometryVertexOffset();
+                }
+            };
+
+            auto capture_renderables = [alpha, &capture_draw](const vector<Entity*>& entities, vector<FramePacketRenderable>& renderables, BoundingBoxArray& bounds)
+            {
+                renderables.reserve(entities.size());
+                bounds.Reserve(static_cast<uint32_t>(entities.size()));
+
+                for (Entity* entity : entities)
+                {
+                    Renderable* renderable = entity->GetRenderable();
+                    Transform* transform   = entity->GetTransform();
+                    if (!renderable || !transform)
+                        continue;
+
+                    FramePacketRenderable& item = renderables.emplace_back();
+                    item.entity                 = entity->GetPtrShared();
+                    item.transform              = transform->GetMatrixInterpolated(alpha);
+                    item.transform_previous     = transform->GetMatrixPrevious();
+                    item.aabb                   = renderable->GetAabb();
+                    capture_draw(renderable, item);
+                    bounds.Add(item.aabb);
+
+                    // Save matrix for velocity computation
+                    transform->SetWvpLastFrame(item.transform);
+                }
+            };
+            capture_renderables(m_entities[Renderer_ObjectType::GeometryOpaque],      packet.geometry_opaque,      packet.bounds_opaque);
+            capture_renderables(m_entities[Renderer_ObjectType::GeometryTransparent], packet.geometry_transparent, packet.bounds_transparent);
+
+            // Selection outline
+            if (GetOption(Render_Debug_SelectionOutline))
+            {
+                if (Entity* entity = packet.selected.get())
+                {
+                    Renderable* renderable = entity->GetRenderable();
+                    Transform* transform   = entity->GetTransform();
+                    if (renderable && transform)
+                    {
+                        packet.has_outline          = true;
+                        packet.outline.entity       = packet.selected;
+                        packet.outline.transform    = transform->GetMatrixInterpolated(alpha);
+                        capture_draw(renderable, packet.outline);
+                        packet.outline.draw.item    = &packet.outline;
+                    }
+                }
+            }
+
+            // Lights
+            const vector<Entity*>& lights = m_entities[Renderer_ObjectType::Light];
+            if (m_shadow_maps_dirty.exchange(false))
+            {
+                for (Entity* entity : lights)
+                {
+                    Light* light = entity->GetComponent<Light>();
+                    if (light && light->GetShadowsEnabled())
+                    {
+                        light->CreateShadowMap();
+                    }
+                }
+            }
+
+            packet.lights.reserve(lights.size());
+            for (Entity* entity : lights)
+            {
+                const Light* light = entity->GetComponent<Light>();
+                if (!light)
+                    continue;
+
+                const Matrix matrix             = entity->GetTransform()->GetMatrixInterpolated(alpha);
+                const Quaternion rotation       = matrix.GetRotation();
+                const ShadowMap& shadow_map     = light->GetShadowMap();
+                FramePacketLight& item          = packet.lights.emplace_back();
+                item.entity                     = entity->GetPtrShared();
+                item.type                       = light->GetLightType();
+                item.color                      = light->GetColor();
+                item.intensity                  = light->GetIntensity();
+                item.range                      = light->GetRange();
+                item.angle                      = light->GetAngle();
+                item.bias                       = light->GetBias();
+                item.normal_bias                = light->GetNormalBias();
+                item.shadows                    = light->GetShadowsEnabled();
+                item.shadows_screen_space       = light->GetShadowsScreenSpaceEnabled();
+                item.shadows_transparent        = light->GetShadowsTransparentEnabled();
+                item.volumetric                 = light->GetVolumetricEnabled();
+                item.position                   = matrix.GetTranslation();
+                item.forward                    = rotation * Vector3::Forward;
+                item.up                         = rotation * Vector3::Up;
+                item.right                      = rotation * Vector3::Right;
+                item.texture_depth              = shadow_map.texture_depth;
+                item.texture_color              = shadow_map.texture_color;
+                item.shadow_array_size          = Helper::Min(light->GetShadowArraySize(), static_cast<uint32_t>(item.view_projection.size()));
+
+                for (uint32_t i = 0; i < item.shadow_array_size; i++)
+                {
+                    item.view_projection[i] = light->GetViewMatrix(i) * light->GetProjectionMatrix(i);
+                    item.frustums[i]        = i < shadow_map.slices.size() ? shadow_map.slices[i].frustum : Frustum();
+                }
+            }
+
+            // Light icons, projected with the camera which the frame is captured with
+            if (GetOption(Render_Debug_Lights) && m_camera)
+            {
+                for (const FramePacketLight& light : packet.lights)
+                {
+                    // Only the ones in front of the camera
+                    const Vector3 direction_camera_to_light = (light.position - packet.camera.position).Normalized();
+                    if (Vector3::Dot(packet.camera.forward, direction_camera_to_light) <= 0.5f)
+                        continue;
+
+                    // Scale based on the distance from the camera
+                    const float distance    = (packet.camera.position - light.position).Length() + Helper::EPSILON;
+                    FramePacketIcon& icon   = packet.icons.emplace_back();
+                    icon.type               = light.type;
+                    icon.position_screen    = m_camera->Project(light.position);
+                    icon.scale              = Helper::Clamp(m_gizmo_size_max / distance, m_gizmo_size_min, m_gizmo_size_max);
+                }
+            }
+
+            ExtractDrawLists(packet);
+        }
+
+        // Hand it over, the renderer picks it up at the start of its next tick
+        m_frame_packet_captured = &packet;
     }
 
-    void Renderer::RenderablesSort(vector<Entity*>* renderables)
+    // Maps a float to an unsigned integer which sorts in the same order, keeping the most significant bits
+    static uint64_t quantise_depth(const float depth, const uint32_t bit_count)
     {
-        if (!m_camera || renderables->size() <= 2)
-            return;
+        uint32_t bits = 0;
+        memcpy(&bits, &depth, sizeof(bits));
+        bits = (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+        return bits >> (32 - bit_count);
+    }
+
+    template<typename View>
+    static uint64_t get_sort_key(const View& view, const FramePacketDraw& draw, const bool transparent)
+    {
+        const Vector3 offset    = draw.item->aabb.GetCenter() - view.position;
+        const float depth       = view.radial ? offset.LengthSquared() : offset.Dot(view.forward);
+        const uint64_t material = draw.material ? (draw.material->GetObjectId() & 0xFFFF) : 0;
+        // The model in the high bits and a hash of the sub-mesh in the low bits, so instances of the same sub-mesh end up adjacent
+        const uint64_t geometry = ((draw.geometry_id & 0xFFF) << 4) | (((draw.index_offset ^ draw.vertex_offset) * 2654435761u) >> 28);
+
+        if (view.shadows)
+        {
+            return transparent ?
+                (material << 48) | (geometry << 32) | quantise_depth(depth, 32) :
+                (geometry << 48) | quantise_depth(depth, 32);
+        }
+
+        if (transparent)
+            return (quantise_depth(-depth, 32) << 32) | (material << 16) | geometry;
+
+        const uint64_t variation = draw.material ? (draw.material->GetFlags() & 0x3FFF) : 0;
+        return (variation << FramePacketDraw::sort_key_variation_shift) | (material << 34) | (geometry << 18) | quantise_depth(depth, 18);
+    }
+
+    // Orders the draws by their sort keys, the scratch memory is kept per thread
+    static void sort_draws(vector<FramePacketDraw>& draws)
+    {
+        static thread_local vector<Utility::Sort::SortItem> items;
+        static thread_local vector<Utility::Sort::SortItem> items_scratch;
+        static thread_local vector<FramePacketDraw> draws_sorted;
+
+        items.resize(draws.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(draws.size()); i++)
+        {
+            items[i] = { draws[i].sort_key, i };
+        }
+
+        Utility::Sort::RadixSort(items, items_scratch);
+
+        draws_sorted.clear();
+        for (const Utility::Sort::SortItem& item : items)
+        {
+            draws_sorted.push_back(draws[item.index]);
+        }
+
+        draws.swap(draws_sorted);
+    }
+
+    // Splits sorted draws into runs which can be issued as single instanced draws
+    static void batch_draws(const vector<FramePacketDraw>& draws, vector<FramePacketBatch>& batches, const bool compare_material, const bool instancing)
+    {
+        batches.clear();
+
+        for (uint32_t start = 0; start < static_cast<uint32_t>(draws.size());)
+        {
+            uint32_t end = start + 1;
+            while (instancing && end < static_cast<uint32_t>(draws.size()) && draws[end].CanInstance(draws[start], compare_material))
+            {
+                end++;
+            }
+
+            batches.push_back({ start, end - start, 0 });
+            start = end;
+        }
+    }
+
+    void Renderer::ExtractDrawLists(FramePacket& packet)
+    {
+        // Every view which renders geometry (the camera and each shadow map slice)
+        struct View
+        {
+            const Frustum* frustum          = nullptr;
+            FramePacketDrawList* draws      = nullptr;
+            bool shadows                    = false; // only shadow casters with a material are drawn
+            bool transparent                = false; // transparent geometry is drawn too
+            bool ignore_depth_planes        = false;
+            Vector3 position                = Vector3::Zero;
+            Vector3 forward                 = Vector3::Forward;
+            bool radial                     = false; // depth is the distance from the position, not along the forward axis
+        };
+
+        vector<View> views;
+        views.reserve(packet.lights.size() * 6 + 1);
+
+        if (packet.has_camera)
+        {
+            views.push_back({ &packet.camera.frustum, &packet.camera.draws, false, true, false, packet.camera.position, packet.camera.forward, false });
+        }
+
+        for (FramePacketLight& light : packet.lights)
+        {
+            if (!light.shadows || light.intensity == 0.0f)
+                continue;
+
+            // Directional lights must not reject shadow casters which are behind the near plane of a cascade (they are pancaked onto it)
+            const bool ignore_depth_planes = light.type == LightType::Directional;
+
+            for (uint32_t i = 0; i < light.shadow_array_size; i++)
+            {
+                views.push_back({ &light.frustums[i], &light.draws[i], true, light.shadows_transparent, ignore_depth_planes, light.position, light.forward, light.type == LightType::Point });
+            }
+        }
 
-        auto comparison_op = [this](Entity* entity)
+        const bool instancing = !GetOption(Render_Debug_NoInstancing);
+
+        // Walks the visible renderables, appends the ones the view can draw, sorts and batches them
+        auto extract = [instancing](const View& view, const BoundingBoxArray& bounds, const vector<FramePacketRenderable>& renderables, vector<uint64_t>& visible, vector<FramePacketDraw>& draws, vector<FramePacketBatch>& batches, const bool transparent)
         {
-            auto renderable = entity->GetRenderable();
-            if (!renderable)
-                return 0.0f;
+            draws.clear();
+            view.frustum->IsVisible(bounds, visible, view.ignore_depth_planes);
+
+            for (uint32_t word = 0; word < static_cast<uint32_t>(visible.size()); word++)
+            {
+                for (uint64_t bits = visible[word]; bits != 0; bits &= bits - 1)
+                {
+                    const FramePacketRenderable& item = renderables[(word << 6) + Helper::CountTrailingZeros(bits)];
+
+                    if (!item.draw.vertex_buffer)
+                        continue;
+
+                    if (view.shadows && (!item.cast_shadows || !item.draw.material))
+                        continue;
+
+                    FramePacketDraw& draw   = draws.emplace_back(item.draw);
+                    draw.item               = &item;
+                    draw.sort_key           = get_sort_key(view, draw, transparent);
+                }
+            }
+
+            sort_draws(draws);
 
-            return (renderable->GetAabb().GetCenter() - m_camera->GetTransform()->GetPosition()).LengthSquared();
+            // Only opaque shadows don't bind a material
+            batch_draws(draws, batches, !view.shadows || transparent, instancing);
         };
 
-        // Sort by depth (front to back)
-        sort(renderables->begin(), renderables->end(), [&comparison_op](Entity* a, Entity* b)
+        // The views are independent, so they are extracted in parallel
+        m_context->GetSubsystem<Threading>()->ParallelFor(static_cast<uint32_t>(views.size()), [&views, &packet, &extract](uint32_t start, uint32_t end)
         {
-            return comparison_op(a) < comparison_op(b);
-        });
+            for (uint32_t i = start; i < end; i++)
+            {
+                const View& view = views[i];
+
+                extract(view, packet.bounds_opaque, packet.geometry_opaque, view.draws->visible_opaque, view.draws->geometry_opaque, view.draws->batches_opaque, false);
+
+                if (view.transparent)
+                {
+                    extract(view, packet.bounds_transparent, packet.geometry_transparent, view.draws->visible_transparent, view.draws->geometry_transparent, view.draws->batches_transparent, true);
+                }
+                else
+                {
+                    view.draws->geometry_transparent.clear();
+                    view.draws->batches_transparent.clear();
+                }
+            }
+        }, 1);
+
+        // Lay the draws of every view out back to back in the frame's instance index buffer, so a batch starts where its first draw is
+        packet.instance_ranges.clear();
+        packet.instance_count = 0;
+        for (const View& view : views)
+        {
+            for (const bool transparent : { false, true })
+            {
+                const vector<FramePacketDraw>& draws = view.draws->Get(transparent);
+                if (draws.empty())
+                    continue;
+
+                for (FramePacketBatch& batch : transparent ? view.draws->batches_transparent : view.draws->batches_opaque)
+                {
+                    batch.instance_offset = packet.instance_count + batch.draw_index;
+                }
+
+                const vector<FramePacketRenderable>& renderables    = transparent ? packet.geometry_transparent : packet.geometry_opaque;
+                const uint32_t renderable_offset                    = transparent ? static_cast<uint32_t>(packet.geometry_opaque.size()) : 0;
+                packet.instance_ranges.push_back({ draws.data(), static_cast<uint32_t>(draws.size()), packet.instance_count, renderables.data(), renderable_offset });
+                packet.instance_count += static_cast<uint32_t>(draws.size());
+            }
+        }
+    }
+
+    void Renderer::OnWorldLoaded()
+    {
+        m_is_rendering_allowed = true;
     }
 
     const shared_ptr<Spartan::RHI_Texture>& Renderer::GetEnvironmentTexture()
@@ -719,18 +1308,10 @@ namespace Spartan
 
         m_option_values[option] = value;
 
-        // Shadow resolution handling
+        // Shadow resolution handling, the lights belong to the simulation so their shadow maps are re-created when it captures a frame
         if (option == Renderer_Option_Value::ShadowResolution)
         {
-            const auto& light_entities = m_entities[Renderer_ObjectType::Light];
-            for (const auto& light_entity : light_entities)
-            {
-                auto light = light_entity->GetComponent<Light>();
-                if (light->GetShadowsEnabled())
-                {
-                    light->CreateShadowMap();
-                }
-            }
+            m_shadow_maps_dirty = true;
         }
 
         if (option == Renderer_Option_Value::Taa_AllowUpsampling)
@@ -764,18 +1345,24 @@ namespace Spartan
     void Renderer::Flush()
     {
         // External thread request a flush from the renderer thread (to avoid a myriad of thread issues and Vulkan errors)
-        bool flushing_from_different_thread = m_render_thread_id != this_thread::get_id();
+        bool flushing_from_different_thread = m_render_thread_id.load() != this_thread::get_id();
         if (flushing_from_different_thread)
         {
-            m_is_rendering_allowed  = false;
-            m_flush_requested       = true;
+            {
+                lock_guard<mutex> lock(m_flush_mutex);
+                m_is_rendering_allowed  = false;
+                m_flush_requested       = true;
+            }
 
-            while (m_flush_requested)
+            if (m_flush_request_handler)
             {
-                LOG_INFO("External thread is waiting for the renderer thread to flush...");
-                this_thread::sleep_for(chrono::milliseconds(16));
+                m_flush_request_handler();
             }
 
+            LOG_INFO("External thread is waiting for the renderer thread to flush...");
+            unique_lock<mutex> lock(m_flush_mutex);
+            m_flush_condition.wait(lock, [this]() { return !m_flush_requested; });
+
             return;
         }
 
@@ -800,7 +1387,11 @@ namespace Spartan
             }
         }
 
-        m_flush_requested = false;
+        {
+            lock_guard<mutex> lock(m_flush_mutex);
+            m_flush_requested = false;
+        }
+        m_flush_condition.notify_all();
     }
 
     uint32_t Renderer::GetMaxResolution() const
@@ -25,8 +25,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <unordered_map>
 #include <array>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 #include "Renderer_ConstantBuffers.h"
 #include "Renderer_Enums.h"
+#include "Renderer_FramePacket.h"
 #include "Material.h"
 #include "../Core/ISubsystem.h"
 #include "../Math/Rectangle.h"
@@ -43,7 +47,6 @@ namespace Spartan
     class Light;
     class ResourceCache;
     class Font;
-    class Variant;
     class Grid;
     class TransformGizmo;
     class Profiler;
@@ -75,6 +78,7 @@ namespace Spartan
 
         //= ISubsystem ======================
         bool OnInitialise() override;
+        SubsystemInitDesc GetInitDesc() const override;
         void OnTick(float delta_time) override;
         //===================================
 
@@ -142,6 +146,15 @@ namespace Spartan
 
         // Rendering
         bool IsRenderingAllowed() const { return m_is_rendering_allowed; }
+        bool IsFlushRequested()   const { return m_flush_requested; }
+        void SetRenderThread(const std::thread::id thread_id) { m_render_thread_id = thread_id; }
+        void SetFlushRequestHandler(std::function<void()>&& handler) { m_flush_request_handler = std::move(handler); } // wakes the render thread
+
+        // Captures the world state which the next frame renders, called once the simulation of a frame has finished
+        void CaptureFramePacket();
+
+        // Called on the render thread with every packet it picks up, before it is rendered, for tests which inspect what was captured
+        void SetFramePacketHandler(std::function<void(const FramePacket&)>&& handler) { m_frame_packet_handler = std::move(handler); }
 
         // Misc
         const std::shared_ptr<RHI_Device>& GetRhiDevice()           const { return m_rhi_device; }
@@ -211,13 +224,19 @@ namespace Spartan
         bool UpdateFrameBuffer(RHI_CommandList* cmd_list);
         bool UpdateMaterialBuffer(RHI_CommandList* cmd_list);
         bool UpdateUberBuffer(RHI_CommandList* cmd_list);
-        bool UpdateLightBuffer(RHI_CommandList* cmd_list, const Light* light);
+        bool UpdateLightBuffer(RHI_CommandList* cmd_list, const FramePacketLight& light);
+        bool UpdateInstanceBuffer(RHI_CommandList* cmd_list);
+        bool SetInstanceBuffer(RHI_CommandList* cmd_list, const FramePacketBatch& batch);
 
         // Event handlers
-        void OnRenderablesAcquire(const Variant& renderables);
+        void OnRenderablesAcquire(const std::vector<std::shared_ptr<Entity>>& entities);
+        void OnEntitiesChanged(const std::vector<Entity*>& entities);
+        void OnEntitiesRemoved(const std::vector<std::shared_ptr<Entity>>& entities);
         void OnClear();
         void OnWorldLoaded();
-        void RenderablesSort(std::vector<Entity*>* renderables);
+        void ExtractDrawLists(FramePacket& packet);
+        void EntityAdd(Entity* entity);
+        void EntityRemove(Entity* entity);
 
         // Render targets
         std::array<std::shared_ptr<RHI_Texture>, 26> m_render_targets;
@@ -269,6 +288,8 @@ namespace Spartan
         std::vector<RHI_Vertex_PosCol> m_lines_depth_enabled;
         std::vector<float> m_lines_depth_disabled_duration;
         std::vector<float> m_lines_depth_enabled_duration;
+        std::mutex m_lines_mutex; // lines can be added by the simulation while a frame renders
+        std::atomic<float> m_lines_rectangle_z = 0.0f; // in front of the camera, as of the last captured frame
 
         // Gizmos
         std::unique_ptr<TransformGizmo> m_transform_handle;
@@ -299,8 +320,11 @@ namespace Spartan
         bool m_update_ortho_proj                    = true;
         std::atomic<bool> m_is_rendering_allowed    = true;
         std::atomic<bool> m_flush_requested         = false;
+        std::mutex m_flush_mutex;
+        std::condition_variable m_flush_condition;
+        std::function<void()> m_flush_request_handler;
         uint32_t m_cmd_index                        = std::numeric_limits<uint32_t>::max();
-        std::thread::id m_render_thread_id;
+        std::atomic<std::thread::id> m_render_thread_id;
 
         // RHI Core
         std::shared_ptr<RHI_Device> m_rhi_device;
@@ -310,7 +334,9 @@ namespace Spartan
         RHI_CommandList* m_cmd_current = nullptr;
 
         // Swapchain
-        static const uint8_t m_swap_chain_buffer_count = 3;
+        static const uint8_t m_swap_chain_buffer_count  = 3;
+        static const uint32_t m_headless_width          = 1920; // used when there is no window
+        static const uint32_t m_headless_height         = 1080;
         std::shared_ptr<RHI_SwapChain> m_swap_chain;
 
         //= CONSTANT BUFFERS =====================================
@@ -333,13 +359,32 @@ namespace Spartan
         BufferLight m_buffer_light_cpu_previous;
         std::shared_ptr<RHI_ConstantBuffer> m_buffer_light_gpu;
         uint32_t m_buffer_light_offset_index = 0;
+
+        BufferDraw m_buffer_draw_cpu;
+        BufferDraw m_buffer_draw_cpu_previous;
+        std::shared_ptr<RHI_ConstantBuffer> m_buffer_draw_gpu;
+        uint32_t m_buffer_draw_offset_index = 0;
+
+        // One of each per command list, so that a frame only writes (and grows) buffers which the GPU is done with
+        std::vector<std::shared_ptr<RHI_StructuredBuffer>> m_buffer_instances_gpu;
+        std::vector<std::shared_ptr<RHI_StructuredBuffer>> m_buffer_instance_indices_gpu;
         //========================================================
 
-        // Entities and material references
+        // Entities and material references, as resolved by the simulation
         std::unordered_map<Renderer_ObjectType, std::vector<Entity*>> m_entities;
+        std::unordered_map<Renderer_ObjectType, std::unordered_map<Entity*, uint32_t>> m_entities_index; // position of each entity in m_entities
         std::array<Material*, m_max_material_instances> m_material_instances;
         std::shared_ptr<Camera> m_camera;
 
+        // Frame packets, the simulation captures into one while the other one renders
+        std::array<FramePacket, 2> m_frame_packets;
+        const FramePacket* m_frame_packet                   = &m_frame_packets[0]; // renderer thread
+        uint32_t m_frame_packet_index_capture               = 1;                   // simulation thread
+        std::atomic<FramePacket*> m_frame_packet_captured   = nullptr;
+        std::function<void(const FramePacket&)> m_frame_packet_handler;
+        std::mutex m_frame_packet_mutex;                                           // guards the resolved entities against a world clear
+        std::atomic<bool> m_shadow_maps_dirty               = false;               // re-created when the next packet is captured
+
         // Dependencies
         Profiler* m_profiler            = nullptr;
         ResourceCache* m_resource_cache = nullptr;
@@ -179,7 +179,24 @@ namespace Spartan
 
         bool operator!=(const BufferUber& rhs) const { return !(*this == rhs); }
     };
-    
+
+    // High frequency - Updates per instanced draw
+    struct BufferDraw
+    {
+        uint32_t instance_offset = 0; // where the instances of the draw start in the instance index buffer
+        Math::Vector3 padding;
+
+        bool operator==(const BufferDraw& rhs) const { return instance_offset == rhs.instance_offset; }
+        bool operator!=(const BufferDraw& rhs) const { return !(*this == rhs); }
+    };
+
+    // An element of the instance buffer (a structured buffer), one per renderable of a frame
+    struct BufferInstance
+    {
+        Math::Matrix transform;
+        Math::Matrix transform_previous;
+    };
+
     // Light buffer
     struct BufferLight
     {
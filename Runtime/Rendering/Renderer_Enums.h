@@ -70,7 +70,11 @@ namespace Spartan
         frame       = 30,
         tex         = 31,
         tex2        = 32,
-        font_atlas  = 33
+        font_atlas  = 33,
+
+        // Structured buffers
+        instances           = 34,
+        instance_indices    = 35
     };
 
     // Unordered access views bindings
@@ -194,7 +198,8 @@ namespace Spartan
         Render_ChromaticAberration          = 1 << 20,
         Render_Dithering                    = 1 << 21,
         Render_ReverseZ                     = 1 << 22,
-        Render_DepthPrepass                 = 1 << 23
+        Render_DepthPrepass                 = 1 << 23,
+        Render_Debug_NoInstancing           = 1 << 24  // every draw is issued on its own, to compare against instancing
     };
 
     // Renderer/graphics options values
@@ -0,0 +1,238 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =========================
+#include <vector>
+#include <memory>
+#include <array>
+#include "../Math/Matrix.h"
+#include "../Math/Vector2.h"
+#include "../Math/Vector4.h"
+#include "../Math/Frustum.h"
+#include "../Math/BoundingBox.h"
+#include "../Math/BoundingBoxArray.h"
+#include "../World/Components/Light.h"
+//====================================
+
+namespace Spartan
+{
+    class Entity;
+    class Renderable;
+    class Material;
+    class RHI_Texture;
+    class RHI_VertexBuffer;
+    class RHI_IndexBuffer;
+    struct FramePacketRenderable;
+
+    // A draw which was validated when the packet was captured, passes record it without going back to the renderable.
+    // Every view sorts its draws by a 64-bit key, so that draws which share state are recorded next to each other:
+    // camera opaque:       shader variation (14) | material (16) | geometry (16) | depth (18), front to back
+    // camera transparent:  depth (32), back to front | material (16) | geometry (16)
+    // shadow opaque:       geometry (16) | depth (32)
+    // shadow transparent:  material (16) | geometry (16) | depth (32)
+    struct FramePacketDraw
+    {
+        // The G-buffer shader variation (material flags) in the key of a camera opaque draw
+        static constexpr uint32_t sort_key_variation_shift = 50;
+        uint16_t GetSortKeyVariation() const { return static_cast<uint16_t>(sort_key >> sort_key_variation_shift); }
+
+        // Whether both draws can be issued as instances of a single draw, the material only matters to passes which bind it
+        bool CanInstance(const FramePacketDraw& other, const bool compare_material) const
+        {
+            return
+                vertex_buffer == other.vertex_buffer &&
+                index_buffer  == other.index_buffer  &&
+                index_count   == other.index_count   &&
+                index_offset  == other.index_offset  &&
+                vertex_offset == other.vertex_offset &&
+                (!compare_material || material == other.material);
+        }
+
+        uint64_t sort_key                       = 0;
+        const FramePacketRenderable* item       = nullptr;
+        const RHI_VertexBuffer* vertex_buffer   = nullptr;
+        const RHI_IndexBuffer* index_buffer     = nullptr;
+        Material* material                      = nullptr; // can be null, only passes which need a material require one
+        uint32_t geometry_id                    = 0;       // the model's object id, to skip re-binding the same buffers
+        uint32_t index_count                    = 0;
+        uint32_t index_offset                   = 0;
+        uint32_t vertex_offset                  = 0;
+    };
+
+    // The state of a renderable at the end of a simulated frame
+    struct FramePacketRenderable
+    {
+        std::shared_ptr<Entity> entity;
+        Renderable* renderable          = nullptr;
+        Math::Matrix transform          = Math::Matrix::Identity;
+        Math::Matrix transform_previous = Math::Matrix::Identity; // as captured in the previous frame, for velocity
+        Math::BoundingBox aabb;
+        FramePacketDraw draw;                                     // no vertex buffer if there is nothing to draw
+        bool cast_shadows               = false;
+    };
+
+    // A run of adjacent draws which is issued as a single instanced draw
+    struct FramePacketBatch
+    {
+        uint32_t draw_index         = 0; // the first of the draws
+        uint32_t instance_count     = 0;
+        uint32_t instance_offset    = 0; // where the instances start in the frame's instance index buffer
+    };
+
+    // The draws of one draw list, the renderer uploads which renderable each of them is, at the start of a frame.
+    // The renderables are uploaded once, the opaque ones first, so a draw's renderable is its position in that order.
+    struct FramePacketInstanceRange
+    {
+        const FramePacketDraw* draws                = nullptr;
+        uint32_t count                              = 0;
+        uint32_t offset                             = 0; // the first instance of the range in the frame's instance index buffer
+        const FramePacketRenderable* renderables    = nullptr; // what the draws point into (the opaque or the transparent renderables)
+        uint32_t renderable_offset                  = 0; // where these renderables start in the frame's instance buffer
+    };
+
+    // What a view draws, culled, extracted, sorted and batched once per frame
+    struct FramePacketDrawList
+    {
+        const std::vector<FramePacketDraw>& Get(const bool transparent) const          { return transparent ? geometry_transparent : geometry_opaque; }
+        const std::vector<FramePacketBatch>& GetBatches(const bool transparent) const   { return transparent ? batches_transparent : batches_opaque; }
+
+        std::vector<FramePacketDraw> geometry_opaque;
+        std::vector<FramePacketDraw> geometry_transparent;
+        std::vector<FramePacketBatch> batches_opaque;
+        std::vector<FramePacketBatch> batches_transparent;
+
+        // Which of the renderables are inside the view, one bit per renderable
+        std::vector<uint64_t> visible_opaque;
+        std::vector<uint64_t> visible_transparent;
+    };
+
+    // The state of a light at the end of a simulated frame
+    struct FramePacketLight
+    {
+        std::shared_ptr<Entity> entity;
+        LightType type                  = LightType::Directional;
+        Math::Vector4 color             = Math::Vector4::One;
+        float intensity                 = 0.0f;
+        float range                     = 0.0f;
+        float angle                     = 0.0f;
+        float bias                      = 0.0f;
+        float normal_bias               = 0.0f;
+        bool shadows                    = false;
+        bool shadows_screen_space       = false;
+        bool shadows_transparent        = false;
+        bool volumetric                 = false;
+        Math::Vector3 position          = Math::Vector3::Zero;
+        Math::Vector3 forward           = Math::Vector3::Forward;
+        Math::Vector3 up                = Math::Vector3::Up;
+        Math::Vector3 right             = Math::Vector3::Right;
+        uint32_t shadow_array_size      = 0;
+        std::array<Math::Matrix, 6> view_projection;
+        std::array<Math::Frustum, 6> frustums;
+        std::array<FramePacketDrawList, 6> draws; // per shadow map slice (a cascade or a cube face)
+        std::shared_ptr<RHI_Texture> texture_depth; // shadow maps are kept alive, the simulation can re-create them while the frame renders
+        std::shared_ptr<RHI_Texture> texture_color;
+    };
+
+    // The state of the camera at the end of a simulated frame
+    struct FramePacketCamera
+    {
+        Math::Matrix view           = Math::Matrix::Identity;
+        Math::Matrix projection     = Math::Matrix::Identity;
+        Math::Frustum frustum;
+        FramePacketDrawList draws;
+        Math::Vector3 position      = Math::Vector3::Zero;
+        Math::Vector3 forward       = Math::Vector3::Forward;
+        Math::Vector4 clear_color   = Math::Vector4::Zero;
+        float near_plane            = 0.0f;
+        float far_plane             = 0.0f;
+        float aperture              = 0.0f;
+        float shutter_speed         = 0.0f;
+        float iso                   = 0.0f;
+        float exposure              = 0.0f;
+    };
+
+    // The transform handle of the selected entity, ticked on the simulation thread when the packet is captured
+    struct FramePacketTransformHandle
+    {
+        const RHI_VertexBuffer* vertex_buffer   = nullptr;
+        const RHI_IndexBuffer* index_buffer     = nullptr;
+        uint32_t index_count                    = 0;
+        std::array<Math::Matrix, 4> transforms;   // the x, y, z and xyz axes
+        std::array<Math::Vector3, 4> colors;
+        bool draw_xyz                           = false;
+    };
+
+    // A light icon, already projected to the screen
+    struct FramePacketIcon
+    {
+        LightType type                  = LightType::Directional;
+        Math::Vector2 position_screen   = Math::Vector2::Zero;
+        float scale                     = 1.0f;
+    };
+
+    // Everything the renderer reads from the world, captured once the simulation of a frame has finished.
+    // The renderer only ever reads a packet, so the simulation of the next frame can run while it renders.
+    // Entities are kept alive until the packet is recycled, their components are only referenced for their
+    // resources (geometry, materials, shaders), everything that the simulation can change is copied.
+    struct FramePacket
+    {
+        void Clear()
+        {
+            has_camera              = false;
+            has_outline             = false;
+            has_transform_handle    = false;
+            has_picking_ray         = false;
+            geometry_opaque.clear();
+            geometry_transparent.clear();
+            bounds_opaque.Clear();
+            bounds_transparent.Clear();
+            lights.clear();
+            instance_ranges.clear();
+            instance_count = 0;
+            outline.entity = nullptr;
+            selected       = nullptr;
+            icons.clear();
+        }
+
+        bool has_camera                                     = false;
+        FramePacketCamera camera;
+        std::vector<FramePacketRenderable> geometry_opaque;
+        std::vector<FramePacketRenderable> geometry_transparent;
+        Math::BoundingBoxArray bounds_opaque;       // the world space boxes of geometry_opaque, for culling
+        Math::BoundingBoxArray bounds_transparent;  // the world space boxes of geometry_transparent, for culling
+        std::vector<FramePacketLight> lights;
+        std::vector<FramePacketInstanceRange> instance_ranges; // one per draw list, of all views
+        uint32_t instance_count                             = 0; // of all the ranges
+        bool has_outline                                    = false;
+        FramePacketRenderable outline;                      // the selected entity, when the selection outline is enabled
+
+        // Editor state
+        std::shared_ptr<Entity> selected;                   // the entity selected in the editor
+        bool has_transform_handle                           = false;
+        FramePacketTransformHandle transform_handle;
+        std::vector<FramePacketIcon> icons;
+        bool has_picking_ray                                = false;
+        Math::Vector3 picking_ray_start                     = Math::Vector3::Zero;
+        Math::Vector3 picking_ray_end                       = Math::Vector3::Zero;
+    };
+}
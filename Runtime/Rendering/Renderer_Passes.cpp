@@ -82,10 +82,13 @@ namespace Spartan
         // Update frame constant buffer
         Pass_UpdateFrameBuffer(cmd_list);
 
+        // Upload the transforms of every instanced draw of the frame
+        UpdateInstanceBuffer(cmd_list);
+
         // Generate brdf specular lut (only runs once)
         Pass_BrdfSpecularLut(cmd_list);
 
-        const bool draw_transparent_objects = !m_entities[Renderer_ObjectType::GeometryTransparent].empty();
+        const bool draw_transparent_objects = !m_frame_packet->geometry_transparent.empty();
 
         // Depth
         {
@@ -176,34 +179,27 @@ namespace Spartan
         if (!shader_v->IsCompiled() || !shader_p->IsCompiled())
             return;
 
-        // Get entities
-        const auto& entities = m_entities[object_type];
-        if (entities.empty())
-            return;
-
         const bool transparent_pass = object_type == Renderer_ObjectType::GeometryTransparent;
 
+        // Get renderables
+        const vector<FramePacketRenderable>& renderables = transparent_pass ? m_frame_packet->geometry_transparent : m_frame_packet->geometry_opaque;
+        if (renderables.empty())
+            return;
+
         // Go through all of the lights
-        const auto& entities_light = m_entities[Renderer_ObjectType::Light];
-        for (uint32_t light_index = 0; light_index < entities_light.size(); light_index++)
+        for (const FramePacketLight& light : m_frame_packet->lights)
         {
-            const Light* light = entities_light[light_index]->GetComponent<Light>();
-
-            // Can happen when loading a new scene and the lights get deleted
-            if (!light)
-                continue;
-
             // Skip lights which don't cast shadows or have an intensity of zero
-            if (!light->GetShadowsEnabled() || light->GetIntensity() == 0.0f)
+            if (!light.shadows || light.intensity == 0.0f)
                 continue;
 
             // Skip lights that don't cast transparent shadows (if this is a transparent pass)
-            if (transparent_pass && !light->GetShadowsTransparentEnabled())
+            if (transparent_pass && !light.shadows_transparent)
                 continue;
 
             // Acquire light's shadow maps
-            RHI_Texture* tex_depth = light->GetDepthTexture();
-            RHI_Texture* tex_color = light->GetColorTexture();
+            RHI_Texture* tex_depth = light.texture_depth.get();
+            RHI_Texture* tex_color = light.texture_color.get();
             if (!tex_depth)
                 continue;
 
@@ -221,7 +217,8 @@ namespace Spartan
             pso.primitive_topology               = RHI_PrimitiveTopology_TriangleList;
             pso.pass_name                        = transparent_pass ? "Pass_Depth_Light_Transparent" : "Pass_Depth_Light";
 
-            for (uint32_t array_index = 0; array_index < tex_depth->GetArrayLength(); array_index++)
+            const uint32_t array_length = Math::Helper::Min(tex_depth->GetArrayLength(), light.shadow_array_size);
+            for (uint32_t array_index = 0; array_index < array_length; array_index++)
             {
                 // Set render target texture array index
                 pso.render_target_color_texture_array_index          = array_index;
@@ -231,10 +228,10 @@ namespace Spartan
                 pso.clear_color[0] = Vector4::One;
                 pso.clear_depth    = transparent_pass ? rhi_depth_load : GetClearDepth();
 
-                const Matrix& view_projection = light->GetViewMatrix(array_index) * light->GetProjectionMatrix(array_index);
+                const Matrix& view_projection = light.view_projection[array_index];
 
                 // Set appropriate rasterizer state
-                if (light->GetLightType() == LightType::Directional)
+                if (light.type == LightType::Directional)
                 {
                     // "Pancaking" - https://www.gamedev.net/forums/topic/639036-shadow-mapping-and-high-up-objects/
                     // It's basically a way to capture the silhouettes of potential shadow casters behind the light's view point.
@@ -250,32 +247,12 @@ namespace Spartan
                 bool render_pass_active     = false;
                 uint32_t m_set_material_id  = 0;
 
-                for (uint32_t entity_index = 0; entity_index < static_cast<uint32_t>(entities.size()); entity_index++)
+                // Only the shadow casters which are inside this slice, they all have geometry and a material
+                const FramePacketDrawList& draw_list = light.draws[array_index];
+                for (const FramePacketBatch& batch : draw_list.GetBatches(transparent_pass))
                 {
-                    Entity* entity = entities[entity_index];
-
-                    // Acquire renderable component
-                    Renderable* renderable = entity->GetRenderable();
-                    if (!renderable)
-                        continue;
-
-                    // Skip meshes that don't cast shadows
-                    if (!renderable->GetCastShadows())
-                        continue;
-
-                    // Acquire geometry
-                    Model* model = renderable->GeometryModel();
-                    if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
-                        continue;
-
-                    // Acquire material
-                    Material* material = renderable->GetMaterial();
-                    if (!material)
-                        continue;
-
-                    // Skip objects outside of the view frustum
-                    if (!light->IsInViewFrustrum(renderable, array_index))
-                        continue;
+                    const FramePacketDraw& draw = draw_list.Get(transparent_pass)[batch.draw_index];
+                    Material* material          = draw.material;
 
                     if (!render_pass_active)
                     {
@@ -298,15 +275,19 @@ namespace Spartan
                     }
 
                     // Bind geometry
-                    cmd_list->SetBufferIndex(model->GetIndexBuffer());
-                    cmd_list->SetBufferVertex(model->GetVertexBuffer());
+                    cmd_list->SetBufferIndex(draw.index_buffer);
+                    cmd_list->SetBufferVertex(draw.vertex_buffer);
 
-                    // Update uber buffer with cascade transform
-                    m_buffer_uber_cpu.transform = entity->GetTransform()->GetMatrix() * view_projection;
+                    // Update uber buffer with cascade view projection (only uploads when it or the material changes)
+                    m_buffer_uber_cpu.transform = view_projection;
                     if (!UpdateUberBuffer(cmd_list))
                         continue;
 
-                    cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
+                    // Point to the world transforms
+                    if (!SetInstanceBuffer(cmd_list, batch))
+                        continue;
+
+                    cmd_list->DrawIndexed(draw.index_count, draw.index_offset, draw.vertex_offset, batch.instance_count);
                 }
 
                 if (render_pass_active)
@@ -325,7 +306,8 @@ namespace Spartan
         // Acquire required resources/data
         const auto& shader_depth    = m_shaders[RendererShader::Depth_V];
         const auto& tex_depth       = RENDER_TARGET(RendererRt::Gbuffer_Depth);
-        const auto& entities        = m_entities[Renderer_ObjectType::GeometryOpaque];
+        const auto& draws           = m_frame_packet->camera.draws.geometry_opaque;
+        const auto& batches         = m_frame_packet->camera.draws.batches_opaque;
 
         // Ensure the shader has compiled
         if (!shader_depth->IsCompiled())
@@ -347,46 +329,34 @@ namespace Spartan
         // Record commands
         if (cmd_list->BeginRenderPass(pso))
         { 
-            if (!entities.empty())
+            if (!draws.empty())
             {
                 // Variables that help reduce state changes
                 uint32_t currently_bound_geometry = 0;
 
+                // Update uber buffer with the view projection, the world transforms are per instance
+                m_buffer_uber_cpu.transform = m_buffer_frame_cpu.view_projection;
+                UpdateUberBuffer(cmd_list);
+
                 // Draw opaque
-                for (const auto& entity : entities)
+                for (const FramePacketBatch& batch : batches)
                 {
-                    // Get renderable
-                    Renderable* renderable = entity->GetRenderable();
-                    if (!renderable)
-                        continue;
-
-                    // Get geometry
-                    Model* model = renderable->GeometryModel();
-                    if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
-                        continue;
-
-                    // Skip objects outside of the view frustum
-                    if (!m_camera->IsInViewFrustrum(renderable))
-                        continue;
+                    const FramePacketDraw& draw = draws[batch.draw_index];
 
                     // Bind geometry
-                    if (currently_bound_geometry != model->GetObjectId())
+                    if (currently_bound_geometry != draw.geometry_id)
                     {
-                        cmd_list->SetBufferIndex(model->GetIndexBuffer());
-                        cmd_list->SetBufferVertex(model->GetVertexBuffer());
-                        currently_bound_geometry = model->GetObjectId();
+                        cmd_list->SetBufferIndex(draw.index_buffer);
+                        cmd_list->SetBufferVertex(draw.vertex_buffer);
+                        currently_bound_geometry = draw.geometry_id;
                     }
 
-                    // Update uber buffer with entity transform
-                    if (Transform* transform = entity->GetTransform())
-                    {
-                        // Update uber buffer with cascade transform
-                        m_buffer_uber_cpu.transform = transform->GetMatrix() * m_buffer_frame_cpu.view_projection;
-                        UpdateUberBuffer(cmd_list);
-                    }
+                    // Point to the world transforms
+                    if (!SetInstanceBuffer(cmd_list, batch))
+                        continue;
 
                     // Draw    
-                    cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
+                    cmd_list->DrawIndexed(draw.index_count, draw.index_offset, draw.vertex_offset, batch.instance_count);
                 }
             }
             cmd_list->EndRenderPass();
@@ -431,6 +401,7 @@ namespace Spartan
 
         uint32_t material_index = 0;
         uint32_t material_bound_id = 0;
+        bool targets_cleared = false;
         m_material_instances.fill(nullptr);
 
         // Iterate through all the G-Buffer shader variations
@@ -447,22 +418,34 @@ namespace Spartan
             pso.pass_name = is_transparent_pass ? "GBuffer_Transparent" : "GBuffer_Opaque";
 
             bool render_pass_active = false;
-            auto& entities = m_entities[is_transparent_pass ? Renderer_ObjectType::GeometryTransparent : Renderer_ObjectType::GeometryOpaque];
+            const vector<FramePacketDraw>& draws    = m_frame_packet->camera.draws.Get(is_transparent_pass);
+            const vector<FramePacketBatch>& batches = m_frame_packet->camera.draws.GetBatches(is_transparent_pass);
+
+            // Opaque draws are sorted by shader variation first, so each variation only has to walk its own range of batches
+            auto batches_begin = batches.begin();
+            auto batches_end   = batches.end();
+            if (!is_transparent_pass)
+            {
+                auto variation = [&draws](const FramePacketBatch& batch) { return draws[batch.draw_index].GetSortKeyVariation(); };
+                batches_begin = lower_bound(batches.begin(), batches.end(), it.first, [&variation](const FramePacketBatch& batch, const uint16_t flags) { return variation(batch) < flags; });
+                batches_end   = upper_bound(batches_begin,   batches.end(), it.first, [&variation](const uint16_t flags, const FramePacketBatch& batch) { return flags < variation(batch); });
+
+                // Skip variations without draws, once the first render pass has cleared the render targets
+                if (batches_begin == batches_end && targets_cleared)
+                    continue;
+            }
 
             // Record commands
             if (cmd_list->BeginRenderPass(pso))
             { 
-                for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); i++)
+                for (auto batch_it = batches_begin; batch_it != batches_end; batch_it++)
                 {
-                    Entity* entity = entities[i];
-
-                    // Get renderable
-                    Renderable* renderable = entity->GetRenderable();
-                    if (!renderable)
-                        continue;
+                    // The draws of a batch share geometry and material, so all the checks below hold for all of them
+                    const FramePacketBatch& batch   = *batch_it;
+                    const FramePacketDraw& draw     = draws[batch.draw_index];
 
                     // Get material
-                    Material* material = renderable->GetMaterial();
+                    Material* material = draw.material;
                     if (!material)
                         continue;
 
@@ -474,18 +457,9 @@ namespace Spartan
                     if (material->GetColorAlbedo().w == 0 && is_transparent_pass)
                         continue;
 
-                    // Get geometry
-                    Model* model = renderable->GeometryModel();
-                    if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
-                        continue;
-
-                    // Skip objects outside of the view frustum
-                    if (!m_camera->IsInViewFrustrum(renderable))
-                        continue;
-
                     // Set geometry (will only happen if not already set)
-                    cmd_list->SetBufferIndex(model->GetIndexBuffer());
-                    cmd_list->SetBufferVertex(model->GetVertexBuffer());
+                    cmd_list->SetBufferIndex(draw.index_buffer);
+                    cmd_list->SetBufferVertex(draw.vertex_buffer);
 
                     // Bind material
                     const bool firs_run       = material_index == 0;
@@ -532,29 +506,20 @@ namespace Spartan
                         UpdateUberBuffer(cmd_list);
                     }
 
-                    // Update uber buffer with entity transform
-                    if (Transform* transform = entity->GetTransform())
-                    {
-                        m_buffer_uber_cpu.transform             = transform->GetMatrix();
-                        m_buffer_uber_cpu.transform_previous    = transform->GetMatrixPrevious();
-
-                        // Save matrix for velocity computation
-                        transform->SetWvpLastFrame(m_buffer_uber_cpu.transform);
-
-                        // Update object buffer
-                        if (!UpdateUberBuffer(cmd_list))
-                            continue;
-                    }
+                    // Point to the current and previous world transforms
+                    if (!SetInstanceBuffer(cmd_list, batch))
+                        continue;
 
                     // Render
-                    cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
-                    m_profiler->m_renderer_meshes_rendered++;
+                    cmd_list->DrawIndexed(draw.index_count, draw.index_offset, draw.vertex_offset, batch.instance_count);
+                    m_profiler->m_renderer_meshes_rendered += batch.instance_count;
                 }
 
                 cmd_list->EndRenderPass();
 
                 // Reset clear values after the first render pass
                 pso.ResetClearValues();
+                targets_cleared = true;
             }
         }
     }
@@ -706,8 +671,8 @@ namespace Spartan
     void Renderer::Pass_Light(RHI_CommandList* cmd_list, const bool is_transparent_pass /*= false*/)
     {
         // Acquire lights
-        const vector<Entity*>& entities = m_entities[Renderer_ObjectType::Light];
-        if (entities.empty())
+        const vector<FramePacketLight>& lights = m_frame_packet->lights;
+        if (lights.empty())
             return;
 
         // Acquire render targets
@@ -724,75 +689,72 @@ namespace Spartan
         static RHI_PipelineState pso;
         pso.pass_name = is_transparent_pass ? "Pass_Light_Transparent" : "Pass_Light_Opaque";
 
-        // Iterate through all the light entities
-        for (const auto& entity : entities)
+        // Iterate through all the lights
+        for (const FramePacketLight& light : lights)
         {
-            if (Light* light = entity->GetComponent<Light>())
+            if (light.intensity == 0)
+                continue;
+
+            // Set pixel shader
+            pso.shader_compute = static_cast<RHI_Shader*>(ShaderLight::GetVariation(m_context, light, m_options));
+
+            // Skip the shader it failed to compiled or hasn't compiled yet
+            if (!pso.shader_compute->IsCompiled())
+                continue;
+
+            // Draw
+            if (cmd_list->BeginRenderPass(pso))
             {
-                if (light->GetIntensity() != 0)
+                // Update constant buffer (light pass will access it using material IDs)
+                UpdateMaterialBuffer(cmd_list);
+
+                cmd_list->SetTexture(RendererBindingsUav::rgb,              tex_diffuse);
+                cmd_list->SetTexture(RendererBindingsUav::rgb2,             tex_specular);
+                cmd_list->SetTexture(RendererBindingsUav::rgb3,             tex_volumetric);
+                cmd_list->SetTexture(RendererBindingsSrv::gbuffer_albedo,   RENDER_TARGET(RendererRt::Gbuffer_Albedo));
+                cmd_list->SetTexture(RendererBindingsSrv::gbuffer_normal,   RENDER_TARGET(RendererRt::Gbuffer_Normal));
+                cmd_list->SetTexture(RendererBindingsSrv::gbuffer_material, RENDER_TARGET(RendererRt::Gbuffer_Material));
+                cmd_list->SetTexture(RendererBindingsSrv::gbuffer_depth,    RENDER_TARGET(RendererRt::Gbuffer_Depth));
+                cmd_list->SetTexture(RendererBindingsSrv::ssao,             RENDER_TARGET(RendererRt::Ssao_Blurred));
+
+                // Set shadow map
+                if (light.shadows)
                 {
-                    // Set pixel shader
-                    pso.shader_compute = static_cast<RHI_Shader*>(ShaderLight::GetVariation(m_context, light, m_options));
+                    RHI_Texture* tex_depth = light.texture_depth.get();
+                    RHI_Texture* tex_color = light.shadows_transparent ? light.texture_color.get() : m_tex_default_white.get();
 
-                    // Skip the shader it failed to compiled or hasn't compiled yet
-                    if (!pso.shader_compute->IsCompiled())
-                        continue;
-
-                    // Draw
-                    if (cmd_list->BeginRenderPass(pso))
+                    if (light.type == LightType::Directional)
                     {
-                        // Update constant buffer (light pass will access it using material IDs)
-                        UpdateMaterialBuffer(cmd_list);
-
-                        cmd_list->SetTexture(RendererBindingsUav::rgb,              tex_diffuse);
-                        cmd_list->SetTexture(RendererBindingsUav::rgb2,             tex_specular);
-                        cmd_list->SetTexture(RendererBindingsUav::rgb3,             tex_volumetric);
-                        cmd_list->SetTexture(RendererBindingsSrv::gbuffer_albedo,   RENDER_TARGET(RendererRt::Gbuffer_Albedo));
-                        cmd_list->SetTexture(RendererBindingsSrv::gbuffer_normal,   RENDER_TARGET(RendererRt::Gbuffer_Normal));
-                        cmd_list->SetTexture(RendererBindingsSrv::gbuffer_material, RENDER_TARGET(RendererRt::Gbuffer_Material));
-                        cmd_list->SetTexture(RendererBindingsSrv::gbuffer_depth,    RENDER_TARGET(RendererRt::Gbuffer_Depth));
-                        cmd_list->SetTexture(RendererBindingsSrv::ssao,             RENDER_TARGET(RendererRt::Ssao_Blurred));
-
-                        // Set shadow map
-                        if (light->GetShadowsEnabled())
-                        {
-                            RHI_Texture* tex_depth = light->GetDepthTexture();
-                            RHI_Texture* tex_color = light->GetShadowsTransparentEnabled() ? light->GetColorTexture() : m_tex_default_white.get();
-
-                            if (light->GetLightType() == LightType::Directional)
-                            {
-                                cmd_list->SetTexture(RendererBindingsSrv::light_directional_depth, tex_depth);
-                                cmd_list->SetTexture(RendererBindingsSrv::light_directional_color, tex_color);
-                            }
-                            else if (light->GetLightType() == LightType::Point)
-                            {
-                                cmd_list->SetTexture(RendererBindingsSrv::light_point_depth, tex_depth);
-                                cmd_list->SetTexture(RendererBindingsSrv::light_point_color, tex_color);
-                            }
-                            else if (light->GetLightType() == LightType::Spot)
-                            {
-                                cmd_list->SetTexture(RendererBindingsSrv::light_spot_depth, tex_depth);
-                                cmd_list->SetTexture(RendererBindingsSrv::light_spot_color, tex_color);
-                            }
-                        }
+                        cmd_list->SetTexture(RendererBindingsSrv::light_directional_depth, tex_depth);
+                        cmd_list->SetTexture(RendererBindingsSrv::light_directional_color, tex_color);
+                    }
+                    else if (light.type == LightType::Point)
+                    {
+                        cmd_list->SetTexture(RendererBindingsSrv::light_point_depth, tex_depth);
+                        cmd_list->SetTexture(RendererBindingsSrv::light_point_color, tex_color);
+                    }
+                    else if (light.type == LightType::Spot)
+                    {
+                        cmd_list->SetTexture(RendererBindingsSrv::light_spot_depth, tex_depth);
+                        cmd_list->SetTexture(RendererBindingsSrv::light_spot_color, tex_color);
+                    }
+                }
 
-                        // Update light buffer
-                        UpdateLightBuffer(cmd_list, light);
+                // Update light buffer
+                UpdateLightBuffer(cmd_list, light);
 
-                        // Update uber buffer
-                        m_buffer_uber_cpu.resolution            = Vector2(static_cast<float>(tex_diffuse->GetWidth()), static_cast<float>(tex_diffuse->GetHeight()));
-                        m_buffer_uber_cpu.is_transparent_pass   = is_transparent_pass;
-                        UpdateUberBuffer(cmd_list);
+                // Update uber buffer
+                m_buffer_uber_cpu.resolution            = Vector2(static_cast<float>(tex_diffuse->GetWidth()), static_cast<float>(tex_diffuse->GetHeight()));
+                m_buffer_uber_cpu.is_transparent_pass   = is_transparent_pass;
+                UpdateUberBuffer(cmd_list);
 
-                        const uint32_t thread_group_count_x = static_cast<uint32_t>(Math::Helper::Ceil(static_cast<float>(tex_diffuse->GetWidth()) / m_thread_group_count));
-                        const uint32_t thread_group_count_y = static_cast<uint32_t>(Math::Helper::Ceil(static_cast<float>(tex_diffuse->GetHeight()) / m_thread_group_count));
-                        const uint32_t thread_group_count_z = 1;
-                        const bool async = false;
+                const uint32_t thread_group_count_x = static_cast<uint32_t>(Math::Helper::Ceil(static_cast<float>(tex_diffuse->GetWidth()) / m_thread_group_count));
+                const uint32_t thread_group_count_y = static_cast<uint32_t>(Math::Helper::Ceil(static_cast<float>(tex_diffuse->GetHeight()) / m_thread_group_count));
+                const uint32_t thread_group_count_z = 1;
+                const bool async = false;
 
-                        cmd_list->Dispatch(thread_group_count_x, thread_group_count_y, thread_group_count_z, async);
-                        cmd_list->EndRenderPass();
-                    }
-                }
+                cmd_list->Dispatch(thread_group_count_x, thread_group_count_y, thread_group_count_z, async);
+                cmd_list->EndRenderPass();
             }
         }
     }
@@ -1772,11 +1734,15 @@ namespace Spartan
 
     void Renderer::Pass_Lines(RHI_CommandList* cmd_list, RHI_Texture* tex_out)
     {
-        const bool draw_picking_ray = m_options & Render_Debug_PickingRay;
+        const bool draw_picking_ray = (m_options & Render_Debug_PickingRay) && m_frame_packet->has_picking_ray;
         const bool draw_aabb        = m_options & Render_Debug_Aabb;
         const bool draw_grid        = m_options & Render_Debug_Grid;
-        const bool draw_lights      = m_options & Render_Debug_Lights;
-        const bool draw_lines       = !m_lines_depth_disabled.empty() || !m_lines_depth_enabled.empty(); // Any kind of lines, physics, user debug, etc.
+        const bool draw_lights      = (m_options & Render_Debug_Lights) && m_frame_packet->selected;
+        bool draw_lines             = false; // Any kind of lines, physics, user debug, etc.
+        {
+            lock_guard<mutex> lock(m_lines_mutex);
+            draw_lines = !m_lines_depth_disabled.empty() || !m_lines_depth_enabled.empty();
+        }
         const bool draw             = draw_picking_ray || draw_aabb || draw_grid || draw_lines || draw_lights;
         if (!draw)
             return;
@@ -1809,7 +1775,7 @@ namespace Spartan
             {
                 // Update uber buffer
                 m_buffer_uber_cpu.resolution    = m_resolution_render;
-                m_buffer_uber_cpu.transform     = m_gizmo_grid->ComputeWorldMatrix(m_camera->GetTransform()) * m_buffer_frame_cpu.view_projection_unjittered;
+                m_buffer_uber_cpu.transform     = m_gizmo_grid->ComputeWorldMatrix(m_frame_packet->camera.position) * m_buffer_frame_cpu.view_projection_unjittered;
                 UpdateUberBuffer(cmd_list);
         
                 cmd_list->SetBufferIndex(m_gizmo_grid->GetIndexBuffer().get());
@@ -1824,51 +1790,47 @@ namespace Spartan
             // Picking ray
             if (draw_picking_ray)
             {
-                const auto& ray = m_camera->GetPickingRay();
-                DrawLine(ray.GetStart(), ray.GetStart() + ray.GetDirection() * m_camera->GetFarPlane(), Vector4(0, 1, 0, 1));
+                DrawLine(m_frame_packet->picking_ray_start, m_frame_packet->picking_ray_end, Vector4(0, 1, 0, 1));
             }
 
             // Lights
             if (draw_lights)
             {
-                auto& lights = m_entities[Renderer_ObjectType::Light];
-                for (const auto& entity : lights)
+                const Entity* entity_selected = m_frame_packet->selected.get();
+                for (const FramePacketLight& light : m_frame_packet->lights)
                 {
-                    const Entity* entity_selected = m_transform_handle->GetSelectedEntity();
-                    if (entity_selected && entity_selected->GetObjectId() == entity->GetObjectId())
+                    if (entity_selected && entity_selected == light.entity.get())
                     { 
-                        Light* light = entity->GetComponent<Light>();
-
-                        if (light->GetLightType() == LightType::Directional)
+                        if (light.type == LightType::Directional)
                         {
-                            Vector3 pos_start   = light->GetTransform()->GetPosition();
+                            Vector3 pos_start   = light.position;
                             Vector3 pos_end     = -pos_start;
                             DrawLine(pos_start, pos_end);
 
                         }
-                        else if (light->GetLightType() == LightType::Point)
+                        else if (light.type == LightType::Point)
                         {
-                            Vector3 center          = light->GetTransform()->GetPosition();
-                            float radius            = light->GetRange();
+                            Vector3 center          = light.position;
+                            float radius            = light.range;
                             uint32_t segment_count  = 64;
 
                             DrawCircle(center, Vector3::Up, radius, segment_count);
                             DrawCircle(center, Vector3::Right, radius, segment_count);
                             DrawCircle(center, Vector3::Forward, radius, segment_count);
                         }
-                        else if (light->GetLightType() == LightType::Spot)
+                        else if (light.type == LightType::Spot)
                         {
                             // tan(angle) = opposite/adjacent
                             // opposite = adjacent * tan(angle)
-                            float opposite  = light->GetRange() * Math::Helper::Tan(light->GetAngle());
+                            float opposite  = light.range * Math::Helper::Tan(light.angle);
 
-                            Vector3 pos_end_center  = light->GetTransform()->GetForward() * light->GetRange();
-                            Vector3 pos_end_up      = pos_end_center + light->GetTransform()->GetUp()      * opposite;
-                            Vector3 pos_end_right   = pos_end_center + light->GetTransform()->GetRight()   * opposite;
-                            Vector3 pos_end_down    = pos_end_center + light->GetTransform()->GetDown()    * opposite;
-                            Vector3 pos_end_left    = pos_end_center + light->GetTransform()->GetLeft()    * opposite;
+                            Vector3 pos_end_center  = light.forward * light.range;
+                            Vector3 pos_end_up      = pos_end_center + light.up     * opposite;
+                            Vector3 pos_end_right   = pos_end_center + light.right  * opposite;
+                            Vector3 pos_end_down    = pos_end_center - light.up     * opposite;
+                            Vector3 pos_end_left    = pos_end_center - light.right  * opposite;
 
-                            Vector3 pos_start = light->GetTransform()->GetPosition();
+                            Vector3 pos_start = light.position;
                             DrawLine(pos_start, pos_start + pos_end_center);
                             DrawLine(pos_start, pos_start + pos_end_up);
                             DrawLine(pos_start, pos_start + pos_end_right);
@@ -1882,26 +1844,22 @@ namespace Spartan
             // AABBs
             if (draw_aabb)
             {
-                for (const auto& entity : m_entities[Renderer_ObjectType::GeometryOpaque])
+                for (const FramePacketRenderable& item : m_frame_packet->geometry_opaque)
                 {
-                    if (auto renderable = entity->GetRenderable())
-                    {
-                        DrawBox(renderable->GetAabb(), Vector4(0.41f, 0.86f, 1.0f, 1.0f));
-                    }
+                    DrawBox(item.aabb, Vector4(0.41f, 0.86f, 1.0f, 1.0f));
                 }
 
-                for (const auto& entity : m_entities[Renderer_ObjectType::GeometryTransparent])
+                for (const FramePacketRenderable& item : m_frame_packet->geometry_transparent)
                 {
-                    if (auto renderable = entity->GetRenderable())
-                    {
-                        DrawBox(renderable->GetAabb(), Vector4(0.41f, 0.86f, 1.0f, 1.0f));
-                    }
+                    DrawBox(item.aabb, Vector4(0.41f, 0.86f, 1.0f, 1.0f));
                 }
             }
         }
 
         // Draw lines
         {
+            lock_guard<mutex> lock(m_lines_mutex);
+
             // Width depth
             uint32_t line_vertex_buffer_size = static_cast<uint32_t>(m_lines_depth_enabled.size());
             if (line_vertex_buffer_size != 0)
@@ -1985,10 +1943,10 @@ namespace Spartan
             return;
 
         // Acquire resources
-        auto& lights                    = m_entities[Renderer_ObjectType::Light];
-        const auto& shader_quad_v       = m_shaders[RendererShader::Quad_V];
-        const auto& shader_texture_p    = m_shaders[RendererShader::Copy_Bilinear_P];
-        if (lights.empty() || !shader_quad_v->IsCompiled() || !shader_texture_p->IsCompiled())
+        const vector<FramePacketIcon>& icons    = m_frame_packet->icons;
+        const auto& shader_quad_v               = m_shaders[RendererShader::Quad_V];
+        const auto& shader_texture_p            = m_shaders[RendererShader::Copy_Bilinear_P];
+        if (icons.empty() || !shader_quad_v->IsCompiled() || !shader_texture_p->IsCompiled())
             return;
 
         // Set render state
@@ -2004,63 +1962,43 @@ namespace Spartan
         pso.viewport                         = tex_out->GetViewport();
         pso.pass_name                        = "Pass_Icons";
 
-        // For each light
-        for (const auto& entity : lights)
+        // For each light in front of the camera, as captured with the frame
+        for (const FramePacketIcon& icon : icons)
         {
             if (cmd_list->BeginRenderPass(pso))
             {
-                // Light can be null if it just got removed and our buffer doesn't update till the next frame
-                if (Light* light = entity->GetComponent<Light>())
+                // Choose texture based on light type
+                shared_ptr<RHI_Texture> light_tex = nullptr;
+                if (icon.type == LightType::Directional) light_tex = m_tex_gizmo_light_directional;
+                else if (icon.type == LightType::Point)  light_tex = m_tex_gizmo_light_point;
+                else if (icon.type == LightType::Spot)   light_tex = m_tex_gizmo_light_spot;
+
+                // Construct appropriate rectangle
+                const float tex_width = light_tex->GetWidth() * icon.scale;
+                const float tex_height = light_tex->GetHeight() * icon.scale;
+                Math::Rectangle rectangle = Math::Rectangle
+                (
+                    icon.position_screen.x - tex_width * 0.5f,
+                    icon.position_screen.y - tex_height * 0.5f,
+                    icon.position_screen.x + tex_width,
+                    icon.position_screen.y + tex_height
+                );
+
+                if (rectangle != m_gizmo_light_rect)
                 {
-                    Vector3 position_light_world        = entity->GetTransform()->GetPosition();
-                    Vector3 position_camera_world       = m_camera->GetTransform()->GetPosition();
-                    Vector3 direction_camera_to_light   = (position_light_world - position_camera_world).Normalized();
-                    const float v_dot_l                 = Vector3::Dot(m_camera->GetTransform()->GetForward(), direction_camera_to_light);
-
-                    // Only draw if it's inside our view
-                    if (v_dot_l > 0.5f)
-                    {
-                        // Compute light screen space position and scale (based on distance from the camera)
-                        const Vector2 position_light_screen = m_camera->Project(position_light_world);
-                        const float distance                = (position_camera_world - position_light_world).Length() + Helper::EPSILON;
-                        float scale                         = m_gizmo_size_max / distance;
-                        scale                               = Helper::Clamp(scale, m_gizmo_size_min, m_gizmo_size_max);
-
-                        // Choose texture based on light type
-                        shared_ptr<RHI_Texture> light_tex = nullptr;
-                        const LightType type = light->GetLightType();
-                        if (type == LightType::Directional) light_tex = m_tex_gizmo_light_directional;
-                        else if (type == LightType::Point)  light_tex = m_tex_gizmo_light_point;
-                        else if (type == LightType::Spot)   light_tex = m_tex_gizmo_light_spot;
-
-                        // Construct appropriate rectangle
-                        const float tex_width = light_tex->GetWidth() * scale;
-                        const float tex_height = light_tex->GetHeight() * scale;
-                        Math::Rectangle rectangle = Math::Rectangle
-                        (
-                            position_light_screen.x - tex_width * 0.5f,
-                            position_light_screen.y - tex_height * 0.5f,
-                            position_light_screen.x + tex_width,
-                            position_light_screen.y + tex_height
-                        );
-
-                        if (rectangle != m_gizmo_light_rect)
-                        {
-                            m_gizmo_light_rect = rectangle;
-                            m_gizmo_light_rect.CreateBuffers(this);
-                        }
+                    m_gizmo_light_rect = rectangle;
+                    m_gizmo_light_rect.CreateBuffers(this);
+                }
 
-                        // Update uber buffer
-                        m_buffer_uber_cpu.resolution = Vector2(static_cast<float>(tex_width), static_cast<float>(tex_width));
-                        m_buffer_uber_cpu.transform = m_buffer_frame_cpu.view_projection_ortho;
-                        UpdateUberBuffer(cmd_list);
+                // Update uber buffer
+                m_buffer_uber_cpu.resolution = Vector2(static_cast<float>(tex_width), static_cast<float>(tex_width));
+                m_buffer_uber_cpu.transform = m_buffer_frame_cpu.view_projection_ortho;
+                UpdateUberBuffer(cmd_list);
 
-                        cmd_list->SetTexture(RendererBindingsSrv::tex, light_tex);
-                        cmd_list->SetBufferIndex(m_gizmo_light_rect.GetIndexBuffer());
-                        cmd_list->SetBufferVertex(m_gizmo_light_rect.GetVertexBuffer());
-                        cmd_list->DrawIndexed(Rectangle::GetIndexCount());
-                    }
-                }
+                cmd_list->SetTexture(RendererBindingsSrv::tex, light_tex);
+                cmd_list->SetBufferIndex(m_gizmo_light_rect.GetIndexBuffer());
+                cmd_list->SetBufferVertex(m_gizmo_light_rect.GetVertexBuffer());
+                cmd_list->DrawIndexed(Rectangle::GetIndexCount());
                 cmd_list->EndRenderPass();
             }
         }
@@ -2077,79 +2015,41 @@ namespace Spartan
         if (!shader_gizmo_transform_v->IsCompiled() || !shader_gizmo_transform_p->IsCompiled())
             return;
 
-        // Transform
-        if (m_transform_handle->Tick(m_camera.get(), m_gizmo_transform_size, m_gizmo_transform_speed))
-        {
-            // Set render state
-            static RHI_PipelineState pso;
-            pso.shader_vertex                    = shader_gizmo_transform_v;
-            pso.shader_pixel                     = shader_gizmo_transform_p;
-            pso.rasterizer_state                 = m_rasterizer_cull_back_solid.get();
-            pso.blend_state                      = m_blend_alpha.get();
-            pso.depth_stencil_state              = m_depth_stencil_off_off.get();
-            pso.vertex_buffer_stride             = m_transform_handle->GetVertexBuffer()->GetStride();
-            pso.render_target_color_textures[0]  = tex_out;
-            pso.primitive_topology               = RHI_PrimitiveTopology_TriangleList;
-            pso.viewport                         = tex_out->GetViewport();
+        // Ticked on the simulation thread, when the frame was captured
+        if (!m_frame_packet->has_transform_handle)
+            return;
 
-            // Axis - X
-            pso.pass_name = "Pass_Handle_Axis_X";
-            if (cmd_list->BeginRenderPass(pso))
-            {
-                m_buffer_uber_cpu.transform         = m_transform_handle->GetHandle()->GetTransform(Vector3::Right);
-                m_buffer_uber_cpu.transform_axis    = m_transform_handle->GetHandle()->GetColor(Vector3::Right);
-                UpdateUberBuffer(cmd_list);
-            
-                cmd_list->SetBufferIndex(m_transform_handle->GetIndexBuffer());
-                cmd_list->SetBufferVertex(m_transform_handle->GetVertexBuffer());
-                cmd_list->DrawIndexed(m_transform_handle->GetIndexCount());
-                cmd_list->EndRenderPass();
-            }
-            
-            // Axis - Y
-            pso.pass_name = "Pass_Handle_Axis_Y";
-            if (cmd_list->BeginRenderPass(pso))
-            {
-                m_buffer_uber_cpu.transform         = m_transform_handle->GetHandle()->GetTransform(Vector3::Up);
-                m_buffer_uber_cpu.transform_axis    = m_transform_handle->GetHandle()->GetColor(Vector3::Up);
-                UpdateUberBuffer(cmd_list);
+        const FramePacketTransformHandle& handle = m_frame_packet->transform_handle;
 
-                cmd_list->SetBufferIndex(m_transform_handle->GetIndexBuffer());
-                cmd_list->SetBufferVertex(m_transform_handle->GetVertexBuffer());
-                cmd_list->DrawIndexed(m_transform_handle->GetIndexCount());
-                cmd_list->EndRenderPass();
-            }
-            
-            // Axis - Z
-            pso.pass_name = "Pass_Handle_Axis_Z";
+        // Set render state
+        static RHI_PipelineState pso;
+        pso.shader_vertex                    = shader_gizmo_transform_v;
+        pso.shader_pixel                     = shader_gizmo_transform_p;
+        pso.rasterizer_state                 = m_rasterizer_cull_back_solid.get();
+        pso.blend_state                      = m_blend_alpha.get();
+        pso.depth_stencil_state              = m_depth_stencil_off_off.get();
+        pso.vertex_buffer_stride             = handle.vertex_buffer->GetStride();
+        pso.render_target_color_textures[0]  = tex_out;
+        pso.primitive_topology               = RHI_PrimitiveTopology_TriangleList;
+        pso.viewport                         = tex_out->GetViewport();
+
+        // Axes - X, Y, Z and (when scaling) XYZ
+        static const array<const char*, 4> pass_names = { "Pass_Handle_Axis_X", "Pass_Handle_Axis_Y", "Pass_Handle_Axis_Z", "Pass_Gizmos_Axis_XYZ" };
+        const uint32_t axis_count = handle.draw_xyz ? 4 : 3;
+        for (uint32_t i = 0; i < axis_count; i++)
+        {
+            pso.pass_name = pass_names[i];
             if (cmd_list->BeginRenderPass(pso))
             {
-                m_buffer_uber_cpu.transform         = m_transform_handle->GetHandle()->GetTransform(Vector3::Forward);
-                m_buffer_uber_cpu.transform_axis    = m_transform_handle->GetHandle()->GetColor(Vector3::Forward);
+                m_buffer_uber_cpu.transform         = handle.transforms[i];
+                m_buffer_uber_cpu.transform_axis    = handle.colors[i];
                 UpdateUberBuffer(cmd_list);
 
-                cmd_list->SetBufferIndex(m_transform_handle->GetIndexBuffer());
-                cmd_list->SetBufferVertex(m_transform_handle->GetVertexBuffer());
-                cmd_list->DrawIndexed(m_transform_handle->GetIndexCount());
+                cmd_list->SetBufferIndex(handle.index_buffer);
+                cmd_list->SetBufferVertex(handle.vertex_buffer);
+                cmd_list->DrawIndexed(handle.index_count);
                 cmd_list->EndRenderPass();
             }
-            
-            // Axes - XYZ
-            if (m_transform_handle->DrawXYZ())
-            {
-                pso.pass_name = "Pass_Gizmos_Axis_XYZ";
-                if (cmd_list->BeginRenderPass(pso))
-                {
-                    m_buffer_uber_cpu.transform         = m_transform_handle->GetHandle()->GetTransform(Vector3::One);
-                    m_buffer_uber_cpu.transform_axis    = m_transform_handle->GetHandle()->GetColor(Vector3::One);
-                    UpdateUberBuffer(cmd_list);
-
-                    cmd_list->SetBufferIndex(m_transform_handle->GetIndexBuffer());
-                    cmd_list->SetBufferVertex(m_transform_handle->GetVertexBuffer());
-                    cmd_list->DrawIndexed(m_transform_handle->GetIndexCount());
-                    cmd_list->EndRenderPass();
-                }
-            }
         }
     }
 
@@ -2158,21 +2058,11 @@ namespace Spartan
         if (!GetOption(Render_Debug_SelectionOutline))
             return;
 
-        if (const Entity* entity = m_transform_handle->GetSelectedEntity())
+        if (m_frame_packet->has_outline)
         {
-            // Get renderable
-            const Renderable* renderable = entity->GetRenderable();
-            if (!renderable)
-                return;
-
-            // Get material
-            const Material* material = renderable->GetMaterial();
-            if (!material)
-                return;
-
-            // Get geometry
-            const Model* model = renderable->GeometryModel();
-            if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
+            // The selected entity's draw, captured along with the rest of the frame
+            const FramePacketDraw& draw = m_frame_packet->outline.draw;
+            if (!draw.vertex_buffer || !draw.material)
                 return;
 
             // Acquire shaders
@@ -2191,7 +2081,7 @@ namespace Spartan
             pso.rasterizer_state                         = m_rasterizer_cull_back_solid.get();
             pso.blend_state                              = m_blend_alpha.get();
             pso.depth_stencil_state                      = m_depth_stencil_r_off.get();
-            pso.vertex_buffer_stride                     = model->GetVertexBuffer()->GetStride();
+            pso.vertex_buffer_stride                     = draw.vertex_buffer->GetStride();
             pso.render_target_color_textures[0]          = tex_out;
             pso.render_target_depth_texture              = tex_depth;
             pso.render_target_depth_texture_read_only    = true;
@@ -2202,19 +2092,16 @@ namespace Spartan
             // Record commands
             if (cmd_list->BeginRenderPass(pso))
             {
-                 // Update uber buffer with entity transform
-                if (Transform* transform = entity->GetTransform())
-                {
-                    m_buffer_uber_cpu.transform     = transform->GetMatrix();
-                    m_buffer_uber_cpu.resolution    = Vector2(tex_out->GetWidth(), tex_out->GetHeight());
-                    UpdateUberBuffer(cmd_list);
-                }
+                // Update uber buffer with entity transform
+                m_buffer_uber_cpu.transform     = draw.item->transform;
+                m_buffer_uber_cpu.resolution    = Vector2(tex_out->GetWidth(), tex_out->GetHeight());
+                UpdateUberBuffer(cmd_list);
 
                 cmd_list->SetTexture(RendererBindingsSrv::gbuffer_depth, tex_depth);
                 cmd_list->SetTexture(RendererBindingsSrv::gbuffer_normal, tex_normal);
-                cmd_list->SetBufferVertex(model->GetVertexBuffer());
-                cmd_list->SetBufferIndex(model->GetIndexBuffer());
-                cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
+                cmd_list->SetBufferVertex(draw.vertex_buffer);
+                cmd_list->SetBufferIndex(draw.index_buffer);
+                cmd_list->DrawIndexed(draw.index_count, draw.index_offset, draw.vertex_offset);
                 cmd_list->EndRenderPass();
             }
         }
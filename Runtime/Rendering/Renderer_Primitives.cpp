@@ -36,6 +36,7 @@ namespace Spartan
     void Renderer::TickPrimitives(const float delta_time)
     {
         // Remove lines which have expired
+        lock_guard<mutex> lock(m_lines_mutex);
 
         uint32_t end = static_cast<uint32_t>(m_lines_depth_disabled_duration.size());
         for (uint32_t i = 0; i < end; i++)
@@ -68,6 +69,8 @@ namespace Spartan
 
     void Renderer::DrawLine(const Vector3& from, const Vector3& to, const Vector4& color_from, const Vector4& color_to, const float duration /*= 0.0f*/, const bool depth /*= true*/)
     {
+        lock_guard<mutex> lock(m_lines_mutex);
+
         if (depth)
         {
             m_lines_depth_enabled.emplace_back(from, color_from);
@@ -95,7 +98,8 @@ namespace Spartan
 
     void Renderer::DrawRectangle(const Math::Rectangle& rectangle, const Math::Vector4& color /*= DebugColor*/, const float duration /*= 0.0f*/, bool depth /*= true*/)
     {
-        const float cam_z = m_camera->GetTransform()->GetPosition().z + m_camera->GetNearPlane() + 5.0f;
+        // Any thread can draw, so the camera is not read live
+        const float cam_z = m_lines_rectangle_z.load();
 
         DrawLine(Vector3(rectangle.left,    rectangle.top,      cam_z), Vector3(rectangle.right,    rectangle.top,      cam_z), color, color, duration, depth);
         DrawLine(Vector3(rectangle.right,   rectangle.top,      cam_z), Vector3(rectangle.right,    rectangle.bottom,   cam_z), color, color, duration, depth);
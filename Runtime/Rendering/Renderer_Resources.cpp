@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_Sampler.h"
 #include "../RHI/RHI_BlendState.h"
 #include "../RHI/RHI_ConstantBuffer.h"
+#include "../RHI/RHI_StructuredBuffer.h"
 #include "../RHI/RHI_RasterizerState.h"
 #include "../RHI/RHI_DepthStencilState.h"
 #include "../RHI/RHI_SwapChain.h"
@@ -59,6 +60,18 @@ namespace Spartan
 
         m_buffer_light_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device, "light", is_dynamic);
         m_buffer_light_gpu->Create<BufferLight>(m_swap_chain_buffer_count);
+
+        m_buffer_draw_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device, "draw", is_dynamic);
+        m_buffer_draw_gpu->Create<BufferDraw>(64);
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_cmd_lists.size()); i++)
+        {
+            m_buffer_instances_gpu.emplace_back(make_shared<RHI_StructuredBuffer>(m_rhi_device, "instances"));
+            m_buffer_instances_gpu.back()->Create<BufferInstance>(1024);
+
+            m_buffer_instance_indices_gpu.emplace_back(make_shared<RHI_StructuredBuffer>(m_rhi_device, "instance_indices"));
+            m_buffer_instance_indices_gpu.back()->Create<uint32_t>(1024);
+        }
     }
 
     void Renderer::CreateDepthStencilStates()
@@ -40,17 +40,17 @@ namespace Spartan
         m_flags = flags;
     }
 
-    ShaderLight* ShaderLight::GetVariation(Context* context, const Light* light, const uint64_t renderer_flags)
+    ShaderLight* ShaderLight::GetVariation(Context* context, const FramePacketLight& light, const uint64_t renderer_flags)
     {
         // Compute flags
         uint16_t flags = 0;
-        flags |= light->GetLightType() == LightType::Directional                                            ? Shader_Light_Directional              : flags;
-        flags |= light->GetLightType() == LightType::Point                                                  ? Shader_Light_Point                    : flags;
-        flags |= light->GetLightType() == LightType::Spot                                                   ? Shader_Light_Spot                     : flags;
-        flags |= light->GetShadowsEnabled()                                                                 ? Shader_Light_Shadows                  : flags;
-        flags |= (light->GetShadowsScreenSpaceEnabled() && (renderer_flags & Render_ScreenSpaceShadows))    ? Shader_Light_ShadowsScreenSpace       : flags;
-        flags |= light->GetShadowsTransparentEnabled()                                                      ? Shader_Light_ShadowsTransparent       : flags;
-        flags |= (light->GetVolumetricEnabled() && (renderer_flags & Render_VolumetricFog))                 ? Shader_Light_Volumetric               : flags;
+        flags |= light.type == LightType::Directional                                           ? Shader_Light_Directional              : flags;
+        flags |= light.type == LightType::Point                                                 ? Shader_Light_Point                    : flags;
+        flags |= light.type == LightType::Spot                                                  ? Shader_Light_Spot                     : flags;
+        flags |= light.shadows                                                                  ? Shader_Light_Shadows                  : flags;
+        flags |= (light.shadows_screen_space && (renderer_flags & Render_ScreenSpaceShadows))   ? Shader_Light_ShadowsScreenSpace       : flags;
+        flags |= light.shadows_transparent                                                      ? Shader_Light_ShadowsTransparent       : flags;
+        flags |= (light.volumetric && (renderer_flags & Render_VolumetricFog))                  ? Shader_Light_Volumetric               : flags;
 
         // Return existing shader, if it's already compiled
         if (m_variations.find(flags) != m_variations.end())
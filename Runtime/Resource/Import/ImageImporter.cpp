@@ -44,7 +44,6 @@ namespace Spartan::freeimage_helper
         uint32_t height         = 0;
         uint32_t channel_count  = 0;
         RHI_Texture_Mip* mip    = nullptr;
-        bool done               = false;
 
         RescaleJob(const uint32_t width, const uint32_t height, const uint32_t channel_count)
         {
@@ -285,36 +284,20 @@ namespace Spartan
         }
 
         // Parallelize mipmap generation using multiple threads (because FreeImage_Rescale() is expensive)
-        auto threading = m_context->GetSubsystem<Threading>();
-        for (auto& job : jobs)
+        m_context->GetSubsystem<Threading>()->ParallelFor(static_cast<uint32_t>(jobs.size()), [this, &jobs, &bitmap](uint32_t start, uint32_t end)
         {
-            threading->AddTask([this, &job, &bitmap]()
+            for (uint32_t i = start; i < end; i++)
             {
+                freeimage_helper::RescaleJob& job = jobs[i];
+
                 FIBITMAP* bitmap_scaled = FreeImage_Rescale(bitmap, job.width, job.height, freeimage_helper::rescale_filter);
                 if (!GetBitsFromFibitmap(job.mip, bitmap_scaled, job.width, job.height, job.channel_count))
                 {
                     LOG_ERROR("Failed to create mip level %dx%d", job.width, job.height);
                 }
                 FreeImage_Unload(bitmap_scaled);
-                job.done = true;
-            });
-        }
-
-        // Wait until all mipmaps have been generated
-        auto ready = false;
-        while (!ready)
-        {
-            ready = true;
-            for (const auto& job : jobs)
-            {
-                if (!job.done)
-                {
-                    ready = false;
-                }
             }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
-        }
+        }, 1); // every mip is a chunk of its own, as their cost is very uneven
     }
 
     FIBITMAP* ImageImporter::ApplyBitmapCorrections(FIBITMAP* bitmap) const
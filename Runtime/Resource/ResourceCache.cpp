@@ -34,6 +34,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_TextureCube.h"
 #include "../Audio/AudioClip.h"
 #include "../Rendering/Model.h"
+#include "../Threading/Threading.h"
 //====================================
 
 //= NAMESPACES ================
@@ -68,21 +69,29 @@ namespace Spartan
     ResourceCache::~ResourceCache()
     {
         // Unsubscribe from events
-        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldSaveStart,    SP_EVENT_HANDLER(SaveResourcesToFiles));
-        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldLoadStart,    SP_EVENT_HANDLER(LoadResourcesFromFiles));
-        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldClear,        SP_EVENT_HANDLER(Clear));
+        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldSaveStart);
+        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldLoadStart);
+        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldClear);
     }
 
     bool ResourceCache::OnInitialise()
     {
-        // Importers
-        m_importer_image    = make_shared<ImageImporter>(m_context);
-        m_importer_model    = make_shared<ModelImporter>(m_context);
-        m_importer_font     = make_shared<FontImporter>(m_context);
+        // Importers, their libraries are independent so they initialise concurrently
+        Threading* threading = m_context->GetSubsystem<Threading>();
+        const TaskHandle task_image = threading->AddTask([this]() { m_importer_image = make_shared<ImageImporter>(m_context); });
+        const TaskHandle task_model = threading->AddTask([this]() { m_importer_model = make_shared<ModelImporter>(m_context); });
+        m_importer_font = make_shared<FontImporter>(m_context);
+        threading->Wait(task_image);
+        threading->Wait(task_model);
 
         return true;
     }
 
+    SubsystemInitDesc ResourceCache::GetInitDesc() const
+    {
+        return { true, { SubsystemType::id<Settings> } };
+    }
+
     bool ResourceCache::IsCached(const string& resource_name, const ResourceType resource_type /*= Resource_Unknown*/)
     {
         if (resource_name.empty())
@@ -54,6 +54,7 @@ namespace Spartan
 
         //= Subsystem =============
         bool OnInitialise() override;
+        SubsystemInitDesc GetInitDesc() const override;
         //=========================
 
         // Get by name
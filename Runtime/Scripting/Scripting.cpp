@@ -86,6 +86,12 @@ namespace Spartan
         return true;
     }
 
+    SubsystemInitDesc Scripting::GetInitDesc() const
+    {
+        // Mono registers the initialising thread as its main thread, so this has to stay on the main thread
+        return { false, { SubsystemType::id<Settings>, SubsystemType::id<ResourceCache> } };
+    }
+
     uint32_t Scripting::Load(const std::string& file_path, Script* script_component)
     {
         if (!m_api_assembly_compiled)
@@ -48,6 +48,7 @@ namespace Spartan
 
         //= Subsystem =============
         bool OnInitialise() override;
+        SubsystemInitDesc GetInitDesc() const override;
         //=========================
 
         uint32_t Load(const std::string& file_path, Script* script_component);
@@ -50,12 +50,14 @@ namespace Spartan::ScriptingApi
     static void Transform_SetPosition(void* handle, _vector3 v) { static_cast<Transform*>(handle)->SetPosition(Math::Vector3(v.x, v.y, v.z)); }
 
     // Callbacks - Input
-    static bool Input_GetKey(const KeyCode key)       { return g_input->GetKey(key); }
-    static bool Input_GetKeyDown(const KeyCode key)   { return g_input->GetKeyDown(key); }
-    static bool Input_GetKeyUp(const KeyCode key)     { return g_input->GetKeyUp(key); }
-    static _vector2 Input_GetMousePosition()          { return _vector2{ g_input->GetMousePosition().x, g_input->GetMousePosition().y }; }
-    static _vector2 Input_GetMouseDelta()             { return _vector2{ g_input->GetMouseDelta().x, g_input->GetMouseDelta().y }; }
-    static float Input_GetMouseWheelDelta()           { return g_input->GetMouseWheelDelta().y; }
+    // A headless engine has no input, scripts see no keys pressed and a still mouse.
+    // Scripts tick in simulation steps, so edges and deltas are the ones accumulated since the previous step.
+    static bool Input_GetKey(const KeyCode key)       { return g_input ? g_input->GetKey(key) : false; }
+    static bool Input_GetKeyDown(const KeyCode key)   { return g_input ? g_input->GetKeyDownStep(key) : false; }
+    static bool Input_GetKeyUp(const KeyCode key)     { return g_input ? g_input->GetKeyUpStep(key) : false; }
+    static _vector2 Input_GetMousePosition()          { return g_input ? _vector2{ g_input->GetMousePosition().x, g_input->GetMousePosition().y } : _vector2{ 0.0f, 0.0f }; }
+    static _vector2 Input_GetMouseDelta()             { return g_input ? _vector2{ g_input->GetMouseDeltaStep().x, g_input->GetMouseDeltaStep().y } : _vector2{ 0.0f, 0.0f }; }
+    static float Input_GetMouseWheelDelta()           { return g_input ? g_input->GetMouseWheelDeltaStep().y : 0.0f; }
 
     // Callbacks - World
     static bool World_Save(const std::string& file_path) { return g_world->SaveToFile(file_path); }
@@ -0,0 +1,123 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====
+#include <atomic>
+#include <array>
+#include <cstdint>
+//================
+
+namespace Spartan
+{
+    class Task;
+
+    // A fixed capacity Chase-Lev work-stealing deque (see "Correct and Efficient Work-Stealing for Weak Memory Models").
+    // The owning thread pushes and pops at the bottom (LIFO), any other thread can steal from the top (FIFO).
+    class TaskDeque
+    {
+    public:
+        TaskDeque()
+        {
+            for (std::atomic<Task*>& slot : m_buffer)
+            {
+                slot.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        // Owner thread only, returns false if the deque is full
+        bool Push(Task* task)
+        {
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            const int64_t top    = m_top.load(std::memory_order_acquire);
+
+            if (bottom - top >= static_cast<int64_t>(m_capacity))
+                return false;
+
+            m_buffer[bottom & m_mask].store(task, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        // Owner thread only
+        Task* Pop()
+        {
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+
+            // Empty
+            if (top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Task* task = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+
+            // Last item, race against the thieves for it
+            if (top == bottom)
+            {
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    task = nullptr;
+                }
+
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return task;
+        }
+
+        // Any thread
+        Task* Steal()
+        {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return nullptr;
+
+            Task* task = m_buffer[top & m_mask].load(std::memory_order_relaxed);
+
+            // Lost the race against the owner or another thief
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+
+            return task;
+        }
+
+        bool IsEmpty() const { return m_top.load(std::memory_order_acquire) >= m_bottom.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr uint32_t m_capacity = 4096; // must be a power of two
+        static constexpr int64_t m_mask      = m_capacity - 1;
+
+        alignas(64) std::atomic<int64_t> m_top    = 0;
+        alignas(64) std::atomic<int64_t> m_bottom = 0;
+        alignas(64) std::array<std::atomic<Task*>, m_capacity> m_buffer;
+    };
+}
@@ -30,37 +30,107 @@ using namespace std;
 
 namespace Spartan
 {
+    // Every thread keeps a small cache of free tasks, so allocation is lock free in the common case.
+    // Caches refill from, and spill into, a shared free list in batches.
+    static const uint32_t task_pool_block_size = 256;
+    static const uint32_t task_pool_batch_size = 64;
+
+    struct TaskPool
+    {
+        mutex mutex_free;
+        Task* free = nullptr;
+        vector<unique_ptr<Task[]>> blocks;
+    };
+
+    static TaskPool& GetTaskPool()
+    {
+        static TaskPool pool;
+        return pool;
+    }
+
+    struct TaskCache
+    {
+        ~TaskCache()
+        {
+            // Hand the cached tasks back to the shared pool
+            if (!free)
+                return;
+
+            Task* last = free;
+            while (last->m_next)
+            {
+                last = last->m_next;
+            }
+
+            TaskPool& pool = GetTaskPool();
+            lock_guard<mutex> lock(pool.mutex_free);
+            last->m_next = pool.free;
+            pool.free    = free;
+        }
+
+        Task* free     = nullptr;
+        uint32_t count = 0;
+    };
+
+    static thread_local TaskCache task_cache;
+    static thread_local uint32_t thread_index_current       = numeric_limits<uint32_t>::max();
+    static thread_local uint32_t thread_random_state        = 0;
+    static thread_local uint32_t thread_run_depth           = 0; // a worker which waits executes other tasks, from within a task
+    static thread_local uint32_t thread_background_depth    = 0; // background tasks on this thread's stack, they all share one background slot
+    static thread_local TaskPriority thread_task_priority   = TaskPriority::Critical; // the priority of the task being executed, anything else is frame critical
+
     Threading::Threading(Context* context) : ISubsystem(context)
     {
-        m_stopping                               = false;
         m_thread_count_support                  = thread::hardware_concurrency();
-        m_thread_count                          = m_thread_count_support - 1; // exclude the main (this) thread
+        m_thread_count                          = m_thread_count_support > 1 ? m_thread_count_support - 1 : 0; // exclude the main (this) thread
+        m_thread_count_background_max           = m_thread_count > 1 ? m_thread_count - 1 : 0; // always leave a worker for frame critical work, see ResolvePriority()
         m_thread_names[this_thread::get_id()]   = "main";
 
+        for (uint32_t i = 0; i < m_priority_count; i++)
+        {
+            m_tasks_shared_count[i] = 0;
+            m_tasks_pending[i]      = 0;
+        }
+
+        // Create the queues first, as the threads are allowed to steal from any of them as soon as they start
+        for (vector<unique_ptr<TaskDeque>>& task_deques : m_task_deques)
+        {
+            for (uint32_t i = 0; i < m_thread_count; i++)
+            {
+                task_deques.emplace_back(make_unique<TaskDeque>());
+            }
+        }
+        m_worker_counters = make_unique<WorkerCounters[]>(m_thread_count + m_thread_count_io);
+
         for (uint32_t i = 0; i < m_thread_count; i++)
         {
-            m_threads.emplace_back(thread(&Threading::ThreadLoop, this));
+            m_threads.emplace_back(thread(&Threading::ThreadLoop, this, i));
             m_thread_names[m_threads.back().get_id()] = "worker_" + to_string(i);
         }
 
-        LOG_INFO("%d threads have been created", m_thread_count);
+        // The io threads spend most of their time blocked, so they come on top of the workers
+        for (uint32_t i = 0; i < m_thread_count_io; i++)
+        {
+            m_threads.emplace_back(thread(&Threading::ThreadLoopIo, this, m_thread_count + i));
+            m_thread_names[m_threads.back().get_id()] = "io_" + to_string(i);
+        }
+
+        LOG_INFO("%d threads and %d io threads have been created", m_thread_count, m_thread_count_io);
     }
 
     Threading::~Threading()
     {
         Flush(true);
 
-        // Put unique lock on task mutex.
-        unique_lock<mutex> lock(m_mutex_tasks);
-
         // Set termination flag to true.
         m_stopping = true;
 
-        // Unlock the mutex
-        lock.unlock();
-
         // Wake up all threads.
+        {
+            lock_guard<mutex> lock(m_mutex_sleep);
+        }
         m_condition_var.notify_all();
+        m_condition_var_io.notify_all();
 
         // Join all threads.
         for (auto& thread : m_threads)
@@ -74,14 +144,39 @@ namespace Spartan
 
     uint32_t Threading::GetThreadsAvailable() const
     {
-        uint32_t available_threads = m_thread_count;
+        return m_thread_count - m_threads_busy.load(memory_order_relaxed);
+    }
+
+    bool Threading::AreTasksRunning() const
+    {
+        uint32_t tasks = m_tasks_executing.load();
+        for (const atomic<uint32_t>& tasks_pending : m_tasks_pending)
+        {
+            tasks += tasks_pending.load();
+        }
+
+        return tasks != 0;
+    }
 
-        for (const auto& task : m_tasks)
+    void Threading::GetStats(ThreadingStats& stats) const
+    {
+        stats.tasks_pending = 0;
+        for (const atomic<uint32_t>& tasks_pending : m_tasks_pending)
         {
-            available_threads -= task->IsExecuting() ? 1 : 0;
+            stats.tasks_pending += tasks_pending.load(memory_order_relaxed);
         }
+        stats.tasks_executing   = m_tasks_executing.load(memory_order_relaxed);
+        stats.tasks_completed   = 0;
+        stats.workers.resize(m_thread_count + m_thread_count_io);
 
-        return available_threads;
+        for (uint32_t i = 0; i < m_thread_count + m_thread_count_io; i++)
+        {
+            WorkerStats& worker     = stats.workers[i];
+            worker.busy_time_ns     = m_worker_counters[i].busy_time_ns.load(memory_order_relaxed);
+            worker.task_count       = m_worker_counters[i].task_count.load(memory_order_relaxed);
+            worker.steal_count      = m_worker_counters[i].steal_count.load(memory_order_relaxed);
+            stats.tasks_completed   += worker.task_count;
+        }
     }
 
     void Threading::Flush(bool remove_queued /*= false*/)
@@ -89,42 +184,535 @@ namespace Spartan
         // Clear any queued tasks
         if (remove_queued)
         {
-            m_tasks.clear();
+            {
+                lock_guard<mutex> lock(m_mutex_tasks_shared);
+                for (uint32_t i = 0; i < m_priority_count; i++)
+                {
+                    for (Task* task : m_tasks_shared[i])
+                    {
+                        Discard(task);
+                    }
+                    m_tasks_shared[i].clear();
+                    m_tasks_shared_count[i] = 0;
+                }
+            }
+
+            // Stealing is allowed from any thread, so the worker queues can be drained from here
+            for (const vector<unique_ptr<TaskDeque>>& task_deques : m_task_deques)
+            {
+                for (const unique_ptr<TaskDeque>& task_deque : task_deques)
+                {
+                    while (!task_deque->IsEmpty())
+                    {
+                        if (Task* task = task_deque->Steal())
+                        {
+                            Discard(task);
+                        }
+                    }
+                }
+            }
         }
 
         // If so, wait for them
-        while (AreTasksRunning())
+        unique_lock<mutex> lock(m_mutex_wait);
+        m_threads_waiting.fetch_add(1);
+        m_condition_var_wait.wait(lock, [this] { return !AreTasksRunning(); });
+        m_threads_waiting.fetch_sub(1);
+    }
+
+    template <typename Predicate>
+    void Threading::WaitUntil(Predicate&& predicate)
+    {
+        if (predicate())
+            return;
+
+        // A worker can't block, what it waits for might be sitting in its own queue, so it helps instead
+        if (thread_index_current < m_thread_count)
+        {
+            while (!predicate())
+            {
+                if (Task* task = GetTask(thread_index_current))
+                {
+                    Run(task);
+                }
+                else
+                {
+                    this_thread::yield();
+                }
+            }
+
+            return;
+        }
+
+        // Any other thread (including the io threads) sleeps
+        unique_lock<mutex> lock(m_mutex_wait);
+        m_threads_waiting.fetch_add(1);
+        m_condition_var_wait.wait(lock, predicate);
+        m_threads_waiting.fetch_sub(1);
+    }
+
+    void Threading::Wait(const TaskHandle& handle)
+    {
+        WaitUntil([&handle] { return handle.IsCompleted(); });
+    }
+
+    void Threading::ParallelFor(const uint32_t range, uint32_t grain_size, void (*invoke)(void*, uint32_t, uint32_t), void* function)
+    {
+        if (range == 0)
+            return;
+
+        // Aim for a few chunks per thread, so that threads which finish early (or join late) can balance the load
+        if (grain_size == 0)
+        {
+            const uint32_t chunk_count_target = (m_thread_count + 1) * 4;
+            grain_size = max(range / chunk_count_target, 1u);
+        }
+
+        const uint32_t chunk_count = (range + grain_size - 1) / grain_size;
+
+        // Not worth going wide
+        if (chunk_count == 1 || m_thread_count == 0)
+        {
+            invoke(function, 0, range);
+            return;
+        }
+
+        // The state is shared with the helpers, as a helper might only start after this call has returned (and find nothing to do)
+        shared_ptr<ParallelForState> state = make_shared<ParallelForState>();
+        state->chunk_count  = chunk_count;
+        state->chunk_size   = grain_size;
+        state->range        = range;
+        state->invoke       = invoke;
+        state->function     = function;
+
+        // The helpers inherit the priority of the caller, io threads can't help so their loops run in the background
+        const TaskPriority priority = thread_task_priority == TaskPriority::Io ? TaskPriority::Background : thread_task_priority;
+
+        // Kick off helpers, the calling thread takes one of the chunks itself
+        const uint32_t helper_count = min(m_thread_count, chunk_count - 1);
+        for (uint32_t i = 0; i < helper_count; i++)
+        {
+            AddTask([this, state]() { ParallelForExecute(*state); }, priority);
+        }
+
+        ParallelForExecute(*state);
+
+        // Wait for the chunks which are still being executed by the helpers
+        WaitUntil([&state] { return state->chunk_done.load() == state->chunk_count; });
+    }
+
+    void Threading::ParallelForExecute(ParallelForState& state)
+    {
+        uint32_t chunk_index = state.chunk_next.fetch_add(1);
+        while (chunk_index < state.chunk_count)
+        {
+            const uint32_t start = chunk_index * state.chunk_size;
+            const uint32_t end   = min(start + state.chunk_size, state.range);
+            state.invoke(state.function, start, end);
+
+            // The last chunk wakes up whoever waits for the loop
+            if (state.chunk_done.fetch_add(1) + 1 == state.chunk_count)
+            {
+                NotifyWaiters();
+            }
+
+            chunk_index = state.chunk_next.fetch_add(1);
+        }
+    }
+
+    void Threading::Submit(Task* task)
+    {
+        const TaskPriority priority     = task->m_priority;
+        const uint32_t priority_index   = static_cast<uint32_t>(priority);
+
+        // Count the task before it becomes visible, so that a thread which picks it up never observes an underflow
+        m_tasks_pending[priority_index].fetch_add(1);
+
+        // Workers push compute work to their own queue, which requires no locking
+        const bool pushed = priority != TaskPriority::Io && thread_index_current < m_thread_count && m_task_deques[priority_index][thread_index_current]->Push(task);
+
+        // Anyone else (or a worker with a full queue) goes through the shared queue
+        if (!pushed)
+        {
+            lock_guard<mutex> lock(m_mutex_tasks_shared);
+            m_tasks_shared[priority_index].push_back(task);
+            m_tasks_shared_count[priority_index].fetch_add(1);
+        }
+
+        WakeWorker(priority);
+    }
+
+    void Threading::SubmitAfter(Task* task, const vector<TaskHandle>& dependencies)
+    {
+        // Hold an extra dependency while registering, so that the task can't be submitted by a dependency which completes in the meantime
+        task->m_dependency_count.store(1);
+
+        for (const TaskHandle& dependency : dependencies)
+        {
+            Task* parent = dependency.m_task;
+            if (!parent)
+                continue;
+
+            while (parent->m_continuations_lock.test_and_set(memory_order_acquire));
+            if (!parent->m_completed.load())
+            {
+                task->m_dependency_count.fetch_add(1);
+                parent->m_continuations.emplace_back(task);
+            }
+            parent->m_continuations_lock.clear(memory_order_release);
+        }
+
+        if (task->m_dependency_count.fetch_sub(1) == 1)
+        {
+            Submit(task);
+        }
+    }
+
+    void Threading::WakeWorker(const TaskPriority priority)
+    {
+        // Only lock if someone is actually sleeping
+        atomic<uint32_t>& threads_sleeping  = priority == TaskPriority::Io ? m_threads_sleeping_io : m_threads_sleeping;
+        condition_variable& condition_var   = priority == TaskPriority::Io ? m_condition_var_io : m_condition_var;
+        if (threads_sleeping.load() != 0)
+        {
+            {
+                lock_guard<mutex> lock(m_mutex_sleep);
+            }
+            condition_var.notify_one();
+        }
+    }
+
+    bool Threading::HasWork() const
+    {
+        if (m_tasks_pending[static_cast<uint32_t>(TaskPriority::Critical)].load() != 0 || m_tasks_pending[static_cast<uint32_t>(TaskPriority::Normal)].load() != 0)
+            return true;
+
+        return m_tasks_pending[static_cast<uint32_t>(TaskPriority::Background)].load() != 0 && m_threads_background.load() < m_thread_count_background_max;
+    }
+
+    Task* Threading::GetTask(const uint32_t thread_index)
+    {
+        if (Task* task = GetTask(thread_index, TaskPriority::Critical))
+            return task;
+
+        if (Task* task = GetTask(thread_index, TaskPriority::Normal))
+            return task;
+
+        if (m_tasks_pending[static_cast<uint32_t>(TaskPriority::Background)].load() == 0)
+            return nullptr;
+
+        // Background work needs a slot, unless this thread already holds one (it waits from within a background task)
+        if (thread_background_depth != 0)
+            return GetTask(thread_index, TaskPriority::Background);
+
+        uint32_t threads_background = m_threads_background.load();
+        do
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            if (threads_background >= m_thread_count_background_max)
+                return nullptr;
+        } while (!m_threads_background.compare_exchange_weak(threads_background, threads_background + 1));
+
+        // The slot is released by Run(), once the task has been executed
+        if (Task* task = GetTask(thread_index, TaskPriority::Background))
+            return task;
+
+        m_threads_background.fetch_sub(1);
+        return nullptr;
+    }
+
+    Task* Threading::GetTask(const uint32_t thread_index, const TaskPriority priority)
+    {
+        const uint32_t priority_index                   = static_cast<uint32_t>(priority);
+        const vector<unique_ptr<TaskDeque>>& task_deques = m_task_deques[priority_index];
+
+        // Own queue
+        if (Task* task = task_deques[thread_index]->Pop())
+            return task;
+
+        // Shared queue
+        if (Task* task = GetTaskShared(priority))
+            return task;
+
+        // Steal from the other workers, starting from a random one so that thieves don't all pick the same victim
+        thread_random_state ^= thread_random_state << 13;
+        thread_random_state ^= thread_random_state >> 17;
+        thread_random_state ^= thread_random_state << 5;
+        const uint32_t victim_first = thread_random_state % m_thread_count;
+        for (uint32_t i = 0; i < m_thread_count; i++)
+        {
+            const uint32_t victim = (victim_first + i) % m_thread_count;
+            if (victim == thread_index)
+                continue;
+
+            if (Task* task = task_deques[victim]->Steal())
+            {
+                m_worker_counters[thread_index].steal_count.fetch_add(1, memory_order_relaxed);
+                return task;
+            }
         }
+
+        return nullptr;
     }
 
-    void Threading::ThreadLoop()
+    Task* Threading::GetTaskShared(const TaskPriority priority)
     {
-        shared_ptr<Task> task;
+        const uint32_t priority_index = static_cast<uint32_t>(priority);
+
+        // Only lock if there is something in it
+        if (m_tasks_shared_count[priority_index].load() == 0)
+            return nullptr;
+
+        lock_guard<mutex> lock(m_mutex_tasks_shared);
+        deque<Task*>& tasks = m_tasks_shared[priority_index];
+        if (tasks.empty())
+            return nullptr;
+
+        Task* task = tasks.front();
+        tasks.pop_front();
+        m_tasks_shared_count[priority_index].fetch_sub(1);
+        return task;
+    }
+
+    void Threading::Run(Task* task)
+    {
+        // Tasks only run on workers, nested runs happen when a task waits and are part of the outer task's busy time
+        WorkerCounters& counters            = m_worker_counters[thread_index_current];
+        const TaskPriority priority         = task->m_priority;
+        const TaskPriority priority_outer   = thread_task_priority;
+        const bool is_outermost             = thread_run_depth++ == 0;
+        const bool is_worker                = thread_index_current < m_thread_count;
+        const bool is_background            = priority == TaskPriority::Background;
+        chrono::high_resolution_clock::time_point time_start;
+        if (is_outermost)
+        {
+            if (is_worker)
+            {
+                m_threads_busy.fetch_add(1, memory_order_relaxed);
+            }
+            time_start = chrono::high_resolution_clock::now();
+        }
+        thread_task_priority = priority;
+        thread_background_depth += is_background ? 1 : 0;
+
+        // Mark as executing before it stops being pending, so AreTasksRunning() never sees a gap
+        m_tasks_executing.fetch_add(1);
+        m_tasks_pending[static_cast<uint32_t>(priority)].fetch_sub(1);
+
+        task->Execute();
+        Complete(task, false);
+
+        m_tasks_executing.fetch_sub(1);
+        NotifyWaiters();
+
+        // Release the background slot, and hand it to a sleeping worker if there is more background work
+        if (is_background && --thread_background_depth == 0)
+        {
+            m_threads_background.fetch_sub(1);
+            if (m_tasks_pending[static_cast<uint32_t>(TaskPriority::Background)].load() != 0)
+            {
+                WakeWorker(TaskPriority::Background);
+            }
+        }
+        thread_task_priority = priority_outer;
+
+        counters.task_count.fetch_add(1, memory_order_relaxed);
+        if (is_outermost)
+        {
+            const uint64_t duration = chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() - time_start).count();
+            counters.busy_time_ns.fetch_add(duration, memory_order_relaxed);
+            if (is_worker)
+            {
+                m_threads_busy.fetch_sub(1, memory_order_relaxed);
+            }
+        }
+        thread_run_depth--;
+    }
+
+    void Threading::Complete(Task* task, const bool cancelled)
+    {
+        vector<Task*> continuations;
+
+        while (task->m_continuations_lock.test_and_set(memory_order_acquire));
+        task->m_completed.store(true);
+        continuations.swap(task->m_continuations);
+        task->m_continuations_lock.clear(memory_order_release);
+
+        // A cancelled task cancels everything that depends on it
+        for (Task* continuation : continuations)
+        {
+            if (continuation->m_dependency_count.fetch_sub(1) == 1)
+            {
+                if (cancelled)
+                {
+                    continuation->Reset();
+                    Complete(continuation, true);
+                }
+                else
+                {
+                    Submit(continuation);
+                }
+            }
+        }
+
+        // Drop the reference held by the scheduler
+        TaskRelease(task);
+    }
+
+    void Threading::Discard(Task* task)
+    {
+        const TaskPriority priority = task->m_priority;
+        task->Reset();
+        Complete(task, true);
+        m_tasks_pending[static_cast<uint32_t>(priority)].fetch_sub(1);
+        NotifyWaiters();
+    }
+
+    void Threading::NotifyWaiters()
+    {
+        // Only lock if someone is actually waiting
+        if (m_threads_waiting.load() != 0)
+        {
+            {
+                lock_guard<mutex> lock(m_mutex_wait);
+            }
+            m_condition_var_wait.notify_all();
+        }
+    }
+
+    void Threading::ThreadLoop(const uint32_t thread_index)
+    {
+        thread_index_current = thread_index;
+        thread_random_state  = thread_index + 1; // xorshift state can't be zero
+
         while (true)
         {
-            // Lock tasks mutex
-            unique_lock<mutex> lock(m_mutex_tasks);
+            if (Task* task = GetTask(thread_index))
+            {
+                Run(task);
+                continue;
+            }
 
-            // Check condition on notification
-            m_condition_var.wait(lock, [this] { return !m_tasks.empty() || m_stopping; });
+            // If m_stopping is true, it's time to shut everything down
+            if (m_stopping)
+                return;
+
+            // Nothing to do, sleep until a task is submitted (or a background slot frees up)
+            unique_lock<mutex> lock(m_mutex_sleep);
+            m_threads_sleeping.fetch_add(1);
+            m_condition_var.wait(lock, [this] { return HasWork() || m_stopping; });
+            m_threads_sleeping.fetch_sub(1);
+        }
+    }
+
+    void Threading::ThreadLoopIo(const uint32_t thread_index)
+    {
+        thread_index_current = thread_index;
+
+        while (true)
+        {
+            if (Task* task = GetTaskShared(TaskPriority::Io))
+            {
+                Run(task);
+                continue;
+            }
 
             // If m_stopping is true, it's time to shut everything down
-            if (m_stopping && m_tasks.empty())
+            if (m_stopping)
                 return;
 
-            // Get next task in the queue.
-            task = m_tasks.front();
+            // Nothing to do, sleep until an io task is submitted
+            unique_lock<mutex> lock(m_mutex_sleep);
+            m_threads_sleeping_io.fetch_add(1);
+            m_condition_var_io.wait(lock, [this] { return m_tasks_pending[static_cast<uint32_t>(TaskPriority::Io)].load() != 0 || m_stopping; });
+            m_threads_sleeping_io.fetch_sub(1);
+        }
+    }
+
+    Task* Threading::TaskAllocate()
+    {
+        TaskCache& cache = task_cache;
+
+        // Refill the cache, from the shared pool if possible, otherwise with a new block
+        if (!cache.free)
+        {
+            TaskPool& pool = GetTaskPool();
+            lock_guard<mutex> lock(pool.mutex_free);
+
+            while (pool.free && cache.count < task_pool_batch_size)
+            {
+                Task* task  = pool.free;
+                pool.free   = task->m_next;
+                task->m_next = cache.free;
+                cache.free  = task;
+                cache.count++;
+            }
+
+            if (!cache.free)
+            {
+                pool.blocks.emplace_back(make_unique<Task[]>(task_pool_block_size));
+                Task* block = pool.blocks.back().get();
+                for (uint32_t i = 0; i < task_pool_block_size; i++)
+                {
+                    block[i].m_next = cache.free;
+                    cache.free      = &block[i];
+                }
+                cache.count += task_pool_block_size;
+            }
+        }
+
+        Task* task   = cache.free;
+        cache.free   = task->m_next;
+        task->m_next = nullptr;
+        cache.count--;
+
+        // Reset the graph state, the scheduler holds the first reference
+        task->m_ref_count.store(1, memory_order_relaxed);
+        task->m_dependency_count.store(0, memory_order_relaxed);
+        task->m_completed.store(false, memory_order_relaxed);
+
+        return task;
+    }
+
+    void Threading::TaskFree(Task* task)
+    {
+        TaskCache& cache = task_cache;
+
+        task->m_next = cache.free;
+        cache.free   = task;
+        cache.count++;
+
+        // Tasks are usually allocated by one thread and freed by another, so spill the excess back to the shared pool
+        if (cache.count > task_pool_batch_size * 2)
+        {
+            Task* first = cache.free;
+            Task* last  = first;
+            for (uint32_t i = 1; i < task_pool_batch_size; i++)
+            {
+                last = last->m_next;
+            }
+            cache.free  = last->m_next;
+            cache.count -= task_pool_batch_size;
 
-            // Remove it from the queue.
-            m_tasks.pop_front();
+            TaskPool& pool = GetTaskPool();
+            lock_guard<mutex> lock(pool.mutex_free);
+            last->m_next = pool.free;
+            pool.free    = first;
+        }
+    }
 
-            // Unlock the mutex
-            lock.unlock();
+    void Threading::TaskRelease(Task* task)
+    {
+        if (task->m_ref_count.fetch_sub(1, memory_order_acq_rel) == 1)
+        {
+            TaskFree(task);
+        }
+    }
 
-            // Execute the task.
-            task->Execute();
+    TaskHandle::~TaskHandle()
+    {
+        if (m_task)
+        {
+            Threading::TaskRelease(m_task);
         }
     }
 }
@@ -26,26 +26,128 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <thread>
 #include <mutex>
 #include <deque>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <condition_variable>
 #include <unordered_map>
-#include <functional>
+#include "TaskDeque.h"
 #include "../Logging/Log.h"
 #include "../Core/ISubsystem.h"
 //=============================
 
 namespace Spartan
 {
+    enum class TaskPriority : uint8_t
+    {
+        Critical,   // Work that the current frame waits on, e.g. a ParallelFor() from the main thread
+        Normal,
+        Background, // Long running work, it's never allowed to occupy all of the workers
+        Io,         // Blocking work (file reads, imports, world loads), executed by a dedicated pool of threads
+        Count
+    };
+
+    // A type erased callable. Callables which fit in the inline storage are constructed in place,
+    // larger ones fall back to the heap. Tasks themselves are recycled through the task pool.
     class Task
     {
     public:
-        typedef std::function<void()> function_type;
+        static constexpr uint32_t storage_size = 96;
+
+        Task() = default;
+        ~Task() { Reset(); }
+
+        template <typename Function>
+        void Set(Function&& function)
+        {
+            using function_type = std::decay_t<Function>;
+
+            if constexpr (sizeof(function_type) <= storage_size && alignof(function_type) <= alignof(std::max_align_t))
+            {
+                new (m_storage) function_type(std::forward<Function>(function));
+                m_invoke  = [](void* storage) { (*static_cast<function_type*>(storage))(); };
+                m_destroy = [](void* storage) { static_cast<function_type*>(storage)->~function_type(); };
+            }
+            else
+            {
+                *reinterpret_cast<function_type**>(m_storage) = new function_type(std::forward<Function>(function));
+                m_invoke  = [](void* storage) { (**static_cast<function_type**>(storage))(); };
+                m_destroy = [](void* storage) { delete *static_cast<function_type**>(storage); };
+            }
+        }
 
-        Task(function_type&& function)  { m_function = std::forward<function_type>(function); }
-        void Execute()                  { m_is_executing = true; m_function(); m_is_executing = false; }
-        bool IsExecuting() const { return m_is_executing; }
+        void Execute()
+        {
+            m_invoke(m_storage);
+            Reset();
+        }
+
+        // Destroys the callable without invoking it
+        void Reset()
+        {
+            if (m_destroy)
+            {
+                m_destroy(m_storage);
+            }
+
+            m_invoke  = nullptr;
+            m_destroy = nullptr;
+        }
+
+        // Intrusive link, used by the task pool
+        Task* m_next = nullptr;
+
+        TaskPriority m_priority = TaskPriority::Normal;
+
+        // Graph state
+        std::atomic<uint32_t> m_ref_count           = 0;     // the scheduler holds one reference until completion, every TaskHandle holds another
+        std::atomic<uint32_t> m_dependency_count    = 0;     // unfinished tasks this task waits on
+        std::atomic<bool> m_completed               = false;
+        std::atomic_flag m_continuations_lock       = ATOMIC_FLAG_INIT;
+        std::vector<Task*> m_continuations;                  // tasks waiting on this task
 
     private:
-        bool m_is_executing = false;
-        function_type m_function;
+        alignas(std::max_align_t) unsigned char m_storage[storage_size];
+        void (*m_invoke)(void*)  = nullptr;
+        void (*m_destroy)(void*) = nullptr;
+    };
+
+    // A reference to a submitted task, which can be waited on or used as a dependency of other tasks.
+    // A default constructed handle refers to no task and counts as completed.
+    class TaskHandle
+    {
+    public:
+        TaskHandle() = default;
+        TaskHandle(const TaskHandle& other) : m_task(other.m_task) { if (m_task) m_task->m_ref_count.fetch_add(1, std::memory_order_relaxed); }
+        TaskHandle(TaskHandle&& other) noexcept : m_task(other.m_task) { other.m_task = nullptr; }
+        TaskHandle& operator=(TaskHandle other) noexcept { std::swap(m_task, other.m_task); return *this; }
+        ~TaskHandle();
+
+        bool IsValid()      const { return m_task != nullptr; }
+        bool IsCompleted()  const { return !m_task || m_task->m_completed.load(std::memory_order_acquire); }
+
+    private:
+        friend class Threading;
+        explicit TaskHandle(Task* task) : m_task(task) { m_task->m_ref_count.fetch_add(1, std::memory_order_relaxed); }
+
+        Task* m_task = nullptr;
+    };
+
+    struct WorkerStats
+    {
+        uint64_t busy_time_ns   = 0; // time spent executing tasks
+        uint64_t task_count     = 0; // tasks executed
+        uint64_t steal_count    = 0; // tasks taken from the queue of another worker
+    };
+
+    struct ThreadingStats
+    {
+        uint32_t tasks_pending      = 0; // tasks waiting in a queue
+        uint32_t tasks_executing    = 0; // tasks being executed right now
+        uint64_t tasks_completed    = 0; // tasks executed since startup
+        std::vector<WorkerStats> workers; // the workers, followed by the io threads
     };
 
     class Threading : public ISubsystem
@@ -54,88 +156,184 @@ namespace Spartan
         Threading(Context* context);
         ~Threading();
 
-        // Add a task
+        // Add a task, can be called from any thread
         template <typename Function>
-        void AddTask(Function&& function)
+        TaskHandle AddTask(Function&& function, TaskPriority priority = TaskPriority::Normal)
         {
-            if (m_threads.empty())
+            priority = ResolvePriority(priority);
+            if (!CanRunAsync(priority))
             {
                 LOG_WARNING("No available threads, function will execute in the same thread");
                 function();
-                return;
+                return TaskHandle();
             }
 
-            // Lock tasks mutex
-            std::unique_lock<std::mutex> lock(m_mutex_tasks);
-
-            // Save the task
-            m_tasks.push_back(std::make_shared<Task>(std::bind(std::forward<Function>(function))));
-
-            // Unlock the mutex
-            lock.unlock();
+            Task* task          = TaskAllocate();
+            task->m_priority    = priority;
+            task->Set(std::forward<Function>(function));
+            TaskHandle handle(task);
+            Submit(task);
 
-            // Wake up a thread
-            m_condition_var.notify_one();
+            return handle;
         }
 
-        // Adds a task which is a loop and executes chunks of it in parallel
+        // Add a task which will only start once all of the dependencies have completed
         template <typename Function>
-        void AddTaskLoop(Function&& function, uint32_t range)
+        TaskHandle AddTask(Function&& function, const std::vector<TaskHandle>& dependencies, TaskPriority priority = TaskPriority::Normal)
         {
-            uint32_t available_threads      = GetThreadsAvailable();
-            std::vector<bool> tasks_done    = std::vector<bool>(available_threads, false);
-            const uint32_t task_count       = available_threads + 1; // plus one for the current thread
-
-            uint32_t start  = 0;
-            uint32_t end    = 0;
-            for (uint32_t i = 0; i < available_threads; i++)
+            priority = ResolvePriority(priority);
+            if (!CanRunAsync(priority))
             {
-                start   = (range / task_count) * i;
-                end     = start + (range / task_count);
-
-                // Kick off task
-                AddTask([&function, &tasks_done, i, start, end] { function(start, end); tasks_done[i] = true; });
+                LOG_WARNING("No available threads, function will execute in the same thread");
+                for (const TaskHandle& dependency : dependencies)
+                {
+                    Wait(dependency);
+                }
+                function();
+                return TaskHandle();
             }
 
-            // Do last task in the current thread
-            function(end, range);
+            Task* task          = TaskAllocate();
+            task->m_priority    = priority;
+            task->Set(std::forward<Function>(function));
+            TaskHandle handle(task);
+            SubmitAfter(task, dependencies);
 
-            // Wait till the threads are done
-            uint32_t tasks = 0;
-            while (tasks != tasks_done.size())
-            {
-                tasks = 0;
-                for (const bool job_done : tasks_done)
-                {
-                    tasks += job_done ? 1 : 0;
-                }
+            return handle;
+        }
 
-                std::this_thread::sleep_for(std::chrono::milliseconds(16));
-            }
+        // Executes function(start, end) over [0, range) in parallel and returns once all of it has been executed.
+        // The range is split into chunks which are claimed by the workers and the calling thread alike, so whoever
+        // is free takes the next chunk. A grain size of zero picks one, based on the range and the thread count.
+        // The chunks inherit the priority of the calling task, they are frame critical when called from the main thread.
+        template <typename Function>
+        void ParallelFor(const uint32_t range, Function&& function, const uint32_t grain_size = 0)
+        {
+            using function_type = std::remove_reference_t<Function>;
+
+            ParallelFor(range, grain_size, [](void* function, uint32_t start, uint32_t end)
+            {
+                (*static_cast<function_type*>(function))(start, end);
+            }, const_cast<void*>(static_cast<const void*>(&function)));
         }
 
-        // Get the number of threads used
+        // Get the number of threads used (excluding the io threads)
         uint32_t GetThreadCount()           const { return m_thread_count; }
+        // Get the number of threads dedicated to blocking io
+        uint32_t GetThreadCountIo()         const { return m_thread_count_io; }
         // Get the maximum number of threads the hardware supports
         uint32_t GetThreadCountSupport()    const { return m_thread_count_support; }
         // Get the number of threads which are not doing any work
         uint32_t GetThreadsAvailable()      const;
-        // Returns true if at least one task is running
-        bool AreTasksRunning()              const { return GetThreadsAvailable() != GetThreadCount(); }
+        // Returns true if at least one task is running or waiting to run
+        bool AreTasksRunning()              const;
+        // Get a snapshot of the counters, the worker counters accumulate since startup
+        void GetStats(ThreadingStats& stats) const;
         // Waits for all executing (and queued if requested) tasks to finish
         void Flush(bool remove_queued = false);
+        // Waits for a task to complete. Workers execute other tasks while waiting, any other thread sleeps until woken up.
+        void Wait(const TaskHandle& handle);
 
     private:
-        // This function is invoked by the threads
-        void ThreadLoop();
+        friend class TaskHandle;
+
+        // The state of a ParallelFor() call, shared with the worker threads which help executing it
+        struct ParallelForState
+        {
+            std::atomic<uint32_t> chunk_next    = 0;
+            std::atomic<uint32_t> chunk_done    = 0;
+            uint32_t chunk_count                = 0;
+            uint32_t chunk_size                 = 0;
+            uint32_t range                      = 0;
+            void (*invoke)(void*, uint32_t, uint32_t);
+            void* function;
+        };
 
-        uint32_t m_thread_count         = 0;
-        uint32_t m_thread_count_support = 0;
+        // These functions are invoked by the threads
+        void ThreadLoop(uint32_t thread_index);
+        void ThreadLoopIo(uint32_t thread_index);
+        // Returns false if there are no threads which can execute tasks of the given priority
+        bool CanRunAsync(const TaskPriority priority) const { return priority == TaskPriority::Io ? m_thread_count_io != 0 : m_thread_count != 0; }
+        // Without a worker to spare, background work goes to the io threads so that it never takes the only worker
+        TaskPriority ResolvePriority(const TaskPriority priority) const { return priority == TaskPriority::Background && m_thread_count_background_max == 0 ? TaskPriority::Io : priority; }
+        // Pushes a task to the queue of the calling worker, or to the shared queue when called from any other thread
+        void Submit(Task* task);
+        // Submits a task once all of its dependencies have completed
+        void SubmitAfter(Task* task, const std::vector<TaskHandle>& dependencies);
+        // Looks for work in order of priority, background work is only picked up if a background slot is free
+        Task* GetTask(uint32_t thread_index);
+        // Looks for work in the own queue first, then in the shared queue, then steals from other workers
+        Task* GetTask(uint32_t thread_index, TaskPriority priority);
+        // Takes a task from the shared queue of the given priority
+        Task* GetTaskShared(TaskPriority priority);
+        // Returns true if a worker has work it's allowed to pick up
+        bool HasWork() const;
+        // Wakes up a worker, only locks if one is actually sleeping
+        void WakeWorker(TaskPriority priority);
+        // Executes a task which was taken from a queue
+        void Run(Task* task);
+        // Marks a task as completed and releases (or cancels) the tasks which depend on it
+        void Complete(Task* task, bool cancelled);
+        // Removes a queued task without running it
+        void Discard(Task* task);
+        // Wakes up any thread sleeping in Wait() or Flush()
+        void NotifyWaiters();
+        // Blocks until the predicate returns true, see Wait()
+        template <typename Predicate>
+        void WaitUntil(Predicate&& predicate);
+        // Type erased ParallelFor()
+        void ParallelFor(uint32_t range, uint32_t grain_size, void (*invoke)(void*, uint32_t, uint32_t), void* function);
+        // Claims and executes chunks until there are none left
+        void ParallelForExecute(ParallelForState& state);
+
+        // Task pool
+        static Task* TaskAllocate();
+        static void TaskFree(Task* task);
+        static void TaskRelease(Task* task);
+
+        static constexpr uint32_t m_priority_count = static_cast<uint32_t>(TaskPriority::Count);
+        static constexpr uint32_t m_priority_count_compute = static_cast<uint32_t>(TaskPriority::Io); // priorities executed by the workers
+
+        uint32_t m_thread_count                 = 0;
+        uint32_t m_thread_count_io              = 2;
+        uint32_t m_thread_count_support         = 0;
+        uint32_t m_thread_count_background_max  = 0;
         std::vector<std::thread> m_threads;
-        std::deque<std::shared_ptr<Task>> m_tasks;
-        std::mutex m_mutex_tasks;
-        std::condition_variable m_condition_var;
         std::unordered_map<std::thread::id, std::string> m_thread_names;
-        bool m_stopping;
+
+        // Worker queues, per priority
+        std::array<std::vector<std::unique_ptr<TaskDeque>>, m_priority_count_compute> m_task_deques;
+
+        // Shared queues, per priority, for tasks submitted by non-worker threads (and all io tasks)
+        std::array<std::deque<Task*>, m_priority_count> m_tasks_shared;
+        std::array<std::atomic<uint32_t>, m_priority_count> m_tasks_shared_count;
+        std::mutex m_mutex_tasks_shared;
+
+        // Sleeping
+        std::mutex m_mutex_sleep;
+        std::condition_variable m_condition_var;
+        std::condition_variable m_condition_var_io;
+        std::atomic<uint32_t> m_threads_sleeping    = 0;
+        std::atomic<uint32_t> m_threads_sleeping_io = 0;
+
+        // Waiting
+        std::mutex m_mutex_wait;
+        std::condition_variable m_condition_var_wait;
+        std::atomic<uint32_t> m_threads_waiting = 0;
+
+        std::array<std::atomic<uint32_t>, m_priority_count> m_tasks_pending;
+        std::atomic<uint32_t> m_tasks_executing     = 0;
+        std::atomic<uint32_t> m_threads_busy        = 0;
+        std::atomic<uint32_t> m_threads_background  = 0;
+
+        // Stats, every worker only writes to its own counters
+        struct alignas(64) WorkerCounters
+        {
+            std::atomic<uint64_t> busy_time_ns  = 0;
+            std::atomic<uint64_t> task_count    = 0;
+            std::atomic<uint64_t> steal_count   = 0;
+        };
+        std::unique_ptr<WorkerCounters[]> m_worker_counters;
+        std::atomic<bool> m_stopping = false;
     };
 }
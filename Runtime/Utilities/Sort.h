@@ -0,0 +1,89 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ====
+#include <vector>
+#include <utility>
+//===============
+
+namespace Spartan::Utility::Sort
+{
+    struct SortItem
+    {
+        uint64_t key    = 0;
+        uint32_t index  = 0;
+    };
+
+    // Stable least significant digit radix sort by key, one byte per pass.
+    // The histograms of all the bytes are counted in a single read, bytes which are the same for every key are skipped.
+    inline void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch)
+    {
+        const uint32_t count = static_cast<uint32_t>(items.size());
+        if (count < 2)
+            return;
+
+        uint32_t histograms[8][256] = {};
+        for (const SortItem& item : items)
+        {
+            for (uint32_t digit = 0; digit < 8; digit++)
+            {
+                histograms[digit][(item.key >> (digit * 8)) & 0xFF]++;
+            }
+        }
+
+        scratch.resize(count);
+        SortItem* source        = items.data();
+        SortItem* destination   = scratch.data();
+
+        for (uint32_t digit = 0; digit < 8; digit++)
+        {
+            const uint32_t shift    = digit * 8;
+            uint32_t* histogram     = histograms[digit];
+
+            if (histogram[(source[0].key >> shift) & 0xFF] == count)
+                continue;
+
+            // Turn the counts into offsets
+            uint32_t offset = 0;
+            for (uint32_t bucket = 0; bucket < 256; bucket++)
+            {
+                const uint32_t bucket_count = histogram[bucket];
+                histogram[bucket]           = offset;
+                offset                     += bucket_count;
+            }
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+            }
+
+            std::swap(source, destination);
+        }
+
+        // An odd number of passes leaves the result in the scratch memory
+        if (source != items.data())
+        {
+            items.swap(scratch);
+        }
+    }
+}
@@ -38,6 +38,7 @@ namespace Spartan
         //= COMPONENT =========================
         void OnInitialize() override;
         void OnTick(float delta_time) override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::Default, ComponentAccess_Global | ComponentAccess_TransformRead }; }
         //=====================================
 
     private:
@@ -43,6 +43,7 @@ namespace Spartan
         void OnStop() override;
         void OnRemove() override;
         void OnTick(float delta_time) override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::Default, ComponentAccess_Global }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
@@ -48,13 +48,13 @@ namespace Spartan
     void Camera::OnInitialize()
     {
         m_view              = ComputeViewMatrix();
-        m_projection        = ComputeProjection(m_renderer->GetOption(Render_ReverseZ));
+        m_projection        = ComputeProjection(IsReverseZ());
         m_view_projection   = m_view * m_projection;
     }
 
     void Camera::OnTick(float delta_time)
     {
-        const auto& current_viewport = m_renderer->GetViewport();
+        const auto& current_viewport = GetViewport();
         if (m_last_known_viewport != current_viewport)
         {
             m_last_known_viewport   = current_viewport;
@@ -69,7 +69,7 @@ namespace Spartan
             m_is_dirty = true;
         }
 
-        if (m_fps_control_enabled)
+        if (m_fps_control_enabled && m_input)
         {
             FpsControl(delta_time);
         }
@@ -78,9 +78,9 @@ namespace Spartan
             return;
 
         m_view              = ComputeViewMatrix();
-        m_projection        = ComputeProjection(m_renderer->GetOption(Render_ReverseZ));
+        m_projection        = ComputeProjection(IsReverseZ());
         m_view_projection   = m_view * m_projection;
-        m_frustrum          = Frustum(GetViewMatrix(), GetProjectionMatrix(), m_renderer->GetOption(Render_ReverseZ) ? GetNearPlane() : GetFarPlane());
+        m_frustrum          = Frustum(GetViewMatrix(), GetProjectionMatrix(), IsReverseZ() ? GetNearPlane() : GetFarPlane());
 
         m_is_dirty = false;
     }
@@ -109,7 +109,7 @@ namespace Spartan
         stream->Read(&m_far_plane);
 
         m_view              = ComputeViewMatrix();
-        m_projection        = ComputeProjection(m_renderer->GetOption(Render_ReverseZ));
+        m_projection        = ComputeProjection(IsReverseZ());
         m_view_projection   = m_view * m_projection;
     }
 
@@ -161,6 +161,12 @@ namespace Spartan
         return m_frustrum.IsVisible(center, extents);
     }
 
+    bool Camera::IsReverseZ() const
+    {
+        // Without a renderer (headless), the projection doesn't matter much, use a conventional one
+        return m_renderer ? m_renderer->GetOption(Render_ReverseZ) : false;
+    }
+
     bool Camera::IsInViewFrustrum(const Vector3& center, const Vector3& extents) const
     {
         return m_frustrum.IsVisible(center, extents);
@@ -169,7 +175,7 @@ namespace Spartan
     bool Camera::Pick(shared_ptr<Entity>& picked)
     {
         // Ensure the mouse is inside the viewport
-        if (!m_input->GetMouseIsInViewport())
+        if (!m_input || !m_input->GetMouseIsInViewport())
             return false;
 
         // Create mouse ray
@@ -269,7 +275,7 @@ namespace Spartan
         const auto& viewport = GetViewport();
 
         // A non reverse-z projection matrix is need, if it we don't have it, we create it
-        const auto projection = m_renderer->GetOption(Render_ReverseZ) ? Matrix::CreatePerspectiveFieldOfViewLH(GetFovVerticalRad(), viewport.AspectRatio(), m_near_plane, m_far_plane) : m_projection;
+        const auto projection = IsReverseZ() ? Matrix::CreatePerspectiveFieldOfViewLH(GetFovVerticalRad(), viewport.AspectRatio(), m_near_plane, m_far_plane) : m_projection;
 
         // Convert world space position to clip space position
         const auto position_clip = position_world * m_view * projection;
@@ -310,7 +316,7 @@ namespace Spartan
     {
         // Convert screen space position to clip space position
         Vector3 position_clip;
-        const auto& viewport = m_renderer->GetViewport();
+        const auto& viewport = GetViewport();
         position_clip.x = (position_screen.x / viewport.width) * 2.0f - 1.0f;
         position_clip.y = (position_screen.y / viewport.height) * -2.0f + 1.0f;
         position_clip.z = m_near_plane;
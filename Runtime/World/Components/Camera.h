@@ -56,6 +56,7 @@ namespace Spartan
         //= ICOMPONENT ===============================
         void OnInitialize() override;
         void OnTick(float delta_time) override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::Variable, ComponentAccess_Global | ComponentAccess_TransformRead | ComponentAccess_TransformWrite }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
@@ -115,6 +116,7 @@ namespace Spartan
         //= MISC =================================================================================
         bool IsInViewFrustrum(Renderable* renderable) const;
         bool IsInViewFrustrum(const Math::Vector3& center, const Math::Vector3& extents) const;
+        const Math::Frustum& GetFrustum()               const { return m_frustrum; }
         const Math::Vector4& GetClearColor() const            { return m_clear_color; }
         void SetClearColor(const Math::Vector4& color)        { m_clear_color = color; }
         bool GetFpsControlEnabled()                     const { return m_fps_control_enabled; }
@@ -126,6 +128,7 @@ namespace Spartan
         Math::Matrix ComputeProjection(const bool reverse_z, const float near_plane = 0.0f, const float far_plane = 0.0f);
 
     private:
+        bool IsReverseZ() const;
         void FpsControl(float delta_time);
 
         float m_aperture                    = 50.0f;        // Size of the lens diaphragm (mm). Controls depth of field and chromatic aberration.
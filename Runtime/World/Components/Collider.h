@@ -52,6 +52,7 @@ namespace Spartan
         //= ICOMPONENT ===============================
         void OnInitialize() override;
         void OnRemove() override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::None, ComponentAccess_None }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
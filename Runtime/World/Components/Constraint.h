@@ -56,6 +56,7 @@ namespace Spartan
         void OnStop() override;
         void OnRemove() override;
         void OnTick(float delta_time) override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::Early, ComponentAccess_Global }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
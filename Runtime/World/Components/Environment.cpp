@@ -67,10 +67,7 @@ namespace Spartan
         if (!m_is_dirty)
             return;
 
-        m_context->GetSubsystem<Threading>()->AddTask([this]
-        {
-            SetFromTextureSphere(m_file_paths.front());
-        });
+        LoadAsync();
 
         m_is_dirty = false;
     }
@@ -86,19 +83,7 @@ namespace Spartan
         m_environment_type = static_cast<Environment_Type>(stream->ReadAs<uint8_t>());
         stream->Read(&m_file_paths);
 
-        m_context->GetSubsystem<Threading>()->AddTask([this]
-        {
-            if (m_environment_type == Enviroment_Cubemap)
-            {
-                SetFromTextureArray(m_file_paths);
-                
-            }
-            else if (m_environment_type == Environment_Sphere)
-            {
-                
-                SetFromTextureSphere(m_file_paths.front());
-            }
-        });
+        LoadAsync();
     }
 
     void Environment::LoadDefault()
@@ -108,37 +93,96 @@ namespace Spartan
 
     const shared_ptr<RHI_Texture>& Environment::GetTexture() const
     {
-        return m_context->GetSubsystem<Renderer>()->GetEnvironmentTexture();
+        static const shared_ptr<RHI_Texture> empty;
+        Renderer* renderer = m_context->GetSubsystem<Renderer>();
+        return renderer ? renderer->GetEnvironmentTexture() : empty;
     }
 
     void Environment::SetTexture(const shared_ptr<RHI_Texture>& texture)
     {
-        m_context->GetSubsystem<Renderer>()->SetEnvironmentTexture(texture);
+        if (Renderer* renderer = m_context->GetSubsystem<Renderer>())
+        {
+            renderer->SetEnvironmentTexture(texture);
+        }
 
         // Save file path for serialization/deserialization
         m_file_paths = { texture ? texture->GetResourceFilePath() : "" };
     }
 
-    void Environment::SetFromTextureArray(const vector<string>& file_paths)
+    void Environment::LoadAsync()
     {
-        if (file_paths.empty())
+        // The environment texture only feeds the renderer, a headless engine has none
+        if (m_file_paths.empty() || !m_context->GetSubsystem<Renderer>())
             return;
 
-        LOG_INFO("Creating sky box...");
+        Threading* threading = m_context->GetSubsystem<Threading>();
 
-        ResourceCache* resource_cache = m_context->GetSubsystem<ResourceCache>();
+        // Any previous load has to finish first, so that loads can't complete out of order
+        const vector<TaskHandle> dependencies = { m_load_task };
 
-        // Load all textures (sides)
-        shared_ptr<RHI_TextureCube> texture = make_shared<RHI_TextureCube>(GetContext());
-        for (uint32_t slice_index = 0; static_cast<uint32_t>(file_paths.size()); slice_index++)
+        if (m_environment_type == Enviroment_Cubemap)
         {
-            resource_cache->GetImageImporter()->Load(file_paths[slice_index], slice_index, static_cast<RHI_Texture*>(texture.get()));
+            LOG_INFO("Creating sky box...");
+
+            // Load all textures (sides), in parallel
+            shared_ptr<vector<shared_ptr<RHI_Texture2D>>> sides = make_shared<vector<shared_ptr<RHI_Texture2D>>>(m_file_paths.size());
+            vector<TaskHandle> side_tasks;
+            for (uint32_t side_index = 0; side_index < static_cast<uint32_t>(m_file_paths.size()); side_index++)
+            {
+                side_tasks.emplace_back(threading->AddTask([this, sides, side_index, file_path = m_file_paths[side_index]]()
+                {
+                    shared_ptr<RHI_Texture2D> side = make_shared<RHI_Texture2D>(GetContext());
+                    if (m_context->GetSubsystem<ResourceCache>()->GetImageImporter()->Load(file_path, 0, side.get()))
+                    {
+                        (*sides)[side_index] = side;
+                    }
+                }, dependencies, TaskPriority::Io));
+            }
+
+            // Once all sides are loaded, assemble the cube
+            m_load_task = threading->AddTask([this, sides]()
+            {
+                SetFromTextureArray(*sides);
+            }, side_tasks);
         }
+        else if (m_environment_type == Environment_Sphere)
+        {
+            m_load_task = threading->AddTask([this, file_path = m_file_paths.front()]()
+            {
+                SetFromTextureSphere(file_path);
+            }, dependencies, TaskPriority::Io);
+        }
+    }
+
+    void Environment::SetFromTextureArray(const vector<shared_ptr<RHI_Texture2D>>& sides)
+    {
+        // Validate sides
+        for (const shared_ptr<RHI_Texture2D>& side : sides)
+        {
+            if (!side)
+            {
+                LOG_ERROR("Sky box creation failed, not all sides could be loaded");
+                return;
+            }
+        }
+
+        // Gather the data of every side
+        vector<RHI_Texture_Slice> data;
+        data.reserve(sides.size());
+        for (const shared_ptr<RHI_Texture2D>& side : sides)
+        {
+            data.emplace_back(move(side->GetSlice(0)));
+        }
+
+        // Create the cube
+        const RHI_Texture2D* side = sides.front().get();
+        shared_ptr<RHI_TextureCube> texture = make_shared<RHI_TextureCube>(GetContext(), side->GetWidth(), side->GetHeight(), side->GetFormat(), data);
 
         // Set resource file path
+        ResourceCache* resource_cache = m_context->GetSubsystem<ResourceCache>();
         texture->SetResourceFilePath(resource_cache->GetProjectDirectory() + "environment" + EXTENSION_TEXTURE);
 
-        // Apply sky sphere to renderer
+        // Apply sky box to renderer
         SetTexture(static_pointer_cast<RHI_Texture>(texture));
 
         LOG_INFO("Sky box has been created successfully");
@@ -21,10 +21,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES ========================
+//= INCLUDES =========================
 #include "IComponent.h"
 #include "../../RHI/RHI_Definition.h"
-//===================================
+#include "../../Threading/Threading.h"
+//====================================
 
 namespace Spartan
 {
@@ -42,6 +43,7 @@ namespace Spartan
 
         //= IComponent ===============================
         void OnTick(float delta_time) override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::Default, ComponentAccess_Global }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
@@ -52,11 +54,13 @@ namespace Spartan
         void SetTexture(const std::shared_ptr<RHI_Texture>& texture);
 
     private:
-        void SetFromTextureArray(const std::vector<std::string>& texturePaths);
+        void LoadAsync();
+        void SetFromTextureArray(const std::vector<std::shared_ptr<RHI_Texture2D>>& sides);
         void SetFromTextureSphere(const std::string& texturePath);
 
         std::vector<std::string> m_file_paths;
         Environment_Type m_environment_type;
         bool m_is_dirty = false;
+        TaskHandle m_load_task;
     };
 }
@@ -55,6 +55,34 @@ namespace Spartan
         Unknown
     };
 
+    // The world ticks components one phase at a time, type by type
+    enum class ComponentTickPhase : uint8_t
+    {
+        Variable,   // Once per frame instead of once per simulation step, for what follows per frame input (e.g. the camera)
+        Early,      // Drives transforms (input, scripts, physics bodies)
+        Default,
+        Late,       // Depends on the final transforms (e.g. bounding boxes)
+        None        // Doesn't tick
+    };
+
+    // What a component touches when it ticks
+    enum ComponentAccess : uint32_t
+    {
+        ComponentAccess_None            = 0,
+        ComponentAccess_TransformRead   = 1 << 0, // Reads transforms
+        ComponentAccess_TransformWrite  = 1 << 1, // Writes the local transform of its own entity
+        ComponentAccess_Global          = 1 << 2  // Touches engine wide state (input, audio, physics, scripting, the world), never ticks concurrently
+    };
+
+    struct ComponentTickDesc
+    {
+        // Components of a type which doesn't touch global state, tick in parallel
+        bool IsParallel() const { return !(access & ComponentAccess_Global); }
+
+        ComponentTickPhase phase    = ComponentTickPhase::Default;
+        uint32_t access             = ComponentAccess_Global;
+    };
+
     struct Attribute
     {
         std::function<std::any()> getter;
@@ -82,6 +110,9 @@ namespace Spartan
         // Runs every frame
         virtual void OnTick(float delta_time) {}
 
+        // When and how OnTick() runs, has to be the same for all the components of a type
+        virtual ComponentTickDesc GetTickDesc() const { return ComponentTickDesc(); }
+
         // Runs when the entity is being saved
         virtual void Serialize(FileStream* stream) {}
 
@@ -148,7 +179,11 @@ namespace Spartan
         Transform* m_transform  = nullptr;
 
     private:
+        friend class World;
+
         // The attributes of the component
         std::vector<Attribute> m_attributes;
+        // The position of the component in the world's list of components of the same type
+        uint32_t m_world_index = static_cast<uint32_t>(-1);
     };
 }
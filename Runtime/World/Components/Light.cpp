@@ -68,17 +68,18 @@ namespace Spartan
 
     void Light::OnTick(float delta_time)
     {
-        // Used in many places, no point in continuing without it
+        // Used in many places, no point in continuing without it (a headless engine has no renderer)
         if (!m_renderer)
-        {
-            LOG_ERROR_INVALID_INTERNALS();
             return;
-        }
 
         // During engine startup, keep checking until the rhi device gets
         // created so we can create potentially required shadow maps
         if (!m_initialized)
         {
+            // Lights tick in parallel, creating textures is serialized
+            static mutex mutex_create;
+            lock_guard<mutex> lock(mutex_create);
+
             CreateShadowMap();
             m_initialized = true;
         }
@@ -181,7 +182,8 @@ namespace Spartan
             CreateShadowMap();
         }
 
-        m_context->GetSubsystem<World>()->Resolve();
+        // Make the entity resolve
+        SP_FIRE_EVENT_DATA(EventType::WorldResolve, m_entity);
     }
 
     void Light::SetColor(const float temperature)
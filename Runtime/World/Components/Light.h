@@ -70,6 +70,7 @@ namespace Spartan
         void OnInitialize() override;
         void OnStart() override;
         void OnTick(float delta_time) override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::Default, ComponentAccess_TransformRead | ComponentAccess_TransformWrite }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
@@ -116,6 +117,7 @@ namespace Spartan
 
         RHI_Texture* GetDepthTexture() const { return m_shadow_map.texture_depth.get(); }
         RHI_Texture* GetColorTexture() const { return m_shadow_map.texture_color.get(); }
+        const ShadowMap& GetShadowMap() const { return m_shadow_map; }
         uint32_t GetShadowArraySize() const;
         void CreateShadowMap();
 
@@ -113,6 +113,12 @@ namespace Spartan
         SP_REGISTER_ATTRIBUTE_GET_SET(Geometry_Type, GeometrySet,  Geometry_Type);
     }
 
+    void Renderable::OnTick(float delta_time)
+    {
+        // Refresh the bounding box while the transforms are final (and in parallel), so the renderer finds it up to date
+        GetAabb();
+    }
+
     void Renderable::Serialize(FileStream* stream)
     {
         // Mesh
@@ -56,6 +56,8 @@ namespace Spartan
         ~Renderable() = default;
 
         //= ICOMPONENT ===============================
+        void OnTick(float delta_time) override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::Late, ComponentAccess_TransformRead }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
@@ -54,6 +54,7 @@ namespace Spartan
         void OnRemove() override;
         void OnStart() override;
         void OnTick(float delta_time) override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::Early, ComponentAccess_Global | ComponentAccess_TransformRead }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
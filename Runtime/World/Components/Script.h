@@ -41,6 +41,7 @@ namespace Spartan
         //= ICOMPONENT ===============================
         void OnStart() override;
         void OnTick(float delta_time) override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::Early, ComponentAccess_Global }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
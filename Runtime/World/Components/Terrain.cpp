@@ -99,31 +99,42 @@ namespace Spartan
             return;
         }
 
-        m_context->GetSubsystem<Threading>()->AddTask([this]()
-        {
-            m_is_generating = true;
+        m_is_generating = true;
 
-            // Get height map data
+        // Data shared between the stages below, it lives as long as the last stage that references it
+        struct TerrainData
+        {
             vector<std::byte> height_data;
-            {
-                height_data = m_height_map->GetMip(0, 0).bytes;
+            vector<Vector3> positions;
+            vector<RHI_Vertex_PosTexNorTan> vertices;
+            vector<uint32_t> indices;
+            bool failed = false;
+        };
+        shared_ptr<TerrainData> data = make_shared<TerrainData>();
 
-                // If not the data is not there, load it
-                if (height_data.empty())
-                {
-                    if (m_height_map->LoadFromFile(m_height_map->GetResourceFilePathNative()))
-                    {
-                        height_data = m_height_map->GetMip(0, 0).bytes;
+        Threading* threading = m_context->GetSubsystem<Threading>();
 
-                        if (height_data.empty())
-                        {
-                            LOG_ERROR("Failed to load height map");
-                            return;
-                        }
-                    }
+        // Get height map data
+        TaskHandle task_height_map = threading->AddTask([this, data]()
+        {
+            data->height_data = m_height_map->GetMip(0, 0).bytes;
+
+            // If not the data is not there, load it
+            if (data->height_data.empty())
+            {
+                if (m_height_map->LoadFromFile(m_height_map->GetResourceFilePathNative()))
+                {
+                    data->height_data = m_height_map->GetMip(0, 0).bytes;
                 }
             }
 
+            if (data->height_data.empty())
+            {
+                LOG_ERROR("Failed to load height map");
+                data->failed = true;
+                return;
+            }
+
             // Deduce some stuff
             m_height                = m_height_map->GetHeight();
             m_width                 = m_height_map->GetWidth();
@@ -133,29 +144,51 @@ namespace Spartan
             m_progress_job_count    = m_vertex_count * 2 + m_face_count + m_vertex_count * m_face_count;
 
             // Pre-allocate memory for the calculations that follow
-            vector<Vector3> positions                 = vector<Vector3>(m_height * m_width);
-            vector<RHI_Vertex_PosTexNorTan> vertices  = vector<RHI_Vertex_PosTexNorTan>(m_vertex_count);
-            vector<uint32_t> indices                  = vector<uint32_t>(m_face_count * 3);
+            data->positions = vector<Vector3>(m_height * m_width);
+            data->vertices  = vector<RHI_Vertex_PosTexNorTan>(m_vertex_count);
+            data->indices   = vector<uint32_t>(m_face_count * 3);
+        }, TaskPriority::Io);
+
+        // Read height map and construct positions
+        TaskHandle task_positions = threading->AddTask([this, data]()
+        {
+            if (data->failed)
+                return;
 
-            // Read height map and construct positions
             m_progress_desc = "Generating positions...";
-            if (GeneratePositions(positions, height_data))
-            {
-                // Compute the vertices (without the normals) and the indices
-                m_progress_desc = "Generating terrain vertices and indices...";
-                if (GenerateVerticesIndices(positions, indices, vertices))
-                {
-                    m_progress_desc = "Generating normals and tangents...";
-                    positions.clear();
-                    positions.shrink_to_fit();
+            data->failed    = !GeneratePositions(data->positions, data->height_data);
+            data->height_data.clear();
+            data->height_data.shrink_to_fit();
+        }, { task_height_map }, TaskPriority::Background);
 
-                    // Compute the normals by doing normal averaging (very expensive)
-                    if (GenerateNormalTangents(indices, vertices))
-                    {
-                        // Create a model and set it to the renderable component
-                        UpdateFromVertices(indices, vertices);
-                    }
-                }
+        // Compute the vertices (without the normals) and the indices
+        TaskHandle task_vertices_indices = threading->AddTask([this, data]()
+        {
+            if (data->failed)
+                return;
+
+            m_progress_desc = "Generating terrain vertices and indices...";
+            data->failed    = !GenerateVerticesIndices(data->positions, data->indices, data->vertices);
+            data->positions.clear();
+            data->positions.shrink_to_fit();
+        }, { task_positions }, TaskPriority::Background);
+
+        // Compute the normals by doing normal averaging (very expensive)
+        TaskHandle task_normals_tangents = threading->AddTask([this, data]()
+        {
+            if (data->failed)
+                return;
+
+            m_progress_desc = "Generating normals and tangents...";
+            data->failed    = !GenerateNormalTangents(data->indices, data->vertices);
+        }, { task_vertices_indices }, TaskPriority::Background);
+
+        // Create a model and set it to the renderable component
+        threading->AddTask([this, data]()
+        {
+            if (!data->failed)
+            {
+                UpdateFromVertices(data->indices, data->vertices);
             }
 
             // Clear progress stats
@@ -164,7 +197,7 @@ namespace Spartan
             m_progress_desc.clear();
 
             m_is_generating = false;
-        });
+        }, { task_normals_tangents }, TaskPriority::Background);
     }
 
     bool Terrain::GeneratePositions(vector<Vector3>& positions, const vector<std::byte>& height_map)
@@ -389,7 +422,7 @@ namespace Spartan
             }
         };
 
-        m_context->GetSubsystem<Threading>()->AddTaskLoop(compute_vertex_normals_tangents, vertex_count);
+        m_context->GetSubsystem<Threading>()->ParallelFor(vertex_count, compute_vertex_normals_tangents);
 
         return true;
     }
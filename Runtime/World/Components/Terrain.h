@@ -43,6 +43,7 @@ namespace Spartan
 
         //= IComponent ===============================
         void OnInitialize() override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::None, ComponentAccess_None }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
@@ -19,13 +19,14 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ===================
+//= INCLUDES =====================
 #include "Spartan.h"
 #include "Transform.h"
 #include "../World.h"
 #include "../Entity.h"
+#include "../TransformHierarchy.h"
 #include "../../IO/FileStream.h"
-//==============================
+//================================
 
 //= NAMESPACES ================
 using namespace std;
@@ -36,20 +37,22 @@ namespace Spartan
 {
     Transform::Transform(Context* context, Entity* entity, uint32_t id /*= 0*/) : IComponent(context, entity, id, this)
     {
-        m_positionLocal = Vector3::Zero;
-        m_rotationLocal = Quaternion(0, 0, 0, 1);
-        m_scaleLocal    = Vector3::One;
-        m_matrix        = Matrix::Identity;
-        m_matrixLocal   = Matrix::Identity;
-        m_matrix_previous  = Matrix::Identity;
-        m_parent        = nullptr;
+        // Acquire a slot in the world's transform hierarchy
+        World* world        = context ? context->GetSubsystem<World>() : nullptr;
+        m_hierarchy         = world ? world->GetTransformHierarchy() : make_shared<TransformHierarchy>();
+        m_handle            = m_hierarchy->Add();
+        m_matrix_previous   = Matrix::Identity;
+        m_parent            = nullptr;
+
+        SP_REGISTER_ATTRIBUTE_GET_SET(GetPositionLocal, SetPositionLocal, Vector3);
+        SP_REGISTER_ATTRIBUTE_GET_SET(GetRotationLocal, SetRotationLocal, Quaternion);
+        SP_REGISTER_ATTRIBUTE_GET_SET(GetScaleLocal,    SetScaleLocal,    Vector3);
+        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_lookAt, Vector3);
+    }
 
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_positionLocal, Vector3);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_rotationLocal, Quaternion);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_scaleLocal,    Vector3);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_matrix,        Matrix);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_matrixLocal,   Matrix);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_lookAt,        Vector3);
+    Transform::~Transform()
+    {
+        m_hierarchy->Remove(m_handle);
     }
 
     void Transform::OnInitialize()
@@ -59,22 +62,29 @@ namespace Spartan
 
     void Transform::Serialize(FileStream* stream)
     {
-        stream->Write(m_positionLocal);
-        stream->Write(m_rotationLocal);
-        stream->Write(m_scaleLocal);
+        stream->Write(GetPositionLocal());
+        stream->Write(GetRotationLocal());
+        stream->Write(GetScaleLocal());
         stream->Write(m_lookAt);
         stream->Write(m_parent ? m_parent->GetEntity()->GetObjectId() : 0);
     }
 
     void Transform::Deserialize(FileStream* stream)
     {
-        stream->Read(&m_positionLocal);
-        stream->Read(&m_rotationLocal);
-        stream->Read(&m_scaleLocal);
+        Vector3 position_local;
+        Quaternion rotation_local;
+        Vector3 scale_local;
+        stream->Read(&position_local);
+        stream->Read(&rotation_local);
+        stream->Read(&scale_local);
         stream->Read(&m_lookAt);
         uint32_t parententity_id = 0;
         stream->Read(&parententity_id);
 
+        m_hierarchy->SetPositionLocal(m_handle, position_local);
+        m_hierarchy->SetRotationLocal(m_handle, rotation_local);
+        m_hierarchy->SetScaleLocal(m_handle, scale_local);
+
         if (parententity_id != 0)
         {
             if (const auto parent = GetContext()->GetSubsystem<World>()->EntityGetById(parententity_id))
@@ -88,24 +98,38 @@ namespace Spartan
 
     void Transform::UpdateTransform()
     {
-        // Compute local transform
-        m_matrixLocal = Matrix(m_positionLocal, m_rotationLocal, m_scaleLocal);
+        // The matrices (and the ones of the descendants) are recomputed by the hierarchy, when next needed
+        m_hierarchy->SetDirty(m_handle);
+    }
 
-        // Compute world transform
-        if (!HasParent())
-        {
-            m_matrix = m_matrixLocal;
-        }
-        else
-        {
-            m_matrix = m_matrixLocal * GetParentTransformMatrix();
-        }
-        
-        // Update children
-        for (const auto& child : m_children)
-        {
-            child->UpdateTransform();
-        }
+    Vector3 Transform::GetPositionLocal() const
+    {
+        return m_hierarchy->GetPositionLocal(m_handle);
+    }
+
+    Quaternion Transform::GetRotationLocal() const
+    {
+        return m_hierarchy->GetRotationLocal(m_handle);
+    }
+
+    Vector3 Transform::GetScaleLocal() const
+    {
+        return m_hierarchy->GetScaleLocal(m_handle);
+    }
+
+    const Matrix& Transform::GetMatrix() const
+    {
+        return m_hierarchy->GetMatrix(m_handle);
+    }
+
+    const Matrix& Transform::GetLocalMatrix() const
+    {
+        return m_hierarchy->GetMatrixLocal(m_handle);
+    }
+
+    Matrix Transform::GetMatrixInterpolated(const float alpha) const
+    {
+        return m_hierarchy->GetMatrixInterpolated(m_handle, alpha);
     }
 
     void Transform::SetPosition(const Vector3& position)
@@ -113,16 +137,15 @@ namespace Spartan
         if (GetPosition() == position)
             return;
 
-        SetPositionLocal(!HasParent() ? position : position * GetParent()->GetMatrix().Inverted());
+        SetPositionLocal(!HasParent() ? position : position * GetParent()->GetMatrix().InvertedAffine());
     }
 
     void Transform::SetPositionLocal(const Vector3& position)
     {
-        if (m_positionLocal == position)
+        if (GetPositionLocal() == position)
             return;
 
-        m_positionLocal = position;
-        UpdateTransform();
+        m_hierarchy->SetPositionLocal(m_handle, position);
     }
 
     void Transform::SetRotation(const Quaternion& rotation)
@@ -135,11 +158,10 @@ namespace Spartan
 
     void Transform::SetRotationLocal(const Quaternion& rotation)
     {
-        if (m_rotationLocal == rotation)
+        if (GetRotationLocal() == rotation)
             return;
 
-        m_rotationLocal = rotation;
-        UpdateTransform();
+        m_hierarchy->SetRotationLocal(m_handle, rotation);
     }
 
     void Transform::SetScale(const Vector3& scale)
@@ -152,28 +174,28 @@ namespace Spartan
 
     void Transform::SetScaleLocal(const Vector3& scale)
     {
-        if (m_scaleLocal == scale)
+        if (GetScaleLocal() == scale)
             return;
 
-        m_scaleLocal = scale;
+        Vector3 scale_local = scale;
 
         // A scale of 0 will cause a division by zero when decomposing the world transform matrix.
-        m_scaleLocal.x = (m_scaleLocal.x == 0.0f) ? Helper::EPSILON : m_scaleLocal.x;
-        m_scaleLocal.y = (m_scaleLocal.y == 0.0f) ? Helper::EPSILON : m_scaleLocal.y;
-        m_scaleLocal.z = (m_scaleLocal.z == 0.0f) ? Helper::EPSILON : m_scaleLocal.z;
+        scale_local.x = (scale_local.x == 0.0f) ? Helper::EPSILON : scale_local.x;
+        scale_local.y = (scale_local.y == 0.0f) ? Helper::EPSILON : scale_local.y;
+        scale_local.z = (scale_local.z == 0.0f) ? Helper::EPSILON : scale_local.z;
 
-        UpdateTransform();
+        m_hierarchy->SetScaleLocal(m_handle, scale_local);
     }
 
     void Transform::Translate(const Vector3& delta)
     {
         if (!HasParent())
         {
-            SetPositionLocal(m_positionLocal + delta);
+            SetPositionLocal(GetPositionLocal() + delta);
         }
         else
         {
-            SetPositionLocal(m_positionLocal + GetParent()->GetMatrix().Inverted() * delta);
+            SetPositionLocal(GetPositionLocal() + GetParent()->GetMatrix().InvertedAffine() * delta);
         }
     }
 
@@ -181,11 +203,11 @@ namespace Spartan
     {
         if (!HasParent())
         {
-            SetRotationLocal((m_rotationLocal * delta).Normalized());
+            SetRotationLocal((GetRotationLocal() * delta).Normalized());
         }
         else
         {
-            SetRotationLocal(m_rotationLocal * GetRotation().Inverse() * delta * GetRotation());
+            SetRotationLocal(GetRotationLocal() * GetRotation().Inverse() * delta * GetRotation());
         }    
     }
 
@@ -268,6 +290,7 @@ namespace Spartan
         // Switch parent but keep a pointer to the old one
         auto parent_old = m_parent;
         m_parent = new_parent;
+        m_hierarchy->SetParent(m_handle, m_parent->m_handle);
         if (parent_old) parent_old->AcquireChildren(); // update the old parent (so it removes this child)
 
         // make the new parent "aware" of this transform/child
@@ -275,8 +298,6 @@ namespace Spartan
         {
             m_parent->AcquireChildren();
         }
-
-        UpdateTransform();
     }
 
     void Transform::AddChild(Transform* child)
@@ -382,11 +403,6 @@ namespace Spartan
         }
     }
 
-    Matrix Transform::GetParentTransformMatrix() const
-    {
-        return HasParent() ? GetParent()->GetMatrix() : Matrix::Identity;
-    }
-
     // Makes this transform have no parent
     void Transform::BecomeOrphan()
     {
@@ -401,7 +417,7 @@ namespace Spartan
         m_parent = nullptr;
 
         // Update the transform without the parent now
-        UpdateTransform();
+        m_hierarchy->SetParent(m_handle, TransformHierarchy::invalid);
 
         // make the parent search for children,
         // that's indirect way of making the parent "forget"
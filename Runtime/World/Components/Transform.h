@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =====================
 #include "IComponent.h"
 #include <vector>
+#include <memory>
 #include "../../Math/Vector3.h"
 #include "../../Math/Quaternion.h"
 #include "../../Math/Matrix.h"
@@ -33,15 +34,19 @@ namespace Spartan
 {
     class RHI_Device;
     class RHI_ConstantBuffer;
+    class TransformHierarchy;
 
+    // The local and world transforms are stored in the world's TransformHierarchy,
+    // this component is a facade which also keeps track of the parent and the children.
     class SPARTAN_CLASS Transform : public IComponent
     {
     public:
         Transform(Context* context, Entity* entity, uint32_t id = 0);
-        ~Transform() = default;
+        ~Transform();
 
         //= ICOMPONENT ===============================
         void OnInitialize() override;
+        ComponentTickDesc GetTickDesc() const override { return { ComponentTickPhase::None, ComponentAccess_None }; }
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
@@ -49,22 +54,22 @@ namespace Spartan
         void UpdateTransform();
 
         //= POSITION ==============================================================
-        Math::Vector3 GetPosition()     const { return m_matrix.GetTranslation(); }
-        const auto& GetPositionLocal()  const { return m_positionLocal; }
+        Math::Vector3 GetPosition()      const { return GetMatrix().GetTranslation(); }
+        Math::Vector3 GetPositionLocal() const;
         void SetPosition(const Math::Vector3& position);
         void SetPositionLocal(const Math::Vector3& position);
         //=========================================================================
 
         //= ROTATION ===========================================================
-        Math::Quaternion GetRotation() const { return m_matrix.GetRotation(); }
-        const auto& GetRotationLocal() const { return m_rotationLocal; }
+        Math::Quaternion GetRotation()      const { return GetMatrix().GetRotation(); }
+        Math::Quaternion GetRotationLocal() const;
         void SetRotation(const Math::Quaternion& rotation);
         void SetRotationLocal(const Math::Quaternion& rotation);
         //======================================================================
 
         //= SCALE =======================================================
-        auto GetScale()             const { return m_matrix.GetScale(); }
-        const auto& GetScaleLocal() const { return m_scaleLocal; }
+        auto GetScale()               const { return GetMatrix().GetScale(); }
+        Math::Vector3 GetScaleLocal() const;
         void SetScale(const Math::Vector3& scale);
         void SetScaleLocal(const Math::Vector3& scale);
         //===============================================================
@@ -103,21 +108,17 @@ namespace Spartan
         //======================================================================================
 
         void LookAt(const Math::Vector3& v)                       { m_lookAt = v; }
-        const Math::Matrix& GetMatrix()                     const { return m_matrix; }
-        const Math::Matrix& GetLocalMatrix()                const { return m_matrixLocal; }
+        const Math::Matrix& GetMatrix() const;
+        const Math::Matrix& GetLocalMatrix() const;
+        Math::Matrix GetMatrixInterpolated(float alpha) const;
         const Math::Matrix& GetMatrixPrevious()             const { return m_matrix_previous; }
         void SetWvpLastFrame(const Math::Matrix& matrix)          { m_matrix_previous = matrix;}
 
     private:
-        Math::Matrix GetParentTransformMatrix() const;
+        // local and world transforms
+        std::shared_ptr<TransformHierarchy> m_hierarchy;
+        uint32_t m_handle = 0;
 
-        // local
-        Math::Vector3 m_positionLocal;
-        Math::Quaternion m_rotationLocal;
-        Math::Vector3 m_scaleLocal;
-
-        Math::Matrix m_matrix;
-        Math::Matrix m_matrixLocal;
         Math::Vector3 m_lookAt;
 
         Transform* m_parent; // the parent of this transform
@@ -121,6 +121,47 @@ namespace Spartan
         clone_entity_and_descendants(this);
     }
 
+    void Entity::SetName(const string& name)
+    {
+        if (name == m_object_name)
+            return;
+
+        const string name_old   = m_object_name;
+        m_object_name           = name;
+
+        // Keep the world's name index up to date
+        if (m_handle.IsValid())
+        {
+            m_context->GetSubsystem<World>()->EntityOnNameChanged(this, name_old);
+        }
+    }
+
+    void Entity::SetObjectId(const uint32_t id)
+    {
+        if (id == m_object_id)
+            return;
+
+        const uint32_t id_old = m_object_id;
+        SpartanObject::SetObjectId(id);
+
+        // Keep the world's id index up to date
+        if (m_handle.IsValid())
+        {
+            m_context->GetSubsystem<World>()->EntityOnIdChanged(this, id_old);
+        }
+    }
+
+    void Entity::SetActive(const bool active)
+    {
+        if (active == m_is_active)
+            return;
+
+        m_is_active = active;
+
+        // Make the entity resolve
+        SP_FIRE_EVENT_DATA(EventType::WorldResolve, this);
+    }
+
     void Entity::Start()
     {
         // call component Start()
@@ -211,8 +252,9 @@ namespace Spartan
         {
             stream->Read(&m_is_active);
             stream->Read(&m_hierarchy_visibility);
-            stream->Read(&m_object_id);
-            stream->Read(&m_object_name);
+            // Through the setters, so that the world's indices follow
+            SetObjectId(stream->ReadAs<uint32_t>());
+            SetName(stream->ReadAs<string>());
         }
 
         // COMPONENTS
@@ -271,8 +313,8 @@ namespace Spartan
             }
         }
 
-        // Make the scene resolve
-        SP_FIRE_EVENT(EventType::WorldResolve);
+        // Make the entity resolve
+        SP_FIRE_EVENT_DATA(EventType::WorldResolve, this);
     }
 
     IComponent* Entity::AddComponent(const ComponentType type, uint32_t id /*= 0*/)
@@ -312,6 +354,7 @@ namespace Spartan
             if (id == component->GetObjectId())
             {
                 component_type = component->GetType();
+                OnComponentRemoved(component.get());
                 component->OnRemove();
                 it = m_components.erase(it);    
                 break;
@@ -335,7 +378,45 @@ namespace Spartan
             m_component_mask &= ~GetComponentMask(component_type);
         }
 
-        // Make the scene resolve
-        SP_FIRE_EVENT(EventType::WorldResolve);
+        // Make the entity resolve
+        SP_FIRE_EVENT_DATA(EventType::WorldResolve, this);
+    }
+
+    void Entity::OnComponentAdded(IComponent* component)
+    {
+        IComponent*& first = m_components_by_type[static_cast<uint32_t>(component->GetType())];
+        if (!first)
+        {
+            first = component;
+        }
+
+        // Entities which are not part of the world yet, register their components once they are added
+        if (m_handle.IsValid())
+        {
+            m_context->GetSubsystem<World>()->ComponentAdd(component);
+        }
+    }
+
+    void Entity::OnComponentRemoved(IComponent* component)
+    {
+        // If this was the first component of its type, the next one of the same type (if any) takes its place
+        IComponent*& first = m_components_by_type[static_cast<uint32_t>(component->GetType())];
+        if (first == component)
+        {
+            first = nullptr;
+            for (const shared_ptr<IComponent>& other : m_components)
+            {
+                if (other.get() != component && other->GetType() == component->GetType())
+                {
+                    first = other.get();
+                    break;
+                }
+            }
+        }
+
+        if (m_handle.IsValid())
+        {
+            m_context->GetSubsystem<World>()->ComponentRemove(component);
+        }
     }
 }
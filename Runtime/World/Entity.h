@@ -23,7 +23,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =====================
 #include <vector>
+#include <array>
+#include "EntityHandle.h"
 #include "../Core/EventSystem.h"
+#include "../Core/PoolAllocator.h"
 #include "Components/IComponent.h"
 //================================
 
@@ -32,7 +35,8 @@ namespace Spartan
     class Context;
     class Transform;
     class Renderable;
-    
+    class World;
+
     class SPARTAN_CLASS Entity : public SpartanObject, public std::enable_shared_from_this<Entity>
     {
     public:
@@ -47,11 +51,13 @@ namespace Spartan
         void Deserialize(FileStream* stream, Transform* parent);
 
         //= PROPERTIES ===================================================================================================
-        const std::string& GetObjectName() const                              { return m_object_name; }
-        void SetName(const std::string& name)                           { m_object_name = name; }
+        const std::string& GetObjectName() const                        { return m_object_name; }
+        void SetName(const std::string& name);
+        void SetObjectId(uint32_t id);
+        const EntityHandle& GetHandle() const                           { return m_handle; }
 
         bool IsActive() const                                           { return m_is_active; }
-        void SetActive(const bool active)                               { m_is_active = active; }
+        void SetActive(const bool active);
 
         bool IsVisibleInHierarchy() const                               { return m_hierarchy_visibility; }
         void SetHierarchyVisibility(const bool hierarchy_visibility)    { m_hierarchy_visibility = hierarchy_visibility; }
@@ -67,8 +73,8 @@ namespace Spartan
             if (HasComponent(type) && type != ComponentType::Script)
                 return GetComponent<T>();
 
-            // Create a new component
-            std::shared_ptr<T> component = std::make_shared<T>(m_context, this, id);
+            // Create a new component, components of the same type are pooled together
+            std::shared_ptr<T> component = std::allocate_shared<T>(PoolAllocator<T>(), m_context, this, id);
 
             // Save new component
             m_components.emplace_back(std::static_pointer_cast<IComponent>(component));
@@ -80,10 +86,11 @@ namespace Spartan
 
             // Initialize component
             component->SetType(type);
+            OnComponentAdded(component.get());
             component->OnInitialize();
 
-            // Make the scene resolve
-            SP_FIRE_EVENT(EventType::WorldResolve);
+            // Make the entity resolve
+            SP_FIRE_EVENT_DATA(EventType::WorldResolve, this);
 
             return component.get();
         }
@@ -100,13 +107,7 @@ namespace Spartan
             if (!HasComponent(type))
                 return nullptr;
 
-            for (const auto& component : m_components)
-            {
-                if (component->GetType() == type)
-                    return static_cast<T*>(component.get());
-            }
-
-            return nullptr;
+            return static_cast<T*>(m_components_by_type[static_cast<uint32_t>(type)]);
         }
 
         // Returns any components of type T (if they exist)
@@ -148,6 +149,7 @@ namespace Spartan
                 auto component = *it;
                 if (component->GetType() == type)
                 {
+                    OnComponentRemoved(component.get());
                     component->OnRemove();
                     it = m_components.erase(it);
                     m_component_mask &= ~GetComponentMask(type);
@@ -158,8 +160,8 @@ namespace Spartan
                 }
             }
 
-            // Make the world resolve
-            SP_FIRE_EVENT(EventType::WorldResolve);
+            // Make the entity resolve
+            SP_FIRE_EVENT_DATA(EventType::WorldResolve, this);
         }
 
         void RemoveComponentById(uint32_t id);
@@ -174,7 +176,11 @@ namespace Spartan
         std::shared_ptr<Entity> GetPtrShared()  { return shared_from_this(); }
 
     private:
+        friend class World;
+
         constexpr uint32_t GetComponentMask(ComponentType type) { return static_cast<uint32_t>(1) << static_cast<uint32_t>(type); }
+        void OnComponentAdded(IComponent* component);
+        void OnComponentRemoved(IComponent* component);
 
         std::string m_object_name          = "Entity";
         bool m_is_active            = true;
@@ -182,9 +188,16 @@ namespace Spartan
         Transform* m_transform      = nullptr;
         Renderable* m_renderable    = nullptr;
         bool m_destruction_pending  = false;
+        EntityHandle m_handle;
+        bool m_resolve_pending      = false;
+
+        // Positions in the world's entity list and name bucket, so that removing an entity is O(1)
+        uint32_t m_world_index      = static_cast<uint32_t>(-1);
+        uint32_t m_name_index       = static_cast<uint32_t>(-1);
         
         // Components
         std::vector<std::shared_ptr<IComponent>> m_components;
+        std::array<IComponent*, static_cast<uint32_t>(ComponentType::Unknown)> m_components_by_type = {}; // the first component of each type
         uint32_t m_component_mask = 0;
     };
 }
@@ -0,0 +1,42 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====
+#include <cstdint>
+//================
+
+namespace Spartan
+{
+    // A weak reference to an entity, it can be validated in O(1) via World::EntityGet()
+    struct EntityHandle
+    {
+        static constexpr uint32_t invalid = static_cast<uint32_t>(-1);
+
+        bool IsValid() const                                { return index != invalid; }
+        bool operator==(const EntityHandle& rhs) const      { return index == rhs.index && generation == rhs.generation; }
+        bool operator!=(const EntityHandle& rhs) const      { return !(*this == rhs); }
+
+        uint32_t index      = invalid;
+        uint32_t generation = 0;
+    };
+}
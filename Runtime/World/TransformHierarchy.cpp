@@ -0,0 +1,475 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Spartan.h"
+#include "TransformHierarchy.h"
+#include "../Threading/Threading.h"
+//=================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+    namespace
+    {
+        // Subtrees smaller than this are never split across threads
+        constexpr uint32_t subtree_size_min = 256;
+
+        // Re-orders the first order.size() elements of an array so that element i becomes element order[i]
+        template <typename T>
+        void permute(StableArray<T>& array, const vector<uint32_t>& order, vector<T>& scratch)
+        {
+            scratch.resize(order.size());
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(order.size()); i++)
+            {
+                scratch[i] = array[order[i]];
+            }
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(order.size()); i++)
+            {
+                array[i] = scratch[i];
+            }
+        }
+    }
+
+    uint32_t TransformHierarchy::Add()
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        // Acquire a handle
+        uint32_t handle = invalid;
+        if (!m_handles_free.empty())
+        {
+            handle = m_handles_free.back();
+            m_handles_free.pop_back();
+        }
+        else
+        {
+            handle = m_handle_count++;
+            m_slots.Reserve(m_handle_count);
+        }
+
+        // Append a slot, a root at the end keeps the order valid
+        const uint32_t slot = m_count++;
+        m_position_local.Reserve(m_count);
+        m_rotation_local.Reserve(m_count);
+        m_scale_local.Reserve(m_count);
+        m_matrix_local.Reserve(m_count);
+        m_matrix.Reserve(m_count);
+        m_matrix_step.Reserve(m_count);
+        m_parent.Reserve(m_count);
+        m_subtree_end.Reserve(m_count);
+        m_version.Reserve(m_count);
+        m_parent_version.Reserve(m_count);
+        m_flags.Reserve(m_count);
+        m_handles.Reserve(m_count);
+
+        m_position_local[slot]  = Vector3::Zero;
+        m_rotation_local[slot]  = Quaternion::Identity;
+        m_scale_local[slot]     = Vector3::One;
+        m_matrix_local[slot]    = Matrix::Identity;
+        m_matrix[slot]          = Matrix::Identity;
+        m_matrix_step[slot]     = Matrix::Identity;
+        m_parent[slot]          = invalid;
+        m_subtree_end[slot]     = slot + 1;
+        m_version[slot]         = 0;
+        m_parent_version[slot]  = invalid;
+        m_flags[slot]           = Flag_Alive | Flag_Dirty | Flag_New;
+        m_handles[slot]         = handle;
+        m_slots[handle]         = slot;
+
+        return handle;
+    }
+
+    void TransformHierarchy::Remove(const uint32_t handle)
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        // The slot is reclaimed the next time the hierarchy is sorted
+        m_flags[m_slots[handle]] = 0;
+        m_slots[handle] = invalid;
+        m_handles_free.emplace_back(handle);
+        m_order_dirty = true;
+    }
+
+    void TransformHierarchy::SetPositionLocal(const uint32_t handle, const Vector3& position)
+    {
+        const uint32_t slot = m_slots[handle];
+        m_position_local[slot] = position;
+        m_flags[slot] |= Flag_Dirty;
+    }
+
+    void TransformHierarchy::SetRotationLocal(const uint32_t handle, const Quaternion& rotation)
+    {
+        const uint32_t slot = m_slots[handle];
+        m_rotation_local[slot] = rotation;
+        m_flags[slot] |= Flag_Dirty;
+    }
+
+    void TransformHierarchy::SetScaleLocal(const uint32_t handle, const Vector3& scale)
+    {
+        const uint32_t slot = m_slots[handle];
+        m_scale_local[slot] = scale;
+        m_flags[slot] |= Flag_Dirty;
+    }
+
+    void TransformHierarchy::SetDirty(const uint32_t handle)
+    {
+        m_flags[m_slots[handle]] |= Flag_Dirty;
+    }
+
+    void TransformHierarchy::SetParent(const uint32_t handle, const uint32_t handle_parent)
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        const uint32_t slot = m_slots[handle];
+        m_parent[slot]      = handle_parent != invalid ? m_slots[handle_parent] : invalid;
+        m_flags[slot]      |= Flag_Dirty;
+        m_order_dirty       = true;
+    }
+
+    const Matrix& TransformHierarchy::GetMatrix(const uint32_t handle)
+    {
+        if (IsStale(m_slots[handle]))
+        {
+            lock_guard<mutex> lock(m_mutex);
+            Resolve(m_slots[handle]);
+        }
+
+        return m_matrix[m_slots[handle]];
+    }
+
+    const Matrix& TransformHierarchy::GetMatrixLocal(const uint32_t handle)
+    {
+        if (m_flags[m_slots[handle]] & Flag_Dirty)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            Resolve(m_slots[handle]);
+        }
+
+        return m_matrix_local[m_slots[handle]];
+    }
+
+    Matrix TransformHierarchy::GetMatrixInterpolated(const uint32_t handle, const float alpha)
+    {
+        const Matrix& matrix    = GetMatrix(handle);
+        const uint32_t slot     = m_slots[handle];
+
+        // Most transforms don't move, skip the decomposition for them
+        if (alpha >= 1.0f || (m_flags[slot] & Flag_New) || m_matrix_step[slot] == matrix)
+            return matrix;
+
+        const Matrix& matrix_step = m_matrix_step[slot];
+        return Matrix
+        (
+            Helper::Lerp(matrix_step.GetTranslation(), matrix.GetTranslation(), alpha),
+            Quaternion::Lerp(matrix_step.GetRotation(), matrix.GetRotation(), alpha),
+            Helper::Lerp(matrix_step.GetScale(), matrix.GetScale(), alpha)
+        );
+    }
+
+    void TransformHierarchy::Update(Threading* threading)
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        if (m_order_dirty)
+        {
+            Sort();
+        }
+
+        if (m_count == 0)
+            return;
+
+        // Split the hierarchy into subtrees which can be updated independently. Subtrees which are too
+        // large are split further, their roots are updated serially, before everything else (parents precede their children).
+        const uint32_t thread_count = threading ? threading->GetThreadCount() + 1 : 1;
+        const uint32_t subtree_size = max(subtree_size_min, m_count / (thread_count * 4));
+        m_work_serial.clear();
+        m_work_ranges.clear();
+        {
+            // A stack of sibling ranges, starting with the roots
+            vector<pair<uint32_t, uint32_t>> siblings = { { 0, m_count } };
+            while (!siblings.empty())
+            {
+                const pair<uint32_t, uint32_t> range = siblings.back();
+                siblings.pop_back();
+
+                uint32_t slot = range.first;
+                while (slot < range.second)
+                {
+                    const uint32_t end = m_subtree_end[slot];
+
+                    if (end - slot <= subtree_size)
+                    {
+                        // Merge with the previous range if they are adjacent and the result is still small enough
+                        if (!m_work_ranges.empty() && m_work_ranges.back().second == slot && end - m_work_ranges.back().first <= subtree_size)
+                        {
+                            m_work_ranges.back().second = end;
+                        }
+                        else
+                        {
+                            m_work_ranges.emplace_back(slot, end);
+                        }
+                    }
+                    else
+                    {
+                        m_work_serial.emplace_back(slot);
+                        siblings.emplace_back(slot + 1, end);
+                    }
+
+                    slot = end;
+                }
+            }
+        }
+
+        // Roots of large subtrees
+        for (const uint32_t slot : m_work_serial)
+        {
+            ComputeRange(slot, slot + 1);
+        }
+
+        // Everything else
+        const uint32_t range_count = static_cast<uint32_t>(m_work_ranges.size());
+        if (threading && range_count > 1)
+        {
+            threading->ParallelFor(range_count, [this](uint32_t start, uint32_t end)
+            {
+                for (uint32_t i = start; i < end; i++)
+                {
+                    ComputeRange(m_work_ranges[i].first, m_work_ranges[i].second);
+                }
+            }, 1);
+        }
+        else
+        {
+            for (const pair<uint32_t, uint32_t>& range : m_work_ranges)
+            {
+                ComputeRange(range.first, range.second);
+            }
+        }
+    }
+
+    void TransformHierarchy::BeginStep(Threading* threading)
+    {
+        // Things can also move in between steps (e.g. the editor), so bring everything up to date first
+        Update(threading);
+
+        lock_guard<mutex> lock(m_mutex);
+
+        for (uint32_t slot = 0; slot < m_count; slot++)
+        {
+            m_matrix_step[slot] = m_matrix[slot];
+            m_flags[slot]      &= ~Flag_New;
+        }
+    }
+
+    bool TransformHierarchy::IsStale(uint32_t slot) const
+    {
+        // Walk up the hierarchy, any dirty ancestor or any ancestor which changed since it was used makes the slot stale
+        while (true)
+        {
+            if (m_flags[slot] & Flag_Dirty)
+                return true;
+
+            const uint32_t parent = GetParentSlot(slot);
+            if (parent == invalid)
+                return false;
+
+            if (m_parent_version[slot] != m_version[parent])
+                return true;
+
+            slot = parent;
+        }
+    }
+
+    void TransformHierarchy::Resolve(const uint32_t slot)
+    {
+        const uint32_t parent = GetParentSlot(slot);
+        if (parent != invalid)
+        {
+            Resolve(parent);
+        }
+
+        if ((m_flags[slot] & Flag_Dirty) || (parent != invalid && m_parent_version[slot] != m_version[parent]))
+        {
+            Compute(slot);
+        }
+    }
+
+    void TransformHierarchy::Compute(const uint32_t slot)
+    {
+        if (m_flags[slot] & Flag_Dirty)
+        {
+            m_matrix_local[slot] = Matrix(m_position_local[slot], m_rotation_local[slot], m_scale_local[slot]);
+        }
+
+        const uint32_t parent = GetParentSlot(slot);
+        if (parent != invalid)
+        {
+            m_matrix[slot]          = m_matrix_local[slot] * m_matrix[parent];
+            m_parent_version[slot]  = m_version[parent];
+        }
+        else
+        {
+            m_matrix[slot]          = m_matrix_local[slot];
+            m_parent_version[slot]  = invalid;
+        }
+
+        m_version[slot]++;
+        m_flags[slot] &= ~Flag_Dirty;
+    }
+
+    void TransformHierarchy::ComputeRange(const uint32_t start, const uint32_t end)
+    {
+        // Parents precede their children, so by the time a slot is visited its parent is up to date
+        for (uint32_t slot = start; slot < end; slot++)
+        {
+            if (!(m_flags[slot] & Flag_Alive))
+                continue;
+
+            const uint32_t parent = GetParentSlot(slot);
+            if ((m_flags[slot] & Flag_Dirty) || (parent != invalid && m_parent_version[slot] != m_version[parent]))
+            {
+                Compute(slot);
+            }
+        }
+    }
+
+    void TransformHierarchy::Sort()
+    {
+        const uint32_t count = m_count;
+
+        // Link every slot to its children, iterating backwards so that siblings keep their relative order
+        vector<uint32_t> first_child(count, invalid);
+        vector<uint32_t> next_sibling(count, invalid);
+        for (uint32_t slot = count; slot-- > 0;)
+        {
+            if (!(m_flags[slot] & Flag_Alive))
+                continue;
+
+            const uint32_t parent = GetParentSlot(slot);
+            if (parent != invalid)
+            {
+                next_sibling[slot]  = first_child[parent];
+                first_child[parent] = slot;
+            }
+            else if (m_parent[slot] != invalid)
+            {
+                // The parent was removed, this slot becomes a root
+                m_flags[slot] |= Flag_Dirty;
+            }
+        }
+
+        // Depth first, pre-order traversal of every root, dead slots are dropped
+        vector<uint32_t> order;
+        order.reserve(count);
+        for (uint32_t root = 0; root < count; root++)
+        {
+            if (!(m_flags[root] & Flag_Alive) || GetParentSlot(root) != invalid)
+                continue;
+
+            uint32_t slot = root;
+            while (true)
+            {
+                order.emplace_back(slot);
+
+                if (first_child[slot] != invalid)
+                {
+                    slot = first_child[slot];
+                    continue;
+                }
+
+                while (slot != root && next_sibling[slot] == invalid)
+                {
+                    slot = m_parent[slot];
+                }
+
+                if (slot == root)
+                    break;
+
+                slot = next_sibling[slot];
+            }
+        }
+
+        // Compute the new parent slots while the old ones are still around
+        const uint32_t count_new = static_cast<uint32_t>(order.size());
+        vector<uint32_t> slot_new(count, invalid);
+        for (uint32_t i = 0; i < count_new; i++)
+        {
+            slot_new[order[i]] = i;
+        }
+
+        vector<uint32_t> parent_new(count_new);
+        for (uint32_t i = 0; i < count_new; i++)
+        {
+            const uint32_t parent = GetParentSlot(order[i]);
+            parent_new[i] = parent != invalid ? slot_new[parent] : invalid;
+        }
+
+        // Re-order the data
+        {
+            vector<Vector3> scratch_vector3;
+            vector<Quaternion> scratch_quaternion;
+            vector<Matrix> scratch_matrix;
+            vector<uint32_t> scratch_uint32;
+            vector<uint8_t> scratch_uint8;
+
+            permute(m_position_local, order, scratch_vector3);
+            permute(m_rotation_local, order, scratch_quaternion);
+            permute(m_scale_local, order, scratch_vector3);
+            permute(m_matrix_local, order, scratch_matrix);
+            permute(m_matrix, order, scratch_matrix);
+            permute(m_matrix_step, order, scratch_matrix);
+            permute(m_version, order, scratch_uint32);
+            permute(m_parent_version, order, scratch_uint32);
+            permute(m_flags, order, scratch_uint8);
+            permute(m_handles, order, scratch_uint32);
+        }
+
+        // Update parents, handles and subtree extents (children follow their parent, so a backwards pass accumulates the sizes)
+        vector<uint32_t> subtree_size(count_new, 1);
+        for (uint32_t slot = count_new; slot-- > 0;)
+        {
+            m_parent[slot]              = parent_new[slot];
+            m_slots[m_handles[slot]]    = slot;
+            m_subtree_end[slot]         = slot + subtree_size[slot];
+
+            if (parent_new[slot] != invalid)
+            {
+                subtree_size[parent_new[slot]] += subtree_size[slot];
+            }
+        }
+
+        m_count         = count_new;
+        m_order_dirty   = false;
+    }
+
+    uint32_t TransformHierarchy::GetParentSlot(const uint32_t slot) const
+    {
+        const uint32_t parent = m_parent[slot];
+        return (parent != invalid && (m_flags[parent] & Flag_Alive)) ? parent : invalid;
+    }
+}
@@ -0,0 +1,156 @@
+/*
+Copyright(c) 2016-2021 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========================
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../Core/Spartan_Definitions.h"
+#include "../Math/Vector3.h"
+#include "../Math/Quaternion.h"
+#include "../Math/Matrix.h"
+//======================================
+
+namespace Spartan
+{
+    class Threading;
+
+    // An array which allocates in fixed size blocks, growing never moves existing elements.
+    // This allows a slot to be read or written while another thread appends to the array.
+    template <typename T>
+    class StableArray
+    {
+    public:
+        static constexpr uint32_t block_shift   = 12;
+        static constexpr uint32_t block_size    = 1 << block_shift;
+        static constexpr uint32_t block_mask    = block_size - 1;
+        static constexpr uint32_t block_count   = 1024;
+
+        void Reserve(const uint32_t count)
+        {
+            for (uint32_t block = 0; block < ((count + block_mask) >> block_shift); block++)
+            {
+                if (!m_blocks[block])
+                {
+                    m_blocks[block] = std::make_unique<T[]>(block_size);
+                }
+            }
+        }
+
+        T& operator[](const uint32_t index)             { return m_blocks[index >> block_shift][index & block_mask]; }
+        const T& operator[](const uint32_t index) const { return m_blocks[index >> block_shift][index & block_mask]; }
+
+    private:
+        std::array<std::unique_ptr<T[]>, block_count> m_blocks;
+    };
+
+    // Stores the local and world transforms of every Transform component in a world.
+    // The data lives in parallel arrays sorted so that every parent precedes its subtree,
+    // which allows the world matrices to be updated in a single linear pass, split across threads per subtree.
+    //
+    // Handles are stable, slots are not (they change whenever the hierarchy is re-sorted).
+    // Setters are O(1) and only mark the slot as dirty, world matrices are either updated
+    // by Update() once per frame or resolved on demand when they are read before that.
+    class SPARTAN_CLASS TransformHierarchy
+    {
+    public:
+        static constexpr uint32_t invalid = static_cast<uint32_t>(-1);
+
+        TransformHierarchy() = default;
+        ~TransformHierarchy() = default;
+
+        // Lifetime
+        uint32_t Add();
+        void Remove(uint32_t handle);
+        uint32_t GetCount() const { return m_count; }
+
+        // Local transform
+        const Math::Vector3& GetPositionLocal(const uint32_t handle)    const { return m_position_local[m_slots[handle]]; }
+        const Math::Quaternion& GetRotationLocal(const uint32_t handle) const { return m_rotation_local[m_slots[handle]]; }
+        const Math::Vector3& GetScaleLocal(const uint32_t handle)       const { return m_scale_local[m_slots[handle]]; }
+        void SetPositionLocal(uint32_t handle, const Math::Vector3& position);
+        void SetRotationLocal(uint32_t handle, const Math::Quaternion& rotation);
+        void SetScaleLocal(uint32_t handle, const Math::Vector3& scale);
+        void SetDirty(uint32_t handle);
+
+        // Hierarchy
+        void SetParent(uint32_t handle, uint32_t handle_parent);
+
+        // Matrices, resolved on demand if they are out of date
+        const Math::Matrix& GetMatrix(uint32_t handle);
+        const Math::Matrix& GetMatrixLocal(uint32_t handle);
+
+        // The world matrix blended between the start of the current fixed step (alpha = 0) and now (alpha = 1)
+        Math::Matrix GetMatrixInterpolated(uint32_t handle, float alpha);
+
+        // Re-sorts the hierarchy (if needed) and updates all out of date world matrices
+        void Update(Threading* threading);
+
+        // Updates and remembers all world matrices, they are what GetMatrixInterpolated() blends from, until the next step
+        void BeginStep(Threading* threading);
+
+    private:
+        enum Flags : uint8_t
+        {
+            Flag_Alive = 1 << 0,
+            Flag_Dirty = 1 << 1, // The local matrix has to be rebuilt from position, rotation and scale
+            Flag_New   = 1 << 2  // Added since the last step, there is nothing to interpolate from
+        };
+
+        bool IsStale(uint32_t slot) const;
+        void Resolve(uint32_t slot);
+        void Compute(uint32_t slot);
+        void ComputeRange(uint32_t start, uint32_t end);
+        void Sort();
+        uint32_t GetParentSlot(uint32_t slot) const;
+
+        // Per slot data, sorted so that parents precede their descendants
+        StableArray<Math::Vector3> m_position_local;
+        StableArray<Math::Quaternion> m_rotation_local;
+        StableArray<Math::Vector3> m_scale_local;
+        StableArray<Math::Matrix> m_matrix_local;
+        StableArray<Math::Matrix> m_matrix;
+        StableArray<Math::Matrix> m_matrix_step;
+        StableArray<uint32_t> m_parent;
+        StableArray<uint32_t> m_subtree_end;
+        StableArray<uint32_t> m_version;
+        StableArray<uint32_t> m_parent_version;
+        StableArray<uint8_t> m_flags;
+        StableArray<uint32_t> m_handles;
+
+        // Per handle data
+        StableArray<uint32_t> m_slots;
+        std::vector<uint32_t> m_handles_free;
+        uint32_t m_handle_count = 0;
+
+        uint32_t m_count = 0;
+        std::atomic<bool> m_order_dirty = false;
+        std::mutex m_mutex;
+
+        // Scratch memory, kept around to avoid allocating every frame
+        std::vector<uint32_t> m_work_serial;
+        std::vector<std::pair<uint32_t, uint32_t>> m_work_ranges;
+    };
+}
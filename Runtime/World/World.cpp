@@ -19,10 +19,11 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ==========================
+//= INCLUDES ===========================
 #include "Spartan.h"
 #include "World.h"
 #include "Entity.h"
+#include "TransformHierarchy.h"
 #include "Components/Transform.h"
 #include "Components/Camera.h"
 #include "Components/Light.h"
@@ -35,7 +36,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Rendering/Renderer.h"
 #include "../Input/Input.h"
 #include "../RHI/RHI_Device.h"
-//=====================================
+#include "../Threading/Threading.h"
+//======================================
 
 //= NAMESPACES ================
 using namespace std;
@@ -46,20 +48,46 @@ namespace Spartan
 {
     World::World(Context* context) : ISubsystem(context)
     {
-        // Subscribe to events
-        SP_SUBSCRIBE_TO_EVENT(EventType::WorldResolve, [this](Variant) { m_resolve = true; });
+        m_transform_hierarchy = make_shared<TransformHierarchy>();
+
+        // Subscribe to events, an entity can resolve on its own, anything else resolves the whole world
+        SP_SUBSCRIBE_TO_EVENT(EventType::WorldResolve, [this](const Variant& data)
+        {
+            if (holds_alternative<Entity*>(data.GetVariantRaw()))
+            {
+                EntityResolve(data.Get<Entity*>());
+            }
+            else
+            {
+                m_resolve = true;
+            }
+        });
+
+        // Remember where everything was when a simulation step starts, the renderer interpolates from there
+        EventSystem::Get().Subscribe<EventFixedStep>([this](const EventFixedStep& event)
+        {
+            if (event.tick_group == TickType::Simulation && !IsLoading())
+            {
+                m_transform_hierarchy->BeginStep(m_threading);
+            }
+        }, this);
     }
 
     World::~World()
     {
+        SP_UNSUBSCRIBE_FROM_EVENT(EventType::WorldResolve);
+        EventSystem::Get().Unsubscribe<EventFixedStep>(this);
+
         m_input     = nullptr;
         m_profiler  = nullptr;
+        m_threading = nullptr;
     }
 
     bool World::OnInitialise()
     {
         m_input     = m_context->GetSubsystem<Input>();
         m_profiler  = m_context->GetSubsystem<Profiler>();
+        m_threading = m_context->GetSubsystem<Threading>();
 
         CreateCamera();
         CreateEnvironment();
@@ -68,6 +96,17 @@ namespace Spartan
         return true;
     }
 
+    void World::SetTickParallel(const bool parallel)
+    {
+        m_threading = parallel ? m_context->GetSubsystem<Threading>() : nullptr;
+    }
+
+    SubsystemInitDesc World::GetInitDesc() const
+    {
+        // The default entities load their resources through the resource cache
+        return { false, { SubsystemType::id<Input>, SubsystemType::id<ResourceCache> } };
+    }
+
     void World::OnTick(float delta_time)
     {
         // If something is being loaded, don't tick as entities are probably being added
@@ -101,32 +140,132 @@ namespace Spartan
                 }
             }
 
-            // Tick
-            for (shared_ptr<Entity>& entity : m_entities)
+            // Tick, one phase at a time
+            for (const ComponentTickPhase phase : { ComponentTickPhase::Early, ComponentTickPhase::Default, ComponentTickPhase::Late })
             {
-                entity->Tick(delta_time);
+                TickPhase(phase, delta_time);
             }
         }
 
+        // Remove entities which are pending destruction, removing an entity queues its descendants as well
+        m_entities_removed.clear();
+        while (!m_entities_pending_removal.empty())
+        {
+            shared_ptr<Entity> entity = move(m_entities_pending_removal.back());
+            m_entities_pending_removal.pop_back();
+
+            if (!EntityExists(entity))
+                continue;
+
+            _EntityRemove(entity);
+            m_entities_removed.emplace_back(move(entity));
+        }
+
+        // Acquire the entities which changed, they are owned by the world so raw pointers will do
+        m_entities_changed_resolved.clear();
+        {
+            lock_guard<mutex> lock(m_entities_changed_mutex);
+
+            for (const EntityHandle& handle : m_entities_changed)
+            {
+                if (Entity* entity = EntityGet(handle))
+                {
+                    entity->m_resolve_pending = false;
+                    m_entities_changed_resolved.emplace_back(entity);
+                }
+            }
+            m_entities_changed.clear();
+        }
+
         if (m_resolve)
         {
-            // Update dirty entities
+            // Notify Renderer
+            EventSystem::Get().Publish(EventWorldResolved{ m_entities });
+            m_resolve = false;
+        }
+        else
+        {
+            // Notify Renderer, only about what changed
+            if (!m_entities_removed.empty())
+            {
+                EventSystem::Get().Publish(EventWorldEntitiesRemoved{ m_entities_removed });
+            }
+
+            if (!m_entities_changed_resolved.empty())
             {
-                // Make a copy so we can iterate while removing entities
-                auto entities_copy = m_entities;
+                EventSystem::Get().Publish(EventWorldEntitiesChanged{ m_entities_changed_resolved });
+            }
+        }
 
-                for (shared_ptr<Entity>& entity : entities_copy)
+        // Release the removed entities
+        m_entities_removed.clear();
+
+        // Update the world matrices of everything that moved this frame, in a single batch
+        m_transform_hierarchy->Update(m_threading);
+    }
+
+    void World::TickVariable(const float delta_time)
+    {
+        if (IsLoading())
+            return;
+
+        TickPhase(ComponentTickPhase::Variable, delta_time);
+    }
+
+    void World::TickPhase(const ComponentTickPhase phase, const float delta_time)
+    {
+        auto tick = [delta_time](IComponent* component)
+        {
+            if (component->GetEntity()->IsActive())
+            {
+                component->OnTick(delta_time);
+            }
+        };
+
+        bool transforms_updated = false;
+        for (const vector<IComponent*>& components : m_components)
+        {
+            if (components.empty())
+                continue;
+
+            const ComponentTickDesc desc = components.front()->GetTickDesc();
+            if (desc.phase != phase)
+                continue;
+
+            if (desc.IsParallel() && m_threading)
+            {
+                // Bring the transforms up to date once, so that reading them concurrently doesn't need to resolve anything
+                if (!transforms_updated && (desc.access & (ComponentAccess_TransformRead | ComponentAccess_TransformWrite)))
+                {
+                    m_transform_hierarchy->Update(m_threading);
+                    transforms_updated = true;
+                }
+
+                m_threading->ParallelFor(static_cast<uint32_t>(components.size()), [&components, &tick](uint32_t start, uint32_t end)
+                {
+                    for (uint32_t i = start; i < end; i++)
+                    {
+                        tick(components[i]);
+                    }
+                });
+            }
+            else
+            {
+                // A component (e.g. a script) might add or remove components while ticking, removing swaps the last component
+                // of the type into the removed one's place, so tick a copy and skip what was removed in the meantime.
+                m_components_ticking = components;
+                m_ticking_serial     = true;
+                for (IComponent* component : m_components_ticking)
                 {
-                    if (entity->IsPendingDestruction())
+                    if (m_components_removed.empty() || find(m_components_removed.begin(), m_components_removed.end(), component) == m_components_removed.end())
                     {
-                        _EntityRemove(entity);
+                        tick(component);
                     }
                 }
+                m_ticking_serial = false;
+                m_components_ticking.clear();
+                m_components_removed.clear();
             }
-
-            // Notify Renderer
-            SP_FIRE_EVENT_DATA(EventType::WorldResolved, m_entities);
-            m_resolve = false;
         }
     }
 
@@ -260,8 +399,10 @@ namespace Spartan
 
     shared_ptr<Entity> World::EntityCreate(bool is_active /*= true*/)
     {
-        shared_ptr<Entity> entity = m_entities.emplace_back(make_shared<Entity>(m_context));
+        shared_ptr<Entity> entity = make_shared<Entity>(m_context);
         entity->SetActive(is_active);
+        EntityIndexAdd(entity);
+        EntityResolve(entity.get());
         return entity;
     }
 
@@ -270,7 +411,7 @@ namespace Spartan
         if (!entity)
             return false;
 
-        return EntityGetById(entity->GetObjectId()) != nullptr;
+        return EntityGet(entity->GetHandle()) == entity.get();
     }
 
     void World::EntityRemove(const shared_ptr<Entity>& entity)
@@ -281,7 +422,7 @@ namespace Spartan
         // Mark for destruction but don't delete now
         // as the Renderer might still be using it.
         entity->MarkForDestruction();
-        m_resolve = true;
+        m_entities_pending_removal.emplace_back(entity);
     }
 
     vector<shared_ptr<Entity>> World::EntityGetRoots()
@@ -300,11 +441,10 @@ namespace Spartan
 
     const shared_ptr<Entity>& World::EntityGetByName(const string& name)
     {
-        for (const auto& entity : m_entities)
-        {
-            if (entity->GetObjectName() == name)
-                return entity;
-        }
+        // If more than one entity has the same name, the one that was named first is returned
+        auto it = m_entities_by_name.find(name);
+        if (it != m_entities_by_name.end())
+            return it->second.front();
 
         static shared_ptr<Entity> empty;
         return empty;
@@ -312,16 +452,23 @@ namespace Spartan
 
     const shared_ptr<Entity>& World::EntityGetById(const uint32_t id)
     {
-        for (const auto& entity : m_entities)
-        {
-            if (entity->GetObjectId() == id)
-                return entity;
-        }
+        auto it = m_entities_by_id.find(id);
+        if (it != m_entities_by_id.end())
+            return it->second;
 
         static shared_ptr<Entity> empty;
         return empty;
     }
 
+    Entity* World::EntityGet(const EntityHandle& handle) const
+    {
+        if (handle.index >= static_cast<uint32_t>(m_entity_slots.size()))
+            return nullptr;
+
+        const EntitySlot& slot = m_entity_slots[handle.index];
+        return slot.generation == handle.generation ? slot.entity : nullptr;
+    }
+
     void World::Clear()
     {
         // Notify subsystems that need to flush (like the Renderer)
@@ -330,8 +477,26 @@ namespace Spartan
         // Notify any systems that need to clear (like the ResourceCache)
         SP_FIRE_EVENT(EventType::WorldClear);
 
-        // Clear the entities
+        // Clear the entities, everything goes so the indices are dropped as a whole instead of entity by entity
+        for (const shared_ptr<Entity>& entity : m_entities)
+        {
+            for (const shared_ptr<IComponent>& component : entity->GetAllComponents())
+            {
+                component->m_world_index = static_cast<uint32_t>(-1);
+            }
+
+            EntityHandleRelease(entity.get());
+            entity->m_world_index   = static_cast<uint32_t>(-1);
+            entity->m_name_index    = static_cast<uint32_t>(-1);
+        }
         m_entities.clear();
+        m_entities_by_id.clear();
+        m_entities_by_name.clear();
+        for (vector<IComponent*>& components : m_components)
+        {
+            components.clear();
+        }
+        m_entities_pending_removal.clear();
 
         m_resolve = true;
     }
@@ -350,16 +515,7 @@ namespace Spartan
         auto parent = entity->GetTransform()->GetParent();
 
         // Remove this entity
-        for (auto it = m_entities.begin(); it < m_entities.end();)
-        {
-            const auto temp = *it;
-            if (temp->GetObjectId() == entity->GetObjectId())
-            {
-                it = m_entities.erase(it);
-                break;
-            }
-            ++it;
-        }
+        EntityIndexRemove(entity);
 
         // If there was a parent, update it
         if (parent)
@@ -368,6 +524,169 @@ namespace Spartan
         }
     }
 
+    void World::EntityResolve(Entity* entity)
+    {
+        // Entities which are not part of the world yet (still being constructed) resolve once they are added
+        if (!entity || !entity->GetHandle().IsValid())
+            return;
+
+        lock_guard<mutex> lock(m_entities_changed_mutex);
+
+        if (!entity->m_resolve_pending)
+        {
+            entity->m_resolve_pending = true;
+            m_entities_changed.emplace_back(entity->GetHandle());
+        }
+    }
+
+    void World::EntityIndexAdd(const shared_ptr<Entity>& entity)
+    {
+        // Acquire a slot, a handle to a slot which was freed stays invalid because the generation has moved on
+        uint32_t index = 0;
+        if (!m_entity_slots_free.empty())
+        {
+            index = m_entity_slots_free.back();
+            m_entity_slots_free.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_entity_slots.size());
+            m_entity_slots.emplace_back();
+        }
+
+        m_entity_slots[index].entity        = entity.get();
+        entity->m_handle.index              = index;
+        entity->m_handle.generation         = m_entity_slots[index].generation;
+
+        entity->m_world_index = static_cast<uint32_t>(m_entities.size());
+        m_entities.emplace_back(entity);
+
+        m_entities_by_id[entity->GetObjectId()] = entity;
+        EntityNameIndexAdd(entity);
+
+        for (const shared_ptr<IComponent>& component : entity->GetAllComponents())
+        {
+            ComponentAdd(component.get());
+        }
+    }
+
+    void World::EntityIndexRemove(const shared_ptr<Entity>& entity)
+    {
+        if (EntityGet(entity->GetHandle()) != entity.get())
+            return;
+
+        // Id
+        auto it_id = m_entities_by_id.find(entity->GetObjectId());
+        if (it_id != m_entities_by_id.end() && it_id->second == entity)
+        {
+            m_entities_by_id.erase(it_id);
+        }
+
+        // Name
+        EntityNameIndexRemove(entity.get(), entity->GetObjectName());
+
+        // Components
+        for (const shared_ptr<IComponent>& component : entity->GetAllComponents())
+        {
+            ComponentRemove(component.get());
+        }
+
+        // Entities, swap with the last one and pop, O(1)
+        const uint32_t index                = entity->m_world_index;
+        m_entities[index]                   = move(m_entities.back());
+        m_entities[index]->m_world_index    = index;
+        m_entities.pop_back();
+        entity->m_world_index               = static_cast<uint32_t>(-1);
+
+        // Handle
+        EntityHandleRelease(entity.get());
+    }
+
+    void World::EntityHandleRelease(Entity* entity)
+    {
+        EntitySlot& slot = m_entity_slots[entity->m_handle.index];
+        slot.entity = nullptr;
+        slot.generation++;
+        m_entity_slots_free.emplace_back(entity->m_handle.index);
+        entity->m_handle = EntityHandle();
+    }
+
+    void World::EntityNameIndexAdd(const shared_ptr<Entity>& entity)
+    {
+        vector<shared_ptr<Entity>>& entities    = m_entities_by_name[entity->GetObjectName()];
+        entity->m_name_index                    = static_cast<uint32_t>(entities.size());
+        entities.emplace_back(entity);
+    }
+
+    void World::EntityNameIndexRemove(Entity* entity, const string& name)
+    {
+        auto it = m_entities_by_name.find(name);
+        if (it == m_entities_by_name.end())
+            return;
+
+        vector<shared_ptr<Entity>>& entities = it->second;
+        const uint32_t index = entity->m_name_index;
+        if (index >= static_cast<uint32_t>(entities.size()) || entities[index].get() != entity)
+            return;
+
+        // Swap with the last entity of the same name and pop, O(1)
+        entities[index]                 = move(entities.back());
+        entities[index]->m_name_index   = index;
+        entities.pop_back();
+        entity->m_name_index            = static_cast<uint32_t>(-1);
+
+        if (entities.empty())
+        {
+            m_entities_by_name.erase(it);
+        }
+    }
+
+    void World::EntityOnNameChanged(Entity* entity, const string& name_old)
+    {
+        EntityNameIndexRemove(entity, name_old);
+        EntityNameIndexAdd(entity->GetPtrShared());
+    }
+
+    void World::EntityOnIdChanged(Entity* entity, const uint32_t id_old)
+    {
+        auto it = m_entities_by_id.find(id_old);
+        if (it != m_entities_by_id.end() && it->second.get() == entity)
+        {
+            m_entities_by_id.erase(it);
+        }
+
+        m_entities_by_id[entity->GetObjectId()] = entity->GetPtrShared();
+    }
+
+    void World::ComponentAdd(IComponent* component)
+    {
+        if (component->m_world_index != static_cast<uint32_t>(-1))
+            return;
+
+        vector<IComponent*>& components = m_components[static_cast<uint32_t>(component->GetType())];
+        component->m_world_index        = static_cast<uint32_t>(components.size());
+        components.emplace_back(component);
+    }
+
+    void World::ComponentRemove(IComponent* component)
+    {
+        const uint32_t index = component->m_world_index;
+        if (index == static_cast<uint32_t>(-1))
+            return;
+
+        if (m_ticking_serial)
+        {
+            m_components_removed.emplace_back(component);
+        }
+
+        // Swap with the last component and pop, O(1)
+        vector<IComponent*>& components     = m_components[static_cast<uint32_t>(component->GetType())];
+        components[index]                   = components.back();
+        components[index]->m_world_index    = index;
+        components.pop_back();
+        component->m_world_index            = static_cast<uint32_t>(-1);
+    }
+
     shared_ptr<Entity> World::CreateEnvironment()
     {
         shared_ptr<Entity> environment = EntityCreate();
@@ -23,8 +23,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ===========================
 #include <vector>
+#include <array>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <mutex>
+#include "Entity.h"
+#include "EntityHandle.h"
 #include "../Core/ISubsystem.h"
 #include "../Core/Spartan_Definitions.h"
 //======================================
@@ -35,6 +41,14 @@ namespace Spartan
     class Light;
     class Input;
     class Profiler;
+    class Threading;
+    class TransformHierarchy;
+
+    // Typed events published by the world once per tick, the payloads reference memory owned by
+    // the world and are only valid while the event is being delivered, so they are never posted.
+    struct EventWorldResolved           { const std::vector<std::shared_ptr<Entity>>& entities; };  // All the entities
+    struct EventWorldEntitiesChanged    { const std::vector<Entity*>& entities; };                  // Added, or their components changed
+    struct EventWorldEntitiesRemoved    { const std::vector<std::shared_ptr<Entity>>& entities; };  // Removed, kept alive for the event
 
     class SPARTAN_CLASS World : public ISubsystem
     {
@@ -44,8 +58,12 @@ namespace Spartan
 
         //= ISubsystem ======================
         bool OnInitialise() override;
+        SubsystemInitDesc GetInitDesc() const override;
         void OnTick(float delta_time) override;
         //===================================
+
+        // Ticks the components which follow per frame input, the engine calls it once per frame, before the simulation steps
+        void TickVariable(float delta_time);
         
         void New();
         bool SaveToFile(const std::string& filePath);
@@ -53,6 +71,7 @@ namespace Spartan
         const auto& GetName() const { return m_name; }
         void Resolve() { m_resolve = true; }
         bool IsLoading();
+        void SetTickParallel(bool parallel); // ticking serially is the reference which the parallel tick has to match
 
         //= Entities ===========================================================
         std::shared_ptr<Entity> EntityCreate(bool is_active = true);
@@ -61,12 +80,65 @@ namespace Spartan
         std::vector<std::shared_ptr<Entity>> EntityGetRoots();
         const std::shared_ptr<Entity>& EntityGetByName(const std::string& name);
         const std::shared_ptr<Entity>& EntityGetById(uint32_t id);
+        Entity* EntityGet(const EntityHandle& handle) const;
         const auto& EntityGetAll() const    { return m_entities; }
         //======================================================================
 
+        //= COMPONENTS =========================================================================================
+        // Calls function(T*, Ts*...) for every entity which has all of the given component types. The components
+        // of type T are walked through a dense list of pointers, the rest are looked up in O(1), so T should be the rarest type.
+        template <typename T, typename... Ts, typename Function>
+        void Each(Function&& function)
+        {
+            const std::vector<IComponent*>& components = m_components[static_cast<uint32_t>(IComponent::TypeToEnum<T>())];
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(components.size()); i++)
+            {
+                T* component = static_cast<T*>(components[i]);
+
+                if constexpr (sizeof...(Ts) == 0)
+                {
+                    function(component);
+                }
+                else
+                {
+                    Entity* entity = component->GetEntity();
+                    const std::tuple<Ts*...> others(entity->template GetComponent<Ts>()...);
+
+                    if (std::apply([](auto*... other) { return ((other != nullptr) && ...); }, others))
+                    {
+                        std::apply([&function, component](auto*... other) { function(component, other...); }, others);
+                    }
+                }
+            }
+        }
+
+        // All the components of a given type
+        const std::vector<IComponent*>& ComponentGetAll(const ComponentType type) const { return m_components[static_cast<uint32_t>(type)]; }
+        //======================================================================================================
+
+        // The local and world transforms of all the entities
+        const auto& GetTransformHierarchy() const { return m_transform_hierarchy; }
+
     private:
+        friend class Entity;
+
         void Clear();
+        void TickPhase(ComponentTickPhase phase, float delta_time);
         void _EntityRemove(const std::shared_ptr<Entity>& entity);
+        void EntityResolve(Entity* entity);
+
+        //= ENTITY INDICES ================================================================
+        void EntityIndexAdd(const std::shared_ptr<Entity>& entity);
+        void EntityIndexRemove(const std::shared_ptr<Entity>& entity);
+        void EntityHandleRelease(Entity* entity);
+        void EntityNameIndexAdd(const std::shared_ptr<Entity>& entity);
+        void EntityNameIndexRemove(Entity* entity, const std::string& name);
+        void EntityOnNameChanged(Entity* entity, const std::string& name_old);
+        void EntityOnIdChanged(Entity* entity, uint32_t id_old);
+        void ComponentAdd(IComponent* component);
+        void ComponentRemove(IComponent* component);
+        //=================================================================================
 
         //= COMMON ENTITY CREATION ======================
         std::shared_ptr<Entity> CreateEnvironment();
@@ -79,7 +151,35 @@ namespace Spartan
         bool m_resolve              = true;
         Input* m_input              = nullptr;
         Profiler* m_profiler        = nullptr;
+        Threading* m_threading      = nullptr;
 
+        std::shared_ptr<TransformHierarchy> m_transform_hierarchy;
         std::vector<std::shared_ptr<Entity>> m_entities;
+
+        // Incremental resolve, entities which changed or are about to be removed since the last tick
+        std::vector<EntityHandle> m_entities_changed;
+        std::vector<std::shared_ptr<Entity>> m_entities_pending_removal;
+        std::vector<std::shared_ptr<Entity>> m_entities_removed;    // Scratch, reused every tick
+        std::vector<Entity*> m_entities_changed_resolved;           // Scratch, reused every tick
+        std::mutex m_entities_changed_mutex;
+
+        // Lookup indices, kept in sync with m_entities
+        struct EntitySlot
+        {
+            Entity* entity      = nullptr;
+            uint32_t generation = 0;
+        };
+        std::vector<EntitySlot> m_entity_slots;
+        std::vector<uint32_t> m_entity_slots_free;
+        std::unordered_map<uint32_t, std::shared_ptr<Entity>> m_entities_by_id;
+        std::unordered_map<std::string, std::vector<std::shared_ptr<Entity>>> m_entities_by_name;
+
+        // Serial ticking iterates over a copy, components removed while it ticks are skipped
+        std::vector<IComponent*> m_components_ticking;  // Scratch, reused every tick
+        std::vector<IComponent*> m_components_removed;  // Scratch, reused every tick
+        bool m_ticking_serial = false;
+
+        // A dense list of pointers per component type, the components themselves live in pooled blocks and are owned by their entity
+        std::array<std::vector<IComponent*>, static_cast<uint32_t>(ComponentType::Unknown)> m_components;
     };
 }
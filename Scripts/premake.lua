@@ -19,10 +19,12 @@
 
 SOLUTION_NAME				= "Spartan"
 EDITOR_NAME					= "Editor"
+RUNNER_NAME					= "Runner"
 RUNTIME_NAME				= "Runtime"
 TARGET_NAME					= "Spartan" -- Name of executable
 DEBUG_FORMAT				= "c7"
 EDITOR_DIR					= "../" .. EDITOR_NAME
+RUNNER_DIR					= "../" .. RUNNER_NAME
 RUNTIME_DIR					= "../" .. RUNTIME_NAME
 IGNORE_FILES				= {}
 ADDITIONAL_INCLUDES			= {}
@@ -39,16 +41,19 @@ if API_GRAPHICS == "d3d11" then
 	TARGET_NAME		= TARGET_NAME .. "_d3d11"
 	IGNORE_FILES[0]	= RUNTIME_DIR .. "/RHI/D3D12/**"
 	IGNORE_FILES[1]	= RUNTIME_DIR .. "/RHI/Vulkan/**"
+	IGNORE_FILES[2]	= RUNTIME_DIR .. "/RHI/Null/**"
 elseif API_GRAPHICS == "d3d12" then
 	API_GRAPHICS	= "API_GRAPHICS_D3D12"
 	TARGET_NAME		= TARGET_NAME .. "_d3d12"
 	IGNORE_FILES[0]	= RUNTIME_DIR .. "/RHI/D3D11/**"
 	IGNORE_FILES[1]	= RUNTIME_DIR .. "/RHI/Vulkan/**"
+	IGNORE_FILES[2]	= RUNTIME_DIR .. "/RHI/Null/**"
 elseif API_GRAPHICS == "vulkan" then
 	API_GRAPHICS				= "API_GRAPHICS_VULKAN"
 	TARGET_NAME					= TARGET_NAME .. "_vulkan"
 	IGNORE_FILES[0]				= RUNTIME_DIR .. "/RHI/D3D11/**"
 	IGNORE_FILES[1]				= RUNTIME_DIR .. "/RHI/D3D12/**"
+	IGNORE_FILES[2]				= RUNTIME_DIR .. "/RHI/Null/**"
 	ADDITIONAL_INCLUDES[0] 		= "../ThirdParty/DirectXShaderCompiler_1.6.2106";
 	ADDITIONAL_INCLUDES[1] 		= "../ThirdParty/SPIRV-Cross-2020-09-17";
 	ADDITIONAL_INCLUDES[2] 		= "../ThirdParty/Vulkan_1.2.182.0";
@@ -60,6 +65,12 @@ elseif API_GRAPHICS == "vulkan" then
 	ADDITIONAL_LIBRARIES_DBG[1] = "spirv-cross-core_debug";
 	ADDITIONAL_LIBRARIES_DBG[2] = "spirv-cross-hlsl_debug";
 	ADDITIONAL_LIBRARIES_DBG[3] = "spirv-cross-glsl_debug";
+elseif API_GRAPHICS == "null" then -- No GPU work, for measuring the CPU side of the renderer
+	API_GRAPHICS	= "API_GRAPHICS_NULL"
+	TARGET_NAME		= TARGET_NAME .. "_null"
+	IGNORE_FILES[0]	= RUNTIME_DIR .. "/RHI/D3D11/**"
+	IGNORE_FILES[1]	= RUNTIME_DIR .. "/RHI/D3D12/**"
+	IGNORE_FILES[2]	= RUNTIME_DIR .. "/RHI/Vulkan/**"
 end
 
 -- Solution
@@ -126,7 +137,7 @@ project (RUNTIME_NAME)
 	}
 
 	-- Source to ignore
-	removefiles { IGNORE_FILES[0], IGNORE_FILES[1] }
+	removefiles { IGNORE_FILES[0], IGNORE_FILES[1], IGNORE_FILES[2] }
 
 	-- Includes
 	includedirs { "../ThirdParty/Assimp_5.0.1" }
@@ -221,4 +232,42 @@ project (EDITOR_NAME)
 		targetdir (TARGET_DIR)
 		debugdir (TARGET_DIR)
 		links { "freetype" }
-		links { "SDL2.lib" }
\ No newline at end of file
+		links { "SDL2.lib" }
+
+-- Runner (headless) ---------------------------------------------------------------------------------------
+project (RUNNER_NAME)
+	location (RUNNER_DIR)
+	links { RUNTIME_NAME }
+	dependson { RUNTIME_NAME }
+	objdir (OBJ_DIR)
+	kind "ConsoleApp"
+	staticruntime "On"
+    if os.target() == "windows" then
+	    conformancemode "On"
+    end
+	defines{ "SPARTAN_RUNNER", API_GRAPHICS }
+
+	-- Files
+	files
+	{
+		RUNNER_DIR .. "/**.h",
+		RUNNER_DIR .. "/**.cpp"
+	}
+
+	-- Includes
+	includedirs { "../" .. RUNTIME_NAME }
+
+	-- Libraries
+	libdirs (LIBRARY_DIR)
+
+	-- "Debug"
+	filter "configurations:Debug"
+		targetname ( TARGET_NAME .. "_runner_debug" )
+		targetdir (TARGET_DIR)
+		debugdir (TARGET_DIR)
+
+	-- "Release"
+	filter "configurations:Release"
+		targetname ( TARGET_NAME .. "_runner" )
+		targetdir (TARGET_DIR)
+		debugdir (TARGET_DIR)